@@ -0,0 +1,697 @@
+
+/**
+
+Copyright (C) 2025 Nicholas Agbo
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+
+ */
+
+/**
+ * @defgroup pal_atomic Atomic
+ * Atomic PAL functionality such as loads, stores, read-modify-write
+ * operations, fences and a CPU pause hint with explicit memory ordering.
+ *
+ * This module is header only and always available. All functions are
+ * `static inline` and compile down to compiler builtins or intrinsics.
+ *
+ * @{
+ */
+
+#ifndef _PAL_ATOMIC_H
+#define _PAL_ATOMIC_H
+
+#include "pal_core.h"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define PAL_ATOMIC_MSVC 1
+#else
+#define PAL_ATOMIC_MSVC 0
+#endif // _MSC_VER
+
+#if PAL_ATOMIC_MSVC && defined(_M_ARM64)
+#define PAL_ATOMIC_ARM64_FENCE() __dmb(_ARM64_BARRIER_ISH)
+#else
+#define PAL_ATOMIC_ARM64_FENCE() ((void)0)
+#endif // _M_ARM64
+
+/**
+ * @enum PalMemoryOrder
+ * @brief Memory ordering constraints for atomic operations. This is not a
+ * bitmask enum.
+ *
+ * The values match the C11 and GCC orderings, so they can be passed to the
+ * compiler builtins directly.
+ *
+ * `PAL_MEMORY_ORDER_ACQUIRE` is only valid for loads and read-modify-write
+ * operations. `PAL_MEMORY_ORDER_RELEASE` is only valid for stores and
+ * read-modify-write operations.
+ *
+ * All memory orders follow the format `PAL_MEMORY_ORDER_**` for
+ * consistency and API use.
+ *
+ * @since 1.1
+ * @ingroup pal_atomic
+ */
+typedef enum {
+    PAL_MEMORY_ORDER_RELAXED = 0,
+    PAL_MEMORY_ORDER_ACQUIRE = 2,
+    PAL_MEMORY_ORDER_RELEASE = 3,
+    PAL_MEMORY_ORDER_ACQ_REL = 4,
+    PAL_MEMORY_ORDER_SEQ_CST = 5
+} PalMemoryOrder;
+
+/**
+ * @brief Prevent the compiler from reordering memory accesses across this
+ * point. No CPU fence is emitted.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_atomic
+ * @sa palAtomicThreadFence
+ */
+static inline void palAtomicCompilerFence()
+{
+#if PAL_ATOMIC_MSVC
+    _ReadWriteBarrier();
+#else
+    __atomic_signal_fence(__ATOMIC_SEQ_CST);
+#endif // PAL_ATOMIC_MSVC
+}
+
+/**
+ * @brief Issue a memory fence with the provided ordering.
+ *
+ * @param[in] order Memory order of the fence. `PAL_MEMORY_ORDER_RELAXED` does
+ * nothing.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_atomic
+ * @sa palAtomicCompilerFence
+ */
+static inline void palAtomicThreadFence(PalMemoryOrder order)
+{
+#if PAL_ATOMIC_MSVC
+    if (order == PAL_MEMORY_ORDER_RELAXED) {
+        return;
+    }
+
+#if defined(_M_ARM64)
+    __dmb(_ARM64_BARRIER_ISH);
+#else
+    if (order == PAL_MEMORY_ORDER_SEQ_CST) {
+        // a locked instruction is a full fence on x86 and cheaper than mfence
+        volatile long fence = 0;
+        _InterlockedOr(&fence, 0);
+    } else {
+        // x86 only reorders stores after later loads
+        _ReadWriteBarrier();
+    }
+#endif // _M_ARM64
+#else
+    __atomic_thread_fence((int)order);
+#endif // PAL_ATOMIC_MSVC
+}
+
+/**
+ * @brief Hint to the CPU that the caller is spinning in a wait loop.
+ *
+ * This lowers power use and frees pipeline resources for a sibling hyper
+ * thread. It does not yield to the OS.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_atomic
+ */
+static inline void palCpuPause()
+{
+#if PAL_ATOMIC_MSVC
+#if defined(_M_ARM64) || defined(_M_ARM)
+    __yield();
+#else
+    _mm_pause();
+#endif // _M_ARM64
+#elif defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif // PAL_ATOMIC_MSVC
+}
+
+/**
+ * @brief Atomically load a 32-bit value.
+ *
+ * @param[in] ptr Pointer to the value. Must be 4-byte aligned.
+ * @param[in] order Memory order. Must not be `PAL_MEMORY_ORDER_RELEASE` or
+ * `PAL_MEMORY_ORDER_ACQ_REL`.
+ *
+ * @return The loaded value.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_atomic
+ */
+static inline Int32 palAtomicLoad32(
+    volatile Int32* ptr,
+    PalMemoryOrder order)
+{
+#if PAL_ATOMIC_MSVC
+    // aligned loads are atomic and have acquire semantics on x86
+    Int32 value = *ptr;
+    if (order != PAL_MEMORY_ORDER_RELAXED) {
+        PAL_ATOMIC_ARM64_FENCE();
+    }
+    _ReadWriteBarrier();
+    return value;
+#else
+    return __atomic_load_n(ptr, (int)order);
+#endif // PAL_ATOMIC_MSVC
+}
+
+/**
+ * @brief Atomically store a 32-bit value.
+ *
+ * @param[in] ptr Pointer to the value. Must be 4-byte aligned.
+ * @param[in] value Value to store.
+ * @param[in] order Memory order. Must not be `PAL_MEMORY_ORDER_ACQUIRE` or
+ * `PAL_MEMORY_ORDER_ACQ_REL`.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_atomic
+ */
+static inline void palAtomicStore32(
+    volatile Int32* ptr,
+    Int32 value,
+    PalMemoryOrder order)
+{
+#if PAL_ATOMIC_MSVC
+    if (order == PAL_MEMORY_ORDER_SEQ_CST) {
+        _InterlockedExchange((volatile long*)ptr, value);
+        return;
+    }
+
+    if (order != PAL_MEMORY_ORDER_RELAXED) {
+        PAL_ATOMIC_ARM64_FENCE();
+    }
+    _ReadWriteBarrier();
+    *ptr = value;
+#else
+    __atomic_store_n(ptr, value, (int)order);
+#endif // PAL_ATOMIC_MSVC
+}
+
+/**
+ * @brief Atomically replace a 32-bit value.
+ *
+ * @param[in] ptr Pointer to the value. Must be 4-byte aligned.
+ * @param[in] value Value to store.
+ * @param[in] order Memory order.
+ *
+ * @return The previous value.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_atomic
+ */
+static inline Int32 palAtomicExchange32(
+    volatile Int32* ptr,
+    Int32 value,
+    PalMemoryOrder order)
+{
+#if PAL_ATOMIC_MSVC
+    (void)order; // interlocked functions are full barriers
+    return (Int32)_InterlockedExchange((volatile long*)ptr, value);
+#else
+    return __atomic_exchange_n(ptr, value, (int)order);
+#endif // PAL_ATOMIC_MSVC
+}
+
+/**
+ * @brief Atomically replace a 32-bit value if it equals an expected value.
+ *
+ * On failure the current value is written to `expected` and ordered as a
+ * load with `order`, without its release part.
+ *
+ * @param[in] ptr Pointer to the value. Must be 4-byte aligned.
+ * @param[in, out] expected Pointer to the expected value. Must not be nullptr.
+ * @param[in] desired Value to store if the current value equals `expected`.
+ * @param[in] order Memory order.
+ *
+ * @return True if the value was replaced, otherwise false.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_atomic
+ */
+static inline bool palAtomicCompareExchange32(
+    volatile Int32* ptr,
+    Int32* expected,
+    Int32 desired,
+    PalMemoryOrder order)
+{
+#if PAL_ATOMIC_MSVC
+    (void)order;
+    Int32 prev = (Int32)_InterlockedCompareExchange(
+        (volatile long*)ptr,
+        desired,
+        *expected);
+
+    if (prev == *expected) {
+        return true;
+    }
+    *expected = prev;
+    return false;
+#else
+    // failure ordering can not contain a release
+    int failure = (int)order;
+    if (order == PAL_MEMORY_ORDER_ACQ_REL) {
+        failure = __ATOMIC_ACQUIRE;
+    } else if (order == PAL_MEMORY_ORDER_RELEASE) {
+        failure = __ATOMIC_RELAXED;
+    }
+
+    return __atomic_compare_exchange_n(
+        ptr,
+        expected,
+        desired,
+        false,
+        (int)order,
+        failure);
+#endif // PAL_ATOMIC_MSVC
+}
+
+/**
+ * @brief Atomically add to a 32-bit value.
+ *
+ * Pass a negative value to subtract.
+ *
+ * @param[in] ptr Pointer to the value. Must be 4-byte aligned.
+ * @param[in] value Value to add.
+ * @param[in] order Memory order.
+ *
+ * @return The value before the addition.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_atomic
+ */
+static inline Int32 palAtomicFetchAdd32(
+    volatile Int32* ptr,
+    Int32 value,
+    PalMemoryOrder order)
+{
+#if PAL_ATOMIC_MSVC
+    (void)order;
+    return (Int32)_InterlockedExchangeAdd((volatile long*)ptr, value);
+#else
+    return __atomic_fetch_add(ptr, value, (int)order);
+#endif // PAL_ATOMIC_MSVC
+}
+
+/**
+ * @brief Atomically load a 64-bit value.
+ *
+ * @param[in] ptr Pointer to the value. Must be 8-byte aligned.
+ * @param[in] order Memory order. Must not be `PAL_MEMORY_ORDER_RELEASE` or
+ * `PAL_MEMORY_ORDER_ACQ_REL`.
+ *
+ * @return The loaded value.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_atomic
+ */
+static inline Int64 palAtomicLoad64(
+    volatile Int64* ptr,
+    PalMemoryOrder order)
+{
+#if PAL_ATOMIC_MSVC
+#if defined(_M_IX86)
+    // 32-bit x86 can not load 64 bits atomically with a plain move
+    (void)order;
+    return _InterlockedCompareExchange64(ptr, 0, 0);
+#else
+    Int64 value = *ptr;
+    if (order != PAL_MEMORY_ORDER_RELAXED) {
+        PAL_ATOMIC_ARM64_FENCE();
+    }
+    _ReadWriteBarrier();
+    return value;
+#endif // _M_IX86
+#else
+    return __atomic_load_n(ptr, (int)order);
+#endif // PAL_ATOMIC_MSVC
+}
+
+/**
+ * @brief Atomically store a 64-bit value.
+ *
+ * @param[in] ptr Pointer to the value. Must be 8-byte aligned.
+ * @param[in] value Value to store.
+ * @param[in] order Memory order. Must not be `PAL_MEMORY_ORDER_ACQUIRE` or
+ * `PAL_MEMORY_ORDER_ACQ_REL`.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_atomic
+ */
+static inline void palAtomicStore64(
+    volatile Int64* ptr,
+    Int64 value,
+    PalMemoryOrder order)
+{
+#if PAL_ATOMIC_MSVC
+#if defined(_M_IX86)
+    (void)order;
+    Int64 prev = *ptr;
+    Int64 seen;
+    while ((seen = _InterlockedCompareExchange64(ptr, value, prev)) != prev) {
+        prev = seen;
+    }
+#else
+    if (order == PAL_MEMORY_ORDER_SEQ_CST) {
+        _InterlockedExchange64(ptr, value);
+        return;
+    }
+
+    if (order != PAL_MEMORY_ORDER_RELAXED) {
+        PAL_ATOMIC_ARM64_FENCE();
+    }
+    _ReadWriteBarrier();
+    *ptr = value;
+#endif // _M_IX86
+#else
+    __atomic_store_n(ptr, value, (int)order);
+#endif // PAL_ATOMIC_MSVC
+}
+
+/**
+ * @brief Atomically replace a 64-bit value.
+ *
+ * @param[in] ptr Pointer to the value. Must be 8-byte aligned.
+ * @param[in] value Value to store.
+ * @param[in] order Memory order.
+ *
+ * @return The previous value.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_atomic
+ */
+static inline Int64 palAtomicExchange64(
+    volatile Int64* ptr,
+    Int64 value,
+    PalMemoryOrder order)
+{
+#if PAL_ATOMIC_MSVC
+    (void)order;
+#if defined(_M_IX86)
+    Int64 prev = *ptr;
+    Int64 seen;
+    while ((seen = _InterlockedCompareExchange64(ptr, value, prev)) != prev) {
+        prev = seen;
+    }
+    return prev;
+#else
+    return _InterlockedExchange64(ptr, value);
+#endif // _M_IX86
+#else
+    return __atomic_exchange_n(ptr, value, (int)order);
+#endif // PAL_ATOMIC_MSVC
+}
+
+/**
+ * @brief Atomically replace a 64-bit value if it equals an expected value.
+ *
+ * On failure the current value is written to `expected` and ordered as a
+ * load with `order`, without its release part.
+ *
+ * @param[in] ptr Pointer to the value. Must be 8-byte aligned.
+ * @param[in, out] expected Pointer to the expected value. Must not be nullptr.
+ * @param[in] desired Value to store if the current value equals `expected`.
+ * @param[in] order Memory order.
+ *
+ * @return True if the value was replaced, otherwise false.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_atomic
+ */
+static inline bool palAtomicCompareExchange64(
+    volatile Int64* ptr,
+    Int64* expected,
+    Int64 desired,
+    PalMemoryOrder order)
+{
+#if PAL_ATOMIC_MSVC
+    (void)order;
+    Int64 prev = _InterlockedCompareExchange64(ptr, desired, *expected);
+    if (prev == *expected) {
+        return true;
+    }
+    *expected = prev;
+    return false;
+#else
+    int failure = (int)order;
+    if (order == PAL_MEMORY_ORDER_ACQ_REL) {
+        failure = __ATOMIC_ACQUIRE;
+    } else if (order == PAL_MEMORY_ORDER_RELEASE) {
+        failure = __ATOMIC_RELAXED;
+    }
+
+    return __atomic_compare_exchange_n(
+        ptr,
+        expected,
+        desired,
+        false,
+        (int)order,
+        failure);
+#endif // PAL_ATOMIC_MSVC
+}
+
+/**
+ * @brief Atomically add to a 64-bit value.
+ *
+ * Pass a negative value to subtract.
+ *
+ * @param[in] ptr Pointer to the value. Must be 8-byte aligned.
+ * @param[in] value Value to add.
+ * @param[in] order Memory order.
+ *
+ * @return The value before the addition.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_atomic
+ */
+static inline Int64 palAtomicFetchAdd64(
+    volatile Int64* ptr,
+    Int64 value,
+    PalMemoryOrder order)
+{
+#if PAL_ATOMIC_MSVC
+    (void)order;
+#if defined(_M_IX86)
+    Int64 prev = *ptr;
+    Int64 seen;
+    while ((seen = _InterlockedCompareExchange64(ptr, prev + value, prev)) !=
+           prev) {
+        prev = seen;
+    }
+    return prev;
+#else
+    return _InterlockedExchangeAdd64(ptr, value);
+#endif // _M_IX86
+#else
+    return __atomic_fetch_add(ptr, value, (int)order);
+#endif // PAL_ATOMIC_MSVC
+}
+
+/**
+ * @brief Atomically load a pointer.
+ *
+ * @param[in] ptr Pointer to the pointer. Must be pointer aligned.
+ * @param[in] order Memory order. Must not be `PAL_MEMORY_ORDER_RELEASE` or
+ * `PAL_MEMORY_ORDER_ACQ_REL`.
+ *
+ * @return The loaded pointer.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_atomic
+ */
+static inline void* palAtomicLoadPtr(
+    void* volatile* ptr,
+    PalMemoryOrder order)
+{
+#if PAL_ATOMIC_MSVC
+    void* value = *ptr;
+    if (order != PAL_MEMORY_ORDER_RELAXED) {
+        PAL_ATOMIC_ARM64_FENCE();
+    }
+    _ReadWriteBarrier();
+    return value;
+#else
+    return __atomic_load_n(ptr, (int)order);
+#endif // PAL_ATOMIC_MSVC
+}
+
+/**
+ * @brief Atomically replace a pointer.
+ *
+ * @param[in] ptr Pointer to the pointer. Must be pointer aligned.
+ * @param[in] value Pointer to store.
+ * @param[in] order Memory order.
+ *
+ * @return The previous pointer.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_atomic
+ */
+static inline void* palAtomicExchangePtr(
+    void* volatile* ptr,
+    void* value,
+    PalMemoryOrder order)
+{
+#if PAL_ATOMIC_MSVC
+    (void)order;
+#if defined(_M_IX86)
+    // 32-bit MSVC has no pointer intrinsics, pointers are 32 bits wide
+    return (void*)_InterlockedExchange((volatile long*)ptr, (long)value);
+#else
+    return _InterlockedExchangePointer(ptr, value);
+#endif // _M_IX86
+#else
+    return __atomic_exchange_n(ptr, value, (int)order);
+#endif // PAL_ATOMIC_MSVC
+}
+
+/**
+ * @brief Atomically store a pointer.
+ *
+ * @param[in] ptr Pointer to the pointer. Must be pointer aligned.
+ * @param[in] value Pointer to store.
+ * @param[in] order Memory order. Must not be `PAL_MEMORY_ORDER_ACQUIRE` or
+ * `PAL_MEMORY_ORDER_ACQ_REL`.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_atomic
+ */
+static inline void palAtomicStorePtr(
+    void* volatile* ptr,
+    void* value,
+    PalMemoryOrder order)
+{
+#if PAL_ATOMIC_MSVC
+    if (order == PAL_MEMORY_ORDER_SEQ_CST) {
+        palAtomicExchangePtr(ptr, value, order);
+        return;
+    }
+
+    if (order != PAL_MEMORY_ORDER_RELAXED) {
+        PAL_ATOMIC_ARM64_FENCE();
+    }
+    _ReadWriteBarrier();
+    *ptr = value;
+#else
+    __atomic_store_n(ptr, value, (int)order);
+#endif // PAL_ATOMIC_MSVC
+}
+
+/**
+ * @brief Atomically replace a pointer if it equals an expected pointer.
+ *
+ * On failure the current pointer is written to `expected` and ordered as a
+ * load with `order`, without its release part.
+ *
+ * @param[in] ptr Pointer to the pointer. Must be pointer aligned.
+ * @param[in, out] expected Pointer to the expected pointer. Must not be
+ * nullptr.
+ * @param[in] desired Pointer to store if the current pointer equals
+ * `expected`.
+ * @param[in] order Memory order.
+ *
+ * @return True if the pointer was replaced, otherwise false.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_atomic
+ */
+static inline bool palAtomicCompareExchangePtr(
+    void* volatile* ptr,
+    void** expected,
+    void* desired,
+    PalMemoryOrder order)
+{
+#if PAL_ATOMIC_MSVC
+    (void)order;
+#if defined(_M_IX86)
+    void* prev = (void*)_InterlockedCompareExchange(
+        (volatile long*)ptr,
+        (long)desired,
+        (long)*expected);
+#else
+    void* prev = _InterlockedCompareExchangePointer(ptr, desired, *expected);
+#endif // _M_IX86
+    if (prev == *expected) {
+        return true;
+    }
+    *expected = prev;
+    return false;
+#else
+    int failure = (int)order;
+    if (order == PAL_MEMORY_ORDER_ACQ_REL) {
+        failure = __ATOMIC_ACQUIRE;
+    } else if (order == PAL_MEMORY_ORDER_RELEASE) {
+        failure = __ATOMIC_RELAXED;
+    }
+
+    return __atomic_compare_exchange_n(
+        ptr,
+        expected,
+        desired,
+        false,
+        (int)order,
+        failure);
+#endif // PAL_ATOMIC_MSVC
+}
+
+/** @} */ // end of pal_atomic group
+
+#endif // _PAL_ATOMIC_H
@@ -6,3 +6,14 @@
 #define PAL_HAS_THREAD 1
 #define PAL_HAS_VIDEO 1
 #define PAL_HAS_OPENGL 1
+#define PAL_HAS_JOBS 1
+#define PAL_HAS_PROFILER 1
+#define PAL_PROFILE_INTERNALS 0
+
+#ifndef PAL_LOG_LEVEL
+#ifdef NDEBUG
+#define PAL_LOG_LEVEL 2
+#else
+#define PAL_LOG_LEVEL 0
+#endif // NDEBUG
+#endif // PAL_LOG_LEVEL
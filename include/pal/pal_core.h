@@ -34,6 +34,8 @@ freely, subject to the following restrictions:
 
 #include <stdint.h>
 
+#include "pal_config.h"
+
 #ifdef __cplusplus
 #define PAL_EXTERN_C extern "C"
 #else
@@ -199,6 +201,66 @@ typedef void(PAL_CALL* PalLogCallback)(
     void* userData,
     const char* msg);
 
+/**
+ * @enum PalLogLevel
+ * @brief Log severity levels. This is not a bitmask.
+ *
+ * Levels are ordered by severity. A logger discards every message below its
+ * configured level before the message is formatted.
+ *
+ * All log levels follow the format `PAL_LOG_LEVEL_**` for consistency and API
+ * use.
+ *
+ * @since 1.1
+ * @ingroup pal_core
+ */
+typedef enum {
+    PAL_LOG_LEVEL_TRACE,
+    PAL_LOG_LEVEL_DEBUG,
+    PAL_LOG_LEVEL_INFO,
+    PAL_LOG_LEVEL_WARN,
+    PAL_LOG_LEVEL_ERROR,
+    PAL_LOG_LEVEL_FATAL,
+    PAL_LOG_LEVEL_OFF /**< Discard all messages.*/
+} PalLogLevel;
+
+/**
+ * @enum PalLogCategory
+ * @brief Log categories used to filter messages with ::PalLogger.
+ *
+ * Bits from `PAL_LOG_CATEGORY_USER` upwards are free for user categories.
+ *
+ * All log categories follow the format `PAL_LOG_CATEGORY_**` for consistency
+ * and API use.
+ *
+ * @since 1.1
+ * @ingroup pal_core
+ */
+typedef enum {
+    PAL_LOG_CATEGORY_CORE = PAL_BIT(0),
+    PAL_LOG_CATEGORY_SYSTEM = PAL_BIT(1),
+    PAL_LOG_CATEGORY_THREAD = PAL_BIT(2),
+    PAL_LOG_CATEGORY_EVENT = PAL_BIT(3),
+    PAL_LOG_CATEGORY_VIDEO = PAL_BIT(4),
+    PAL_LOG_CATEGORY_OPENGL = PAL_BIT(5),
+    PAL_LOG_CATEGORY_USER = PAL_BIT(16) /**< First user category bit.*/
+} PalLogCategory;
+
+/**
+ * @enum PalTickSource
+ * @brief Clock sources used by palGetTicks(). This is not a bitmask.
+ *
+ * All tick sources follow the format `PAL_TICK_SOURCE_**` for consistency and
+ * API use.
+ *
+ * @since 1.1
+ * @ingroup pal_core
+ */
+typedef enum {
+    PAL_TICK_SOURCE_OS,  /**< The performance counter of the OS.*/
+    PAL_TICK_SOURCE_TSC /**< The invariant CPU time stamp counter.*/
+} PalTickSource;
+
 /**
  * @enum PalResult
  * @brief Codes returned by most PAL functions. This is not a bitmask.
@@ -271,14 +333,19 @@ typedef struct {
  * @struct PalLogger
  * @brief Logging configuration.
  *
- * Provides a callback and user data for handling log messages.
+ * Provides a callback and user data for handling log messages. Messages below
+ * `level` or outside `categories` are discarded before formatting.
+ *
+ * Uninitialized fields may result in undefined behavior.
  *
  * @since 1.0
  * @ingroup pal_core
  */
 typedef struct {
     PalLogCallback callback;
-    void* userData; /** Optional user-provided data. Can be nullptr.*/
+    void* userData;    /** Optional user-provided data. Can be nullptr.*/
+    PalLogLevel level; /**< Minimum level to log. (since 1.1)*/
+    Uint32 categories; /**< PalLogCategory mask. Set to 0 for all (since 1.1)*/
 } PalLogger;
 
 /**
@@ -364,7 +431,10 @@ PAL_API void PAL_CALL palFree(
 /**
  * Log a formatted message.
  *
- * @param logger Logger instance. Must not be NULL.
+ * The message is logged at `PAL_LOG_LEVEL_INFO` with no category. See
+ * palLogEx() for more information.
+ *
+ * @param logger Logger instance. Set to nullptr to log to the console.
  * @param fmt printf-style format string.
  * @param ... Arguments for the format string.
  *
@@ -374,13 +444,45 @@ PAL_API void PAL_CALL palFree(
  *
  * @since 1.0
  * @ingroup pal_core
- * @sa palFormatResult
+ * @sa palLogEx
  */
 PAL_API void PAL_CALL palLog(
     const PalLogger* logger,
     const char* fmt,
     ...);
 
+/**
+ * Log a formatted message with a severity level and category.
+ *
+ * The message is discarded before formatting if palShouldLog() returns false
+ * for the provided logger. If `logger` is nullptr, the message is written to
+ * the console.
+ *
+ * Prefer the `PAL_LOG_**` macros, which also compile out levels below
+ * `PAL_LOG_LEVEL` from pal_config.h.
+ *
+ * @param logger Logger instance. Set to nullptr to log to the console.
+ * @param level Severity of the message.
+ * @param category A single PalLogCategory bit. Set to 0 for uncategorized
+ * messages, which are only filtered by level.
+ * @param fmt printf-style format string.
+ * @param ... Arguments for the format string.
+ *
+ * Thread safety: This function is thread safe, but log output and
+ * callbacks may be invoked concurrently. The user must ensure the callback
+ * implementation is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_core
+ * @sa palLog
+ */
+PAL_API void PAL_CALL palLogEx(
+    const PalLogger* logger,
+    PalLogLevel level,
+    Uint32 category,
+    const char* fmt,
+    ...);
+
 /**
  * Query a high-resolution performance counter value.
  *
@@ -407,6 +509,75 @@ PAL_API Uint64 PAL_CALL palGetPerformanceCounter();
  */
 PAL_API Uint64 PAL_CALL palGetPerformanceFrequency();
 
+/**
+ * Calibrate the tick source used by palGetTicks().
+ *
+ * If the CPU has an invariant time stamp counter (TSC), its frequency is
+ * measured against palGetPerformanceCounter() for the provided duration and
+ * palGetTicks() reads the TSC from then on. Otherwise palGetTicks() keeps
+ * using the OS performance counter.
+ *
+ * Until this is called, palGetTicks() uses the OS performance counter. A
+ * longer calibration gives a more accurate frequency.
+ *
+ * @param milliseconds Duration to calibrate for. Set to 0 to use default (10).
+ *
+ * @return The tick source palGetTicks() uses after the calibration.
+ *
+ * Thread safety: This function is not thread safe. Call it once at startup
+ * before other threads read ticks.
+ *
+ * @since 1.1
+ * @ingroup pal_core
+ * @sa palGetTicks
+ */
+PAL_API PalTickSource PAL_CALL palCalibrateTicks(Uint64 milliseconds);
+
+/**
+ * Read the current tick value.
+ *
+ * This is the cheapest clock PAL has. Ticks are only meaningful relative to
+ * each other; use palGetTicksFrequency() or palTicksToNanoseconds() to convert
+ * them.
+ *
+ * @return The current tick value.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_core
+ * @sa palCalibrateTicks
+ */
+PAL_API Uint64 PAL_CALL palGetTicks();
+
+/**
+ * Query the frequency of palGetTicks().
+ *
+ * @return Tick frequency, in ticks per second.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_core
+ * @sa palGetTicks
+ */
+PAL_API Uint64 PAL_CALL palGetTicksFrequency();
+
+/**
+ * Convert a tick count from palGetTicks() to nanoseconds.
+ *
+ * @param ticks Number of ticks. This is usually a difference of two ticks.
+ *
+ * @return The number of nanoseconds.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_core
+ * @sa palGetTicks
+ */
+PAL_API Uint64 PAL_CALL palTicksToNanoseconds(Uint64 ticks);
+
 /**
  * @brief Combine two 32-bit unsigned integers into a single 64-bit signed
  * integer.
@@ -530,6 +701,137 @@ static inline void* PAL_CALL palUnpackPointer(Int64 data)
     return (void*)(UintPtr)data;
 }
 
+/**
+ * @brief Check if a message would be accepted by the provided logger.
+ *
+ * This is the runtime check done by palLogEx() before formatting.
+ *
+ * @param logger Logger instance. If nullptr, all messages are accepted.
+ * @param level Severity of the message.
+ * @param category A single PalLogCategory bit or 0 for uncategorized.
+ *
+ * @return true if the message should be logged, otherwise false.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_core
+ * @sa palLogEx
+ */
+static inline bool PAL_CALL palShouldLog(
+    const PalLogger* logger,
+    PalLogLevel level,
+    Uint32 category)
+{
+    if (!logger) {
+        return true;
+    }
+
+    if (level < logger->level || level == PAL_LOG_LEVEL_OFF) {
+        return false;
+    }
+
+    if (category && logger->categories) {
+        return (logger->categories & category) != 0;
+    }
+    return true;
+}
+
+#ifndef PAL_LOG_LEVEL
+#define PAL_LOG_LEVEL 0
+#endif // PAL_LOG_LEVEL
+
+// logger, level and category are evaluated once
+// clang-format off
+#define PAL_LOG_AT(logger, level, category, ...)                               \
+    do {                                                                       \
+        const PalLogger* _palLogger = (logger);                                \
+        PalLogLevel _palLevel = (level);                                       \
+        Uint32 _palCategory = (Uint32)(category);                              \
+        if (palShouldLog(_palLogger, _palLevel, _palCategory)) {               \
+            palLogEx(_palLogger, _palLevel, _palCategory, __VA_ARGS__);        \
+        }                                                                      \
+    } while (0)
+// clang-format on
+
+/**
+ * @def PAL_LOG_TRACE
+ * @brief Log a trace message. Compiled out if `PAL_LOG_LEVEL` is above 0.
+ * @since 1.1
+ * @ingroup pal_core
+ */
+#if PAL_LOG_LEVEL <= 0
+#define PAL_LOG_TRACE(logger, category, ...)                                   \
+    PAL_LOG_AT(logger, PAL_LOG_LEVEL_TRACE, category, __VA_ARGS__)
+#else
+#define PAL_LOG_TRACE(logger, category, ...) ((void)0)
+#endif // PAL_LOG_LEVEL
+
+/**
+ * @def PAL_LOG_DEBUG
+ * @brief Log a debug message. Compiled out if `PAL_LOG_LEVEL` is above 1.
+ * @since 1.1
+ * @ingroup pal_core
+ */
+#if PAL_LOG_LEVEL <= 1
+#define PAL_LOG_DEBUG(logger, category, ...)                                   \
+    PAL_LOG_AT(logger, PAL_LOG_LEVEL_DEBUG, category, __VA_ARGS__)
+#else
+#define PAL_LOG_DEBUG(logger, category, ...) ((void)0)
+#endif // PAL_LOG_LEVEL
+
+/**
+ * @def PAL_LOG_INFO
+ * @brief Log an info message. Compiled out if `PAL_LOG_LEVEL` is above 2.
+ * @since 1.1
+ * @ingroup pal_core
+ */
+#if PAL_LOG_LEVEL <= 2
+#define PAL_LOG_INFO(logger, category, ...)                                    \
+    PAL_LOG_AT(logger, PAL_LOG_LEVEL_INFO, category, __VA_ARGS__)
+#else
+#define PAL_LOG_INFO(logger, category, ...) ((void)0)
+#endif // PAL_LOG_LEVEL
+
+/**
+ * @def PAL_LOG_WARN
+ * @brief Log a warning. Compiled out if `PAL_LOG_LEVEL` is above 3.
+ * @since 1.1
+ * @ingroup pal_core
+ */
+#if PAL_LOG_LEVEL <= 3
+#define PAL_LOG_WARN(logger, category, ...)                                    \
+    PAL_LOG_AT(logger, PAL_LOG_LEVEL_WARN, category, __VA_ARGS__)
+#else
+#define PAL_LOG_WARN(logger, category, ...) ((void)0)
+#endif // PAL_LOG_LEVEL
+
+/**
+ * @def PAL_LOG_ERROR
+ * @brief Log an error. Compiled out if `PAL_LOG_LEVEL` is above 4.
+ * @since 1.1
+ * @ingroup pal_core
+ */
+#if PAL_LOG_LEVEL <= 4
+#define PAL_LOG_ERROR(logger, category, ...)                                   \
+    PAL_LOG_AT(logger, PAL_LOG_LEVEL_ERROR, category, __VA_ARGS__)
+#else
+#define PAL_LOG_ERROR(logger, category, ...) ((void)0)
+#endif // PAL_LOG_LEVEL
+
+/**
+ * @def PAL_LOG_FATAL
+ * @brief Log a fatal error. Compiled out if `PAL_LOG_LEVEL` is above 5.
+ * @since 1.1
+ * @ingroup pal_core
+ */
+#if PAL_LOG_LEVEL <= 5
+#define PAL_LOG_FATAL(logger, category, ...)                                   \
+    PAL_LOG_AT(logger, PAL_LOG_LEVEL_FATAL, category, __VA_ARGS__)
+#else
+#define PAL_LOG_FATAL(logger, category, ...) ((void)0)
+#endif // PAL_LOG_LEVEL
+
 /** @} */ // end of pal_core group
 
 #endif // _PAL_CORE_H
\ No newline at end of file
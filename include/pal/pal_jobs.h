@@ -0,0 +1,419 @@
+
+/**
+
+Copyright (C) 2025 Nicholas Agbo
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+
+ */
+
+/**
+ * @defgroup pal_jobs Jobs
+ * Jobs PAL functionality such as a work-stealing job system with fork-join
+ * and a thread pool with parallel-for.
+ *
+ * @{
+ */
+
+#ifndef _PAL_JOBS_H
+#define _PAL_JOBS_H
+
+#include "pal_thread.h"
+
+/**
+ * @struct PalJobSystem
+ * @brief Opaque handle to a job system.
+ *
+ * @since 1.1
+ * @ingroup pal_jobs
+ */
+typedef struct PalJobSystem PalJobSystem;
+
+/**
+ * @struct PalJob
+ * @brief Opaque handle to a job.
+ *
+ * @since 1.1
+ * @ingroup pal_jobs
+ */
+typedef struct PalJob PalJob;
+
+/**
+ * @struct PalThreadPool
+ * @brief Opaque handle to a thread pool.
+ *
+ * @since 1.1
+ * @ingroup pal_jobs
+ */
+typedef struct PalThreadPool PalThreadPool;
+
+/**
+ * @typedef PalTaskFn
+ * @brief Function pointer type used for thread pool tasks.
+ *
+ * @param[in] userData Optional pointer to user data. Can be nullptr.
+ *
+ * @since 1.1
+ * @ingroup pal_jobs
+ */
+typedef void(PAL_CALL* PalTaskFn)(void* userData);
+
+/**
+ * @typedef PalParallelForFn
+ * @brief Function pointer type used for palParallelFor() chunks.
+ *
+ * @param[in] begin First index of the chunk.
+ * @param[in] end One past the last index of the chunk.
+ * @param[in] userData Optional pointer to user data. Can be nullptr.
+ *
+ * @since 1.1
+ * @ingroup pal_jobs
+ */
+typedef void(PAL_CALL* PalParallelForFn)(
+    Uint64 begin,
+    Uint64 end,
+    void* userData);
+
+/**
+ * @typedef PalJobFn
+ * @brief Function pointer type used for job entry function.
+ *
+ * @param[in] system The job system running the job. Can be used to create and
+ * run child jobs.
+ * @param[in] job The job being run.
+ * @param[in] userData Optional pointer to user data. Can be nullptr.
+ *
+ * @since 1.1
+ * @ingroup pal_jobs
+ */
+typedef void(PAL_CALL* PalJobFn)(
+    PalJobSystem* system,
+    PalJob* job,
+    void* userData);
+
+/**
+ * @struct PalJobSystemCreateInfo
+ * @brief Creation parameters for a job system.
+ *
+ * Uninitialized fields may result in undefined behavior.
+ *
+ * @since 1.1
+ * @ingroup pal_jobs
+ */
+typedef struct {
+    const PalAllocator* allocator; /**< Set to nullptr to use default.*/
+    Uint32 workerCount; /**< Workers including the creating thread.*/
+    Uint32 maxJobsPerWorker; /**< Set to 0 to use default (4096).*/
+    Uint64 stackSize;        /**< Worker stack size. Set to 0 to use default*/
+    bool pinWorkers; /**< Pin worker `i` to physical core `i`.*/
+} PalJobSystemCreateInfo;
+
+/**
+ * @struct PalThreadPoolCreateInfo
+ * @brief Creation parameters for a thread pool.
+ *
+ * Uninitialized fields may result in undefined behavior.
+ *
+ * @since 1.1
+ * @ingroup pal_jobs
+ */
+typedef struct {
+    const PalAllocator* allocator; /**< Set to nullptr to use default.*/
+    Uint32 workerCount;   /**< Worker threads. Must be greater than zero.*/
+    Uint32 queueCapacity; /**< Set to 0 to use default (1024).*/
+    Uint64 stackSize;     /**< Worker stack size. Set to 0 to use default*/
+} PalThreadPoolCreateInfo;
+
+/**
+ * @brief Create a job system.
+ *
+ * The calling thread becomes worker 0 and `workerCount - 1` worker threads
+ * are created. Worker 0 only runs jobs while it is inside palJobWait().
+ * Workers that find no job to run or steal sleep until a job is pushed.
+ *
+ * Each worker owns a work-stealing deque and a ring of
+ * `maxJobsPerWorker` jobs, so creating and running jobs does not allocate.
+ * Jobs are recycled in creation order, so a worker can create at most
+ * `maxJobsPerWorker` jobs past its oldest unfinished one. `maxJobsPerWorker`
+ * is rounded up to a power of two.
+ *
+ * If `pinWorkers` is true and the platform supports
+ * `PAL_THREAD_FEATURE_AFFINITY`, worker thread `i` is pinned to the SMT
+ * siblings of physical core `i`, wrapping around if there are more workers
+ * than cores, so workers do not share a core and its caches. The creating
+ * thread is not pinned.
+ *
+ * The allocator field in the provided PalJobSystemCreateInfo struct will not
+ * be copied, therefore the pointer must remain valid until the job system is
+ * destroyed. Destroy the job system with palDestroyJobSystem() when no longer
+ * needed.
+ *
+ * @param[in] info Pointer to a PalJobSystemCreateInfo struct that specifies
+ * paramters. Must not be nullptr.
+ * @param[out] outSystem Pointer to a PalJobSystem to recieve the created job
+ * system. Must not be nullptr.
+ *
+ * @return `PAL_RESULT_SUCCESS` on success or a result code on
+ * failure. Call palFormatResult() for more information.
+ *
+ * Thread safety: This function is thread safe if the provided allocator is
+ * thread safe and `outSystem` is thread local. The default allocator is
+ * thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_jobs
+ * @sa palDestroyJobSystem
+ */
+PAL_API PalResult PAL_CALL palCreateJobSystem(
+    const PalJobSystemCreateInfo* info,
+    PalJobSystem** outSystem);
+
+/**
+ * @brief Destroy the job system.
+ *
+ * All jobs must have finished before this call. The worker threads are
+ * joined and all jobs are freed. If the provided job system is invalid or
+ * nullptr, the function returns silently.
+ *
+ * @param[in] system Pointer to the job system to destroy.
+ *
+ * Thread safety: This function must only be called from the thread that
+ * created the job system.
+ *
+ * @since 1.1
+ * @ingroup pal_jobs
+ * @sa palCreateJobSystem
+ */
+PAL_API void PAL_CALL palDestroyJobSystem(PalJobSystem* system);
+
+/**
+ * @brief Create a job.
+ *
+ * The job is not run until it is passed to palRunJob(). If `parent` is not
+ * nullptr, the parent is not finished until this job has finished, which
+ * lets palJobWait() on the parent wait for the whole tree.
+ *
+ * @param[in] system Pointer to the job system.
+ * @param[in] parent Optional parent job. Can be nullptr.
+ * @param[in] func Job entry function. Must not be nullptr.
+ * @param[in] userData Optional pointer to user data. Can be nullptr.
+ *
+ * @return The created job on success or nullptr on failure. This fails if
+ * the next job in the ring of the calling worker has not finished.
+ *
+ * Thread safety: This function must only be called from the thread that
+ * created the job system or from inside a job.
+ *
+ * @since 1.1
+ * @ingroup pal_jobs
+ * @sa palRunJob
+ */
+PAL_API PalJob* PAL_CALL palCreateJob(
+    PalJobSystem* system,
+    PalJob* parent,
+    PalJobFn func,
+    void* userData);
+
+/**
+ * @brief Push a job to the calling worker so it can be run or stolen.
+ *
+ * If the provided job system or job is invalid or nullptr, the function
+ * returns silently.
+ *
+ * @param[in] system Pointer to the job system.
+ * @param[in] job Pointer to the job created with palCreateJob().
+ *
+ * Thread safety: This function must only be called from the thread that
+ * created the job system or from inside a job.
+ *
+ * @since 1.1
+ * @ingroup pal_jobs
+ * @sa palJobWait
+ */
+PAL_API void PAL_CALL palRunJob(
+    PalJobSystem* system,
+    PalJob* job);
+
+/**
+ * @brief Wait for a job and all its children to finish.
+ *
+ * The calling worker does not block. It runs jobs from its own deque or
+ * steals from other workers until the job has finished. If the provided job
+ * system or job is invalid or nullptr, the function returns silently.
+ *
+ * @param[in] system Pointer to the job system.
+ * @param[in] job Pointer to the job to wait for.
+ *
+ * Thread safety: This function must only be called from the thread that
+ * created the job system or from inside a job.
+ *
+ * @since 1.1
+ * @ingroup pal_jobs
+ * @sa palRunJob
+ */
+PAL_API void PAL_CALL palJobWait(
+    PalJobSystem* system,
+    PalJob* job);
+
+/**
+ * @brief Get the index of the calling worker.
+ *
+ * @param[in] system Pointer to the job system.
+ *
+ * @return The worker index in `[0, workerCount)` or -1 if the calling thread
+ * is not a worker of the job system.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_jobs
+ */
+PAL_API Int32 PAL_CALL palGetJobWorkerIndex(PalJobSystem* system);
+
+/**
+ * @brief Create a thread pool.
+ *
+ * `workerCount` threads are created once and live until the pool is
+ * destroyed. Tasks go through a bounded multi-producer multi-consumer queue
+ * of `queueCapacity` slots, rounded up to a power of two. Submitting and
+ * running a task does not allocate. Idle workers sleep until a task is
+ * submitted.
+ *
+ * Unlike PalJobSystem, any thread can submit tasks and tasks have no
+ * parent/child relation. Use it for independent work and data-parallel
+ * loops.
+ *
+ * The allocator field in the provided PalThreadPoolCreateInfo struct will not
+ * be copied, therefore the pointer must remain valid until the thread pool is
+ * destroyed. Destroy the thread pool with palDestroyThreadPool() when no
+ * longer needed.
+ *
+ * @param[in] info Pointer to a PalThreadPoolCreateInfo struct that specifies
+ * paramters. Must not be nullptr.
+ * @param[out] outPool Pointer to a PalThreadPool to recieve the created
+ * thread pool. Must not be nullptr.
+ *
+ * @return `PAL_RESULT_SUCCESS` on success or a result code on
+ * failure. Call palFormatResult() for more information.
+ *
+ * Thread safety: This function is thread safe if the provided allocator is
+ * thread safe and `outPool` is thread local. The default allocator is
+ * thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_jobs
+ * @sa palDestroyThreadPool
+ */
+PAL_API PalResult PAL_CALL palCreateThreadPool(
+    const PalThreadPoolCreateInfo* info,
+    PalThreadPool** outPool);
+
+/**
+ * @brief Destroy the thread pool.
+ *
+ * Waits for all submitted tasks to finish, then joins the worker threads.
+ * If the provided thread pool is invalid or nullptr, the function returns
+ * silently.
+ *
+ * @param[in] pool Pointer to the thread pool to destroy.
+ *
+ * Thread safety: This function must not be called from a task and no
+ * thread must submit tasks while it runs.
+ *
+ * @since 1.1
+ * @ingroup pal_jobs
+ * @sa palCreateThreadPool
+ */
+PAL_API void PAL_CALL palDestroyThreadPool(PalThreadPool* pool);
+
+/**
+ * @brief Submit a task to the thread pool.
+ *
+ * If the queue is full, the task is run on the calling thread before this
+ * returns. That bounds the queue without blocking or failing and slows down
+ * producers that outpace the workers.
+ *
+ * @param[in] pool Pointer to the thread pool.
+ * @param[in] func Task function. Must not be nullptr.
+ * @param[in] userData Optional pointer to user data. Can be nullptr.
+ *
+ * @return `PAL_RESULT_SUCCESS` on success or a result code on
+ * failure. Call palFormatResult() for more information.
+ *
+ * Thread safety: This function is thread safe and can be called from tasks.
+ *
+ * @since 1.1
+ * @ingroup pal_jobs
+ * @sa palWaitThreadPool
+ */
+PAL_API PalResult PAL_CALL palSubmitTask(
+    PalThreadPool* pool,
+    PalTaskFn func,
+    void* userData);
+
+/**
+ * @brief Wait until every submitted task has finished.
+ *
+ * If the provided thread pool is invalid or nullptr, the function returns
+ * silently.
+ *
+ * @param[in] pool Pointer to the thread pool.
+ *
+ * Thread safety: This function is thread safe but must not be called from
+ * a task, since the task itself has not finished.
+ *
+ * @since 1.1
+ * @ingroup pal_jobs
+ * @sa palSubmitTask
+ */
+PAL_API void PAL_CALL palWaitThreadPool(PalThreadPool* pool);
+
+/**
+ * @brief Run a function over the range `[0, count)` in parallel.
+ *
+ * The range is split into chunks of `grainSize` indices, which workers and
+ * the calling thread take in order until the range is done. If `grainSize`
+ * is 0, chunks are sized so each thread gets about eight of them, which
+ * balances uneven work without paying per-index overhead. This returns when
+ * every chunk has finished. While waiting, the calling thread runs other
+ * queued tasks, so nested calls from tasks do not deadlock.
+ *
+ * @param[in] pool Pointer to the thread pool.
+ * @param[in] count Number of indices.
+ * @param[in] grainSize Indices per chunk. Set to 0 for automatic chunking.
+ * @param[in] func Chunk function. Must not be nullptr.
+ * @param[in] userData Optional pointer to user data. Can be nullptr.
+ *
+ * @return `PAL_RESULT_SUCCESS` on success or a result code on
+ * failure. Call palFormatResult() for more information.
+ *
+ * Thread safety: This function is thread safe and can be called from tasks.
+ *
+ * @since 1.1
+ * @ingroup pal_jobs
+ * @sa palSubmitTask
+ */
+PAL_API PalResult PAL_CALL palParallelFor(
+    PalThreadPool* pool,
+    Uint64 count,
+    Uint64 grainSize,
+    PalParallelForFn func,
+    void* userData);
+
+/** @} */ // end of pal_jobs group
+
+#endif // _PAL_JOBS_H
@@ -0,0 +1,204 @@
+
+/**
+
+Copyright (C) 2025 Nicholas Agbo
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+
+ */
+/**
+ * @defgroup pal_profiler Profiler
+ * Profiler PAL functionality such as scoped CPU zones and trace export.
+ *
+ * @{
+ */
+
+#ifndef _PAL_PROFILER_H
+#define _PAL_PROFILER_H
+
+#include "pal_core.h"
+
+/**
+ * @typedef PalProfileWriteFn
+ * @brief Function pointer type used to write exported profile data.
+ *
+ * @param[in] userData Optional pointer to user data passed to
+ * palExportProfile(). Can be nullptr.
+ * @param[in] data Pointer to the bytes to write.
+ * @param[in] size Number of bytes to write.
+ *
+ * @since 1.1
+ * @ingroup pal_profiler
+ * @sa palExportProfile
+ */
+typedef void(PAL_CALL* PalProfileWriteFn)(
+    void* userData,
+    const void* data,
+    Uint64 size);
+
+/**
+ * @enum PalProfileFormat
+ * @brief Profile export formats. This is not a bitmask.
+ *
+ * `PAL_PROFILE_FORMAT_CHROME_JSON` writes Chrome `trace_event` JSON which can
+ * be loaded in `chrome://tracing` or Perfetto.
+ *
+ * `PAL_PROFILE_FORMAT_BINARY` writes native endian data in this layout:
+ *
+ * @code
+ * char magic[4] = "PALP";
+ * Uint32 version = 1;
+ * Uint64 frequency;      // palGetPerformanceFrequency()
+ * Uint32 nameCount;
+ * Uint32 threadCount;
+ * nameCount x   { Uint16 size; char name[size]; }
+ * threadCount x { Uint32 threadId; Uint32 eventCount;
+ *                 eventCount x { Uint32 nameIndex; Uint32 type; Uint64 time; }}
+ * @endcode
+ *
+ * `type` is 0 for a zone begin and 1 for a zone end. End events have no name
+ * and their `nameIndex` is 0xFFFFFFFF.
+ *
+ * All profile formats follow the format `PAL_PROFILE_FORMAT_**` for
+ * consistency and API use.
+ *
+ * @since 1.1
+ * @ingroup pal_profiler
+ */
+typedef enum {
+    PAL_PROFILE_FORMAT_CHROME_JSON,
+    PAL_PROFILE_FORMAT_BINARY
+} PalProfileFormat;
+
+/**
+ * @brief Initialize the profiler.
+ *
+ * This must be called before zones are recorded. Zones recorded before this
+ * call are discarded. The profiler must be shutdown with palShutdownProfiler()
+ * when no longer needed.
+ *
+ * Every thread that records a zone gets its own buffer of
+ * `maxEventsPerThread` events. A zone uses two events. When a buffer is full,
+ * new zones on that thread are dropped.
+ *
+ * The allocator will not be copied, therefore the pointer must remain valid
+ * until the profiler is shutdown.
+ *
+ * @param[in] allocator Optional user-provided allocator. Set to nullptr to use
+ * default.
+ * @param[in] maxEventsPerThread Capacity of each thread buffer. Set to 0 to use
+ * default (65536).
+ *
+ * @return `PAL_RESULT_SUCCESS` on success or a result code on
+ * failure. Call palFormatResult() for more information.
+ *
+ * Thread safety: This function must only be called from the main thread.
+ *
+ * @since 1.1
+ * @ingroup pal_profiler
+ * @sa palShutdownProfiler
+ */
+PAL_API PalResult PAL_CALL palInitProfiler(
+    const PalAllocator* allocator,
+    Uint32 maxEventsPerThread);
+
+/**
+ * @brief Shutdown the profiler and free all thread buffers.
+ *
+ * If the profiler has not been initialized, the function returns silently.
+ * No thread may record zones during or after this call.
+ *
+ * Thread safety: This function must only be called from the main thread.
+ *
+ * @since 1.1
+ * @ingroup pal_profiler
+ * @sa palInitProfiler
+ */
+PAL_API void PAL_CALL palShutdownProfiler();
+
+/**
+ * @brief Begin a zone on the calling thread.
+ *
+ * Zones nest and must be closed with palProfileEnd() on the same thread. If
+ * the profiler is not initialized, the function returns silently.
+ *
+ * @param[in] name Null-terminated UTF-8 name. Only the pointer is stored, so
+ * it must remain valid until the profile is exported (eg. a string literal).
+ *
+ * Thread safety: This function is thread safe. Each thread records into its
+ * own buffer without locks.
+ *
+ * @since 1.1
+ * @ingroup pal_profiler
+ * @sa palProfileEnd
+ */
+PAL_API void PAL_CALL palProfileBegin(const char* name);
+
+/**
+ * @brief End the innermost open zone on the calling thread.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_profiler
+ * @sa palProfileBegin
+ */
+PAL_API void PAL_CALL palProfileEnd();
+
+/**
+ * @brief Export all recorded zones.
+ *
+ * Events recorded by other threads while exporting may or may not be part
+ * of the export. Zones that are still open are exported with their begin
+ * event only. Temporary memory comes from the allocator provided to
+ * palInitProfiler().
+ *
+ * @param[in] format The format to export.
+ * @param[in] write Function that receives the exported bytes. Must not be
+ * nullptr.
+ * @param[in] userData Optional pointer passed to `write`. Can be nullptr.
+ *
+ * @return `PAL_RESULT_SUCCESS` on success or a result code on
+ * failure. Call palFormatResult() for more information.
+ *
+ * Thread safety: This function is thread safe, but must not run concurrently
+ * with palShutdownProfiler() or palResetProfile().
+ *
+ * @since 1.1
+ * @ingroup pal_profiler
+ */
+PAL_API PalResult PAL_CALL palExportProfile(
+    PalProfileFormat format,
+    PalProfileWriteFn write,
+    void* userData);
+
+/**
+ * @brief Discard all recorded events.
+ *
+ * Thread buffers are kept and reused. No thread may have an open zone or
+ * record zones during this call.
+ *
+ * Thread safety: This function must only be called from the main thread.
+ *
+ * @since 1.1
+ * @ingroup pal_profiler
+ */
+PAL_API void PAL_CALL palResetProfile();
+
+/** @} */ // end of pal_profiler group
+
+#endif // _PAL_PROFILER_H
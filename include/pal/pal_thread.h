@@ -34,6 +34,31 @@ freely, subject to the following restrictions:
 
 #include "pal_core.h"
 
+/**
+ * @brief Timeout value that makes waits such as palWaitOnAddress() wait
+ * without a limit.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ */
+#define PAL_WAIT_INFINITE UINT64_MAX
+
+/**
+ * @brief Maximum number of logical processors a PalCpuSet can hold.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ */
+#define PAL_MAX_CPU_SET_SIZE 1024
+
+/**
+ * @brief Maximum number of TLS slots that can exist at the same time.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ */
+#define PAL_MAX_TLS_SLOTS 64
+
 /**
  * @typedef PalTLSId
  * @brief Opaque handle to a Thread Local Storage.
@@ -43,6 +68,15 @@ freely, subject to the following restrictions:
  */
 typedef Uint32 PalTLSId;
 
+/**
+ * @typedef PalTLSSlot
+ * @brief Opaque handle to a slot in the PAL managed thread local block.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ */
+typedef Uint32 PalTLSSlot;
+
 /**
  * @struct PalThread
  * @brief Opaque handle to a thread.
@@ -70,6 +104,72 @@ typedef struct PalMutex PalMutex;
  */
 typedef struct PalCondVar PalCondVar;
 
+/**
+ * @struct PalRWLock
+ * @brief Opaque handle to a reader-writer lock.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ */
+typedef struct PalRWLock PalRWLock;
+
+/**
+ * @struct PalSemaphore
+ * @brief Opaque handle to a counting semaphore.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ */
+typedef struct PalSemaphore PalSemaphore;
+
+/**
+ * @struct PalSyncEvent
+ * @brief Opaque handle to a synchronization event.
+ *
+ * Not to be confused with PalEvent, which carries platform events through a
+ * PalEventDriver.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ */
+typedef struct PalSyncEvent PalSyncEvent;
+
+/**
+ * @struct PalBarrier
+ * @brief Opaque handle to a reusable thread barrier.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ */
+typedef struct PalBarrier PalBarrier;
+
+/**
+ * @struct PalLatch
+ * @brief Opaque handle to a one-shot countdown latch.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ */
+typedef struct PalLatch PalLatch;
+
+/**
+ * @struct PalRingBuffer
+ * @brief Opaque handle to a bounded lock-free ring buffer.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ */
+typedef struct PalRingBuffer PalRingBuffer;
+
+/**
+ * @struct PalFiber
+ * @brief Opaque handle to a fiber.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ */
+typedef struct PalFiber PalFiber;
+
 /**
  * @typedef PalThreadFn
  * @brief Function pointer type used for thread entry function.
@@ -83,6 +183,17 @@ typedef struct PalCondVar PalCondVar;
  */
 typedef void* (*PalThreadFn)(void* arg);
 
+/**
+ * @typedef PalFiberFn
+ * @brief Function pointer type used for fiber entry function.
+ *
+ * @param[in] arg Optional pointer to user data. Can be nullptr.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ */
+typedef void (*PalFiberFn)(void* arg);
+
 /**
  * @typedef PaTlsDestructorFn
  * @brief Function pointer type used for TLS.
@@ -110,7 +221,8 @@ typedef enum {
     PAL_THREAD_FEATURE_STACK_SIZE = PAL_BIT(0),
     PAL_THREAD_FEATURE_PRIORITY = PAL_BIT(1),
     PAL_THREAD_FEATURE_AFFINITY = PAL_BIT(2),
-    PAL_THREAD_FEATURE_NAME = PAL_BIT(3)
+    PAL_THREAD_FEATURE_NAME = PAL_BIT(3),
+    PAL_THREAD_FEATURE_CUSTOM_STACK = PAL_BIT(4)
 } PalThreadFeatures;
 
 /**
@@ -129,6 +241,116 @@ typedef enum {
     PAL_THREAD_PRIORITY_HIGH
 } PalThreadPriority;
 
+/**
+ * @enum PalSchedulingPolicy
+ * @brief Thread scheduling policies. This is not a bitmask enum.
+ *
+ * All scheduling policies follow the format `PAL_SCHEDULING_POLICY_**` for
+ * consistency and API use.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ */
+typedef enum {
+    PAL_SCHEDULING_POLICY_IDLE,   /**< Runs only when nothing else would.*/
+    PAL_SCHEDULING_POLICY_NORMAL, /**< Time shared, the default.*/
+    PAL_SCHEDULING_POLICY_REALTIME_FIFO, /**< Runs until it blocks.*/
+    PAL_SCHEDULING_POLICY_REALTIME_RR    /**< FIFO with time slices.*/
+} PalSchedulingPolicy;
+
+/**
+ * @struct PalThreadScheduling
+ * @brief Scheduling policy and level of a thread.
+ *
+ * For `PAL_SCHEDULING_POLICY_NORMAL`, `level` goes from -2 (lowest) to 2
+ * (highest) and 0 is the default. For the realtime policies, `level` goes
+ * from 1 (lowest) to 99 (highest) and is clamped to the platform range.
+ * `level` is ignored for `PAL_SCHEDULING_POLICY_IDLE`.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ */
+typedef struct {
+    PalSchedulingPolicy policy;
+    Int32 level;
+    const char* mmcssTask; /**< Windows MMCSS task name. Can be nullptr.*/
+} PalThreadScheduling;
+
+/**
+ * @struct PalThreadStats
+ * @brief CPU time and context switches of a thread.
+ *
+ * Context switches are voluntary when the thread blocked or yielded and
+ * involuntary when the scheduler preempted it. Platforms that only count the
+ * total set `voluntarySwitches` and `involuntarySwitches` to 0.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ */
+typedef struct {
+    Uint64 userTime;            /**< CPU time in user mode in nanoseconds.*/
+    Uint64 kernelTime;          /**< CPU time in the kernel in nanoseconds.*/
+    Uint64 contextSwitches;     /**< Total context switches.*/
+    Uint64 voluntarySwitches;   /**< Switches the thread asked for.*/
+    Uint64 involuntarySwitches; /**< Switches from preemption.*/
+    Int32 cpu; /**< Logical processor the thread last ran on or -1.*/
+} PalThreadStats;
+
+/**
+ * @enum PalCpuDomain
+ * @brief Groups of logical processors that share a hardware resource. This is
+ * not a bitmask enum.
+ *
+ * All CPU domain types follow the format `PAL_CPU_DOMAIN_**` for
+ * consistency and API use.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ */
+typedef enum {
+    PAL_CPU_DOMAIN_PROCESSOR, /**< One logical processor.*/
+    PAL_CPU_DOMAIN_CORE,      /**< A physical core and its SMT siblings.*/
+    PAL_CPU_DOMAIN_CACHE_L2,  /**< Processors sharing an L2 cache.*/
+    PAL_CPU_DOMAIN_CACHE_L3,  /**< Processors sharing an L3 cache.*/
+    PAL_CPU_DOMAIN_NUMA_NODE, /**< Processors close to the same memory.*/
+    PAL_CPU_DOMAIN_PACKAGE    /**< Processors in the same socket.*/
+} PalCpuDomain;
+
+/**
+ * @struct PalCpuSet
+ * @brief A set of logical processors.
+ *
+ * Bit `i` of the set is the logical processor with index `i`, see
+ * PalLogicalProcessor. Sets hold up to `PAL_MAX_CPU_SET_SIZE` processors and
+ * can span Windows processor groups. Zero initialize for an empty set.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ */
+typedef struct {
+    Uint64 bits[PAL_MAX_CPU_SET_SIZE / 64];
+} PalCpuSet;
+
+/**
+ * @struct PalLogicalProcessor
+ * @brief Topology of a logical processor.
+ *
+ * Core, cache and package fields are indices starting from 0, processors
+ * with the same index share that resource. The NUMA node is the node number
+ * used by the platform (OS).
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ */
+typedef struct {
+    Uint32 index;    /**< Bit of this processor in a PalCpuSet.*/
+    Uint32 core;     /**< Physical core.*/
+    Uint32 cacheL2;  /**< L2 cache. Same as core if not reported.*/
+    Uint32 cacheL3;  /**< L3 cache. Same as package if not reported.*/
+    Uint32 numaNode; /**< NUMA node. 0 on systems without NUMA.*/
+    Uint32 package;  /**< Physical package (socket).*/
+} PalLogicalProcessor;
+
 /**
  * @struct PalThreadCreateInfo
  * @brief Creation parameters for a thread.
@@ -143,8 +365,120 @@ typedef struct {
     const PalAllocator* allocator; /**< Set to nullptr to use default.*/
     PalThreadFn entry;             /**< Thread entry function*/
     void* arg; /**< Optional user-provided data. Can be nullptr.*/
+    Uint64 stackCommit; /**< Stack committed before entry. 0 for none.*/
+    Uint64 guardSize;   /**< Overflow guard size. 0 for default.*/
+    void* stack; /**< Caller-owned stack of `stackSize` bytes or nullptr.*/
 } PalThreadCreateInfo;
 
+/**
+ * @struct PalFiberCreateInfo
+ * @brief Creation parameters for a fiber.
+ *
+ * Uninitialized fields may result in undefined behavior.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ */
+typedef struct {
+    Uint64 stackSize;              /**< Set to 0 to use default (256 KiB).*/
+    const PalAllocator* allocator; /**< Set to nullptr to use default.*/
+    PalFiberFn entry;              /**< Fiber entry function*/
+    void* arg; /**< Optional user-provided data. Can be nullptr.*/
+} PalFiberCreateInfo;
+
+/**
+ * @struct PalMutexCreateInfo
+ * @brief Creation parameters for a mutex.
+ *
+ * Uninitialized fields may result in undefined behavior.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ */
+typedef struct {
+    const PalAllocator* allocator; /**< Set to nullptr to use default.*/
+    Uint32 spinCount; /**< Max spins before blocking. 0 for default.*/
+    bool adaptive;    /**< Adapt the spins to recent lock hold times.*/
+    bool enableStats; /**< Record PalMutexStats for palGetMutexStats().*/
+} PalMutexCreateInfo;
+
+/**
+ * @struct PalMutexStats
+ * @brief Contention counters of a mutex.
+ *
+ * Only acquisitions through palLockMutex() are counted. `waitTicks` uses the
+ * palGetPerformanceCounter() clock, see palGetPerformanceFrequency().
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ */
+typedef struct {
+    Uint64 acquisitions; /**< Times the mutex was locked.*/
+    Uint64 contentions;  /**< Locks that found the mutex already held.*/
+    Uint64 waitTicks;    /**< Contended lock time in performance ticks.*/
+} PalMutexStats;
+
+/**
+ * @struct PalMutexStorage
+ * @brief Caller-owned memory for a mutex initialized in place.
+ *
+ * Embed it in your own structs and pass it to palInitMutex() to get a mutex
+ * without an allocation or a pointer chase on the lock path. The contents
+ * are private.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ */
+typedef struct {
+    Uint64 opaque[6];
+} PalMutexStorage;
+
+/**
+ * @struct PalCondVarStorage
+ * @brief Caller-owned memory for a condition variable initialized in place.
+ *
+ * See PalMutexStorage. The contents are private.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ */
+typedef struct {
+    Uint64 opaque[2];
+} PalCondVarStorage;
+
+/**
+ * @enum PalRingBufferType
+ * @brief Who may push to and pop from a ring buffer. This is not a bitmask
+ * enum.
+ *
+ * All ring buffer types follow the format `PAL_RING_BUFFER_**` for
+ * consistency and API use.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ */
+typedef enum {
+    PAL_RING_BUFFER_SPSC, /**< One producer and one consumer thread.*/
+    PAL_RING_BUFFER_MPMC  /**< Any number of producers and consumers.*/
+} PalRingBufferType;
+
+/**
+ * @struct PalRingBufferCreateInfo
+ * @brief Creation parameters for a ring buffer.
+ *
+ * Uninitialized fields may result in undefined behavior.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ */
+typedef struct {
+    const PalAllocator* allocator; /**< Set to nullptr to use default.*/
+    PalRingBufferType type;
+    Uint32 capacity;    /**< Rounded up to a power of two.*/
+    Uint32 elementSize; /**< Size of one element in bytes.*/
+    bool blocking; /**< Allow palPushRingBuffer() and palPopRingBuffer().*/
+} PalRingBufferCreateInfo;
+
 /**
  * @brief Create a new thread.
  *
@@ -156,6 +490,23 @@ typedef struct {
  * The created thread starts executing from the entry function. The thread runs
  * until the entry function has finished executing or its detached.
  *
+ * `stackSize` is the address space reserved for the stack. Pages are only
+ * backed by memory once the stack grows into them, `stackCommit` bytes are
+ * touched before the entry function runs so the thread does not fault them
+ * in later. On Windows the size is passed with
+ * `STACK_SIZE_PARAM_IS_A_RESERVATION`.
+ *
+ * `guardSize` is the inaccessible region below the stack on Linux. On
+ * Windows it is the stack kept for handling an overflow, see
+ * `SetThreadStackGuarantee()`.
+ *
+ * If `stack` is not nullptr, `PAL_THREAD_FEATURE_CUSTOM_STACK` must be
+ * supported. The thread runs on `stackSize` bytes at `stack`, which must be
+ * 16 byte aligned, so short lived threads can take stacks from a pool
+ * instead of mapping new ones. `guardSize` is ignored, protect a guard
+ * region in the pool if needed. The memory must not be reused until the
+ * thread is joined.
+ *
  * @param[in] info Pointer to a PalThreadCreateInfo struct that specifies
  * paramters. Must not be nullptr.
  * @param[out] outThread Pointer to a PalThread to recieve the created
@@ -179,20 +530,53 @@ PAL_API PalResult PAL_CALL palCreateThread(
 /**
  * @brief Wait for the provided thread to finish executing.
  *
+ * The value returned by the thread entry function is kept in full, it is
+ * not truncated to a 32 bit exit code on any platform.
+ *
  * @param[in] thread Pointer to the thread.
- * @param[out] retval Optionally pointer to get the threads exit value.
+ * @param[out] outRetval Optional pointer to recieve the value returned by
+ * the thread entry function. Can be nullptr.
  *
  * @return `PAL_RESULT_SUCCESS` on success or a result code on
  * failure. Call palFormatResult() for more information.
  *
- * Thread safety: This function is thread safe if `retval` is thread local.
+ * Thread safety: This function is thread safe if `outRetval` is thread local.
  *
  * @since 1.0
  * @ingroup pal_thread
+ * @sa palJoinThreadTimeout
  */
 PAL_API PalResult PAL_CALL palJoinThread(
     PalThread* thread,
-    void* retval);
+    void** outRetval);
+
+/**
+ * @brief Wait at most the provided time for a thread to finish executing.
+ *
+ * Use this to bound how long shutdown waits on a thread that might be
+ * stuck. On timeout the thread keeps running and can be joined again or
+ * detached.
+ *
+ * @param[in] thread Pointer to the thread.
+ * @param[in] milliseconds Maximum time to wait. `PAL_WAIT_INFINITE` waits
+ * like palJoinThread().
+ * @param[out] outRetval Optional pointer to recieve the value returned by
+ * the thread entry function. Can be nullptr.
+ *
+ * @return `PAL_RESULT_SUCCESS` if the thread finished, `PAL_RESULT_TIMEOUT`
+ * if it was still running when the time ran out or a result code on
+ * failure. Call palFormatResult() for more information.
+ *
+ * Thread safety: This function is thread safe if `outRetval` is thread local.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palJoinThread
+ */
+PAL_API PalResult PAL_CALL palJoinThreadTimeout(
+    PalThread* thread,
+    Uint64 milliseconds,
+    void** outRetval);
 
 /**
  * @brief Release the thread's resources and destroy it.
@@ -222,6 +606,47 @@ PAL_API void PAL_CALL palDetachThread(PalThread* thread);
  */
 PAL_API void PAL_CALL palSleep(Uint64 milliseconds);
 
+/**
+ * @brief Suspend the calling thread for the provided duration of
+ * nanoseconds.
+ *
+ * Unlike palSleep(), this is not rounded to the OS scheduler tick where the
+ * platform has high resolution timers: `clock_nanosleep()` on Linux and high
+ * resolution waitable timers on Windows 10 1803 and later. The thread still
+ * wakes up a little late, by the timer slack and scheduling latency. Use
+ * palPreciseSleepUntil() to hit a deadline.
+ *
+ * @param[in] nanoseconds Number of nanoseconds to sleep.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palPreciseSleepUntil
+ */
+PAL_API void PAL_CALL palSleepNanoseconds(Uint64 nanoseconds);
+
+/**
+ * @brief Suspend the calling thread until a performance counter value.
+ *
+ * Sleeps with palSleepNanoseconds() while the deadline is far, then spins on
+ * palGetPerformanceCounter() for the rest. The spin window follows how late
+ * recent sleeps woke up, so it is a few hundred microseconds with high
+ * resolution timers and longer without. This is meant for frame pacing,
+ * where waking early or late both show as stutter.
+ *
+ * If the deadline has passed, this returns right away.
+ *
+ * @param[in] counter Deadline in palGetPerformanceCounter() units.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palSleepNanoseconds
+ */
+PAL_API void PAL_CALL palPreciseSleepUntil(Uint64 counter);
+
 /**
  * @brief Yield the remainder of the calling threads time sliced,
  * allowing other threads of equal priority to run.
@@ -348,6 +773,100 @@ PAL_API PalResult PAL_CALL palSetThreadPriority(
     PalThread* thread,
     PalThreadPriority priority);
 
+/**
+ * @brief Get the scheduling policy and level of the provided thread.
+ *
+ * `PAL_THREAD_FEATURE_PRIORITY` must be supported. `mmcssTask` is set to
+ * nullptr.
+ *
+ * @param[in] thread The thread to query.
+ * @param[out] outScheduling Pointer to a PalThreadScheduling to recieve the
+ * scheduling.
+ *
+ * @return `PAL_RESULT_SUCCESS` on success or a result code on
+ * failure. Call palFormatResult() for more information.
+ *
+ * Thread safety: This function is thread safe if `outScheduling` is thread
+ * local.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palSetThreadScheduling
+ */
+PAL_API PalResult PAL_CALL palGetThreadScheduling(
+    PalThread* thread,
+    PalThreadScheduling* outScheduling);
+
+/**
+ * @brief Set the scheduling policy and level of the provided thread.
+ *
+ * `PAL_THREAD_FEATURE_PRIORITY` must be supported. This is a finer version
+ * of palSetThreadPriority() for threads that must run on time, such as audio
+ * mixing and input, or must stay out of the way, such as background
+ * decompression.
+ *
+ * On Linux the policies map to `SCHED_IDLE`, `SCHED_OTHER` with nice values
+ * 10 to -10, `SCHED_FIFO` and `SCHED_RR`. On Windows they map to
+ * `THREAD_PRIORITY_IDLE`, `THREAD_PRIORITY_LOWEST` to
+ * `THREAD_PRIORITY_HIGHEST` and `THREAD_PRIORITY_TIME_CRITICAL` for both
+ * realtime policies.
+ *
+ * On Windows, if a realtime policy is set and `mmcssTask` is not nullptr, the
+ * thread also joins that Multimedia Class Scheduler Service task, such as
+ * "Pro Audio" or "Games". MMCSS only registers the calling thread, so
+ * `thread` must be the calling thread in that case. Leaving the realtime
+ * policies leaves the task. `mmcssTask` is ignored on other platforms.
+ *
+ * Realtime policies and raising the level usually need privileges, such as
+ * `CAP_SYS_NICE` or a raised `RLIMIT_RTPRIO` on Linux. Without them this
+ * fails with `PAL_RESULT_ACCESS_DENIED`. On Linux an unprivileged thread
+ * can not leave `PAL_SCHEDULING_POLICY_IDLE` either.
+ *
+ * @param[in] thread The thread to set scheduling for.
+ * @param[in] scheduling Pointer to a PalThreadScheduling. Must not be
+ * nullptr.
+ *
+ * @return `PAL_RESULT_SUCCESS` on success or a result code on
+ * failure. Call palFormatResult() for more information.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palGetThreadScheduling
+ */
+PAL_API PalResult PAL_CALL palSetThreadScheduling(
+    PalThread* thread,
+    const PalThreadScheduling* scheduling);
+
+/**
+ * @brief Get the CPU time and context switches of the provided thread.
+ *
+ * The values are totals since the thread started, so sample them twice and
+ * subtract to measure an interval. A thread that is often preempted while
+ * others are waiting is a sign of more workers than processors.
+ *
+ * On Linux this reads `/proc/self/task/<tid>/stat` and `status`. CPU time
+ * has the resolution of the kernel clock tick, usually 10 milliseconds. On
+ * Windows this uses `GetThreadTimes()` and takes the total context switches
+ * from a snapshot of the system process list, which is expensive. `cpu` is
+ * only known for the calling thread on Windows.
+ *
+ * @param[in] thread The thread to query.
+ * @param[out] outStats Pointer to a PalThreadStats to recieve the stats.
+ *
+ * @return `PAL_RESULT_SUCCESS` on success or a result code on
+ * failure. Call palFormatResult() for more information.
+ *
+ * Thread safety: This function is thread safe if `outStats` is thread local.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ */
+PAL_API PalResult PAL_CALL palGetThreadStats(
+    PalThread* thread,
+    PalThreadStats* outStats);
+
 /**
  * @brief Set the affinity of the provided thread.
  *
@@ -378,28 +897,206 @@ PAL_API PalResult PAL_CALL palSetThreadAffinity(
     Uint64 mask);
 
 /**
- * @brief Set the name of the provided thread.
- *
- * `PAL_THREAD_FEATURE_NAME` must be supported.
- * The thread name will be visible in debuggers and the Task Manager (Windows).
+ * @brief Add a logical processor to a CPU set.
  *
- * @param[in] thread The thread
- * @param[in] name UTF-8 null terminated string.
+ * @param[in] set Pointer to the CPU set. Must not be nullptr.
+ * @param[in] index Index of the logical processor. Must be less than
+ * `PAL_MAX_CPU_SET_SIZE`.
  *
- * @return `PAL_RESULT_SUCCESS` on success or a result code on
- * failure. Call palFormatResult() for more information.
+ * Thread safety: This function is thread safe if `set` is thread local.
  *
- * Thread safety: This function is thread safe.
+ * @since 1.1
+ * @ingroup pal_thread
+ */
+static inline void palAddCpuToSet(
+    PalCpuSet* set,
+    Uint32 index)
+{
+    set->bits[index / 64] |= 1ull << (index % 64);
+}
+
+/**
+ * @brief Remove a logical processor from a CPU set.
  *
- * @note On Linux: Thread names are limited to 16 characters including the null
- * terminator.
+ * @param[in] set Pointer to the CPU set. Must not be nullptr.
+ * @param[in] index Index of the logical processor. Must be less than
+ * `PAL_MAX_CPU_SET_SIZE`.
  *
- * @note On MacOS: Thread names are limited to 64 characters including the null
- * terminator.
+ * Thread safety: This function is thread safe if `set` is thread local.
  *
- * @since 1.0
+ * @since 1.1
  * @ingroup pal_thread
- * @sa palGetThreadName
+ */
+static inline void palRemoveCpuFromSet(
+    PalCpuSet* set,
+    Uint32 index)
+{
+    set->bits[index / 64] &= ~(1ull << (index % 64));
+}
+
+/**
+ * @brief Check if a logical processor is in a CPU set.
+ *
+ * @param[in] set Pointer to the CPU set. Must not be nullptr.
+ * @param[in] index Index of the logical processor. Must be less than
+ * `PAL_MAX_CPU_SET_SIZE`.
+ *
+ * @return True if the processor is in the set, otherwise false.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ */
+static inline bool palIsCpuInSet(
+    const PalCpuSet* set,
+    Uint32 index)
+{
+    return (set->bits[index / 64] >> (index % 64)) & 1;
+}
+
+/**
+ * @brief Return the topology of every logical processor.
+ *
+ * Call this function first with PalLogicalProcessor array set to nullptr to
+ * get the number of logical processors. Allocate memory for the
+ * PalLogicalProcessor array and passed in the count and the allocated array.
+ * If the count of the array is less than the number of logical processors,
+ * PAL will write upto that limit. Processors are ordered by index.
+ *
+ * Unlike palGetCPUInfo(), this reports which processors share a core, cache,
+ * NUMA node or package, and sees every Windows processor group. It reads
+ * sysfs on Linux and GetLogicalProcessorInformationEx() on Windows.
+ *
+ * @param[in] allocator Optional user provided allocator. Set to nullptr to
+ * use default.
+ * @param[in] count Capacity of the PalLogicalProcessor array.
+ * @param[out] processors User allocated array of PalLogicalProcessor.
+ *
+ * @return `PAL_RESULT_SUCCESS` on success or a result code on
+ * failure. Call palFormatResult() for more information.
+ *
+ * Thread safety: This function is thread safe if the provided allocator is
+ * thread safe. The default allocator is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palEnumerateCpuDomains
+ */
+PAL_API PalResult PAL_CALL palEnumerateLogicalProcessors(
+    const PalAllocator* allocator,
+    Int32* count,
+    PalLogicalProcessor* processors);
+
+/**
+ * @brief Return one CPU set per instance of a CPU domain.
+ *
+ * Set `i` holds the logical processors whose domain index is `i`. With
+ * `PAL_CPU_DOMAIN_CORE`, pinning thread `i` to set `i` runs one thread per
+ * physical core. With `PAL_CPU_DOMAIN_NUMA_NODE`, set `n` is NUMA node `n`.
+ * Processor and NUMA node sets can be empty for indices the platform (OS)
+ * skips.
+ *
+ * Call this function first with PalCpuSet array set to nullptr to get the
+ * number of domains. Allocate memory for the PalCpuSet array and passed in
+ * the count and the allocated array. If the count of the array is less than
+ * the number of domains, PAL will write upto that limit.
+ *
+ * @param[in] allocator Optional user provided allocator. Set to nullptr to
+ * use default.
+ * @param[in] domain The domain to group processors by.
+ * @param[in] count Capacity of the PalCpuSet array.
+ * @param[out] sets User allocated array of PalCpuSet.
+ *
+ * @return `PAL_RESULT_SUCCESS` on success or a result code on
+ * failure. Call palFormatResult() for more information.
+ *
+ * Thread safety: This function is thread safe if the provided allocator is
+ * thread safe. The default allocator is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palEnumerateLogicalProcessors
+ * @sa palSetThreadCpuSet
+ */
+PAL_API PalResult PAL_CALL palEnumerateCpuDomains(
+    const PalAllocator* allocator,
+    PalCpuDomain domain,
+    Int32* count,
+    PalCpuSet* sets);
+
+/**
+ * @brief Get the CPU set the provided thread is allowed to run on.
+ *
+ * `PAL_THREAD_FEATURE_AFFINITY` must be supported. Unlike
+ * palGetThreadAffinity(), this is not limited to 64 logical processors.
+ *
+ * @param[in] thread The thread to query.
+ * @param[out] outSet Pointer to a PalCpuSet to recieve the CPU set.
+ *
+ * @return `PAL_RESULT_SUCCESS` on success or a result code on
+ * failure. Call palFormatResult() for more information.
+ *
+ * Thread safety: This function is thread safe if `outSet` is thread local.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palSetThreadCpuSet
+ */
+PAL_API PalResult PAL_CALL palGetThreadCpuSet(
+    PalThread* thread,
+    PalCpuSet* outSet);
+
+/**
+ * @brief Restrict the provided thread to a CPU set.
+ *
+ * `PAL_THREAD_FEATURE_AFFINITY` must be supported. Unlike
+ * palSetThreadAffinity(), this is not limited to 64 logical processors.
+ *
+ * On Windows a thread runs in one processor group, so every processor in
+ * the set must be in the same group, otherwise this fails with
+ * `PAL_RESULT_INVALID_ARGUMENT`. Sets from palEnumerateCpuDomains() for cores
+ * and caches always are.
+ *
+ * @param[in] thread The thread to restrict.
+ * @param[in] set Pointer to the CPU set. Must not be empty.
+ *
+ * @return `PAL_RESULT_SUCCESS` on success or a result code on
+ * failure. Call palFormatResult() for more information.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palEnumerateCpuDomains
+ */
+PAL_API PalResult PAL_CALL palSetThreadCpuSet(
+    PalThread* thread,
+    const PalCpuSet* set);
+
+/**
+ * @brief Set the name of the provided thread.
+ *
+ * `PAL_THREAD_FEATURE_NAME` must be supported.
+ * The thread name will be visible in debuggers and the Task Manager (Windows).
+ *
+ * @param[in] thread The thread
+ * @param[in] name UTF-8 null terminated string.
+ *
+ * @return `PAL_RESULT_SUCCESS` on success or a result code on
+ * failure. Call palFormatResult() for more information.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @note On Linux: Thread names are limited to 16 characters including the null
+ * terminator.
+ *
+ * @note On MacOS: Thread names are limited to 64 characters including the null
+ * terminator.
+ *
+ * @since 1.0
+ * @ingroup pal_thread
+ * @sa palGetThreadName
  */
 PAL_API PalResult PAL_CALL palSetThreadName(
     PalThread* thread,
@@ -470,184 +1167,1314 @@ PAL_API void PAL_CALL palSetTLS(
     void* data);
 
 /**
- * @brief Create a mutex.
+ * @brief Create a new TLS slot.
  *
- * @param[in] allocator Optional user-provided allocator. Set to nullptr to use
- * default.
- * @param[out] outMutex Pointer to a PalMutex to recieve the created mutex.
- * Must not be nullptr.
+ * TLS slots are the fast path for thread local values. Each thread owns a
+ * block of `PAL_MAX_TLS_SLOTS` values in compiler thread local storage, so
+ * reading or writing a slot is one thread local lookup and an array index
+ * instead of a call into the operating system like palGetTLS().
  *
- * @return `PAL_RESULT_SUCCESS` on success or a result code on
- * failure. Call palFormatResult() for more information.
+ * When a thread exits, the destructor is called for every slot that has a
+ * non nullptr value on that thread. Destructors run in reverse creation
+ * order, so a slot created after another can still use it in its destructor.
+ * Destroying a slot does not call its destructor.
  *
- * Thread safety: This function is thread safe if the provided allocator is
- * thread safe and `outMutex` is thread local.
+ * @param[in] destructor Pointer to the slot destructor function. Can be
+ * nullptr.
  *
- * @since 1.0
+ * @return The slot on success or 0 on failure. This fails when
+ * `PAL_MAX_TLS_SLOTS` slots already exist.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
  * @ingroup pal_thread
- * @sa palDestroyMutex
+ * @sa palDestroyTLSSlot
  */
-PAL_API PalResult PAL_CALL palCreateMutex(
-    const PalAllocator* allocator,
-    PalMutex** outMutex);
+PAL_API PalTLSSlot PAL_CALL palCreateTLSSlot(PaTlsDestructorFn destructor);
 
 /**
- * @brief Destroy a mutex
+ * @brief Destroy the provided TLS slot.
  *
- * If `mutex` is invalid, this function returns silently.
- * The mutex must be unlocked before destroying if it was locked.
+ * The values threads stored in the slot are dropped without calling the
+ * destructor. The slot can be handed out again by palCreateTLSSlot().
  *
- * @param[in] mutex Pointer to the mutex.
+ * @param[in] slot The slot to destroy.
  *
- * Thread safety: This function is thread safe if the allocator used to create
- * the mutex is thread safe and `mutex` is thread local.
+ * Thread safety: This function is thread safe.
  *
- * @since 1.0
+ * @since 1.1
  * @ingroup pal_thread
- * @sa palCreateMutex
+ * @sa palCreateTLSSlot
  */
-PAL_API void PAL_CALL palDestroyMutex(PalMutex* mutex);
+PAL_API void PAL_CALL palDestroyTLSSlot(PalTLSSlot slot);
 
 /**
- * @brief Lock a mutex. Blocks if the mutex is already locked by another thread.
+ * @brief Get the value of the provided TLS slot on the calling thread.
  *
- * @param[in] mutex Pointer to the mutex to lock.
+ * @param[in] slot The slot to query value.
+ *
+ * @return The value on success or nullptr if the slot is invalid or has no
+ * value on the calling thread.
  *
  * Thread safety: This function is thread safe.
  *
- * @since 1.0
+ * @since 1.1
  * @ingroup pal_thread
- * @sa palUnlockMutex
+ * @sa palSetTLSSlot
  */
-PAL_API void PAL_CALL palLockMutex(PalMutex* mutex);
+PAL_API void* PAL_CALL palGetTLSSlot(PalTLSSlot slot);
 
 /**
- * @brief Unlock a mutex.
- *
- * The function must be called by the thread that first locked the mutex.
+ * @brief Set the value of the provided TLS slot on the calling thread.
  *
- * @param[in] mutex Pointer to the mutex to unlock.
+ * @param[in] slot The slot to set value to.
+ * @param[in] data The value to set for the calling thread.
  *
  * Thread safety: This function is thread safe.
  *
- * @since 1.0
+ * @since 1.1
  * @ingroup pal_thread
- * @sa palLockMutex
+ * @sa palGetTLSSlot
  */
-PAL_API void PAL_CALL palUnlockMutex(PalMutex* mutex);
+PAL_API void PAL_CALL palSetTLSSlot(
+    PalTLSSlot slot,
+    void* data);
 
 /**
- * @brief Create a condition variable.
+ * @brief Turn the calling thread into a fiber.
+ *
+ * Fibers are cooperatively scheduled execution contexts with their own
+ * stack. A thread runs one fiber at a time and only switches when
+ * palSwitchToFiber() is called, so a job system can park a waiting job on
+ * its fiber and run another one without blocking the thread.
+ *
+ * A thread must be converted before it can switch to other fibers. The
+ * returned fiber represents the thread's own stack, switch to it to return
+ * to the code that converted the thread.
  *
  * @param[in] allocator Optional user-provided allocator. Set to nullptr to use
  * default.
- * @param[out] outCondVar Pointer to a PalCondVar to recieve the created
- * condition variable.
+ * @param[out] outFiber Pointer to a PalFiber to recieve the fiber of the
+ * calling thread. Must not be nullptr.
  *
  * @return `PAL_RESULT_SUCCESS` on success or a result code on
- * failure. Call palFormatResult() for more information.
+ * failure. Call palFormatResult() for more information. This fails with
+ * `PAL_RESULT_INVALID_THREAD` if the thread is already a fiber.
  *
  * Thread safety: This function is thread safe if the provided allocator is
- * thread safe and `outCondVar` is thread local.
+ * thread safe and `outFiber` is thread local.
  *
- * @since 1.0
+ * @since 1.1
  * @ingroup pal_thread
- * @sa palDestroyCondVar
+ * @sa palConvertFiberToThread
  */
-PAL_API PalResult PAL_CALL palCreateCondVar(
+PAL_API PalResult PAL_CALL palConvertThreadToFiber(
     const PalAllocator* allocator,
-    PalCondVar** outCondVar);
+    PalFiber** outFiber);
 
 /**
- * @brief Destroy a condition variable.
+ * @brief Turn the calling thread back from a fiber into a thread.
  *
- * If the condition variable is invalid, this function returns silently.
- * Threads must not wait on the condition variable or undefined
- * behaviour.
+ * Must be called on the fiber returned by palConvertThreadToFiber(), which
+ * is freed. Other fibers created on the thread are not destroyed.
  *
- * @param[in] condVar Pointer to the condition to destroy
+ * @return `PAL_RESULT_SUCCESS` on success or a result code on
+ * failure. Call palFormatResult() for more information. This fails with
+ * `PAL_RESULT_INVALID_THREAD` if the calling thread is not running that
+ * fiber.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palConvertThreadToFiber
+ */
+PAL_API PalResult PAL_CALL palConvertFiberToThread();
+
+/**
+ * @brief Create a new fiber.
+ *
+ * The fiber does not run until a thread switches to it with
+ * palSwitchToFiber(). When the entry function returns, the fiber is
+ * finished and control goes back to the fiber that last switched to it. A
+ * finished fiber must not be switched to again.
+ *
+ * On Linux the stack is mapped with a guard page below it and the switch
+ * saves only the callee saved registers on x86-64, other architectures use
+ * `ucontext`. On Windows this uses `CreateFiberEx()` with `stackSize` as
+ * the reservation.
+ *
+ * The allocator field in the provided PalFiberCreateInfo struct will not be
+ * copied, therefore the pointer must remain valid until the fiber is
+ * destroyed.
+ *
+ * @param[in] info Pointer to a PalFiberCreateInfo struct that specifies
+ * paramters. Must not be nullptr.
+ * @param[out] outFiber Pointer to a PalFiber to recieve the created fiber.
+ * Must not be nullptr.
+ *
+ * @return `PAL_RESULT_SUCCESS` on success or a result code on
+ * failure. Call palFormatResult() for more information.
+ *
+ * Thread safety: This function is thread safe if the provided allocator is
+ * thread safe and `outFiber` is thread local.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palDestroyFiber
+ */
+PAL_API PalResult PAL_CALL palCreateFiber(
+    const PalFiberCreateInfo* info,
+    PalFiber** outFiber);
+
+/**
+ * @brief Destroy a fiber.
+ *
+ * If `fiber` is invalid, this function returns silently. The fiber must not
+ * be running and must not be the fiber of a converted thread, use
+ * palConvertFiberToThread() for those. Objects on the stack of an
+ * unfinished fiber are not cleaned up.
+ *
+ * @param[in] fiber Pointer to the fiber.
  *
  * Thread safety: This function is thread safe if the allocator used to create
- * the condition varibale is thread safe and `condVar` is thread local.
+ * the fiber is thread safe and `fiber` is thread local.
  *
- * @since 1.0
+ * @since 1.1
  * @ingroup pal_thread
- * @sa palCreateCondVar
+ * @sa palCreateFiber
  */
-PAL_API void PAL_CALL palDestroyCondVar(PalCondVar* condVar);
+PAL_API void PAL_CALL palDestroyFiber(PalFiber* fiber);
 
 /**
- * @brief Unlock the provided mutex and wait on the condition variable.
+ * @brief Suspend the current fiber and run the provided one.
  *
- * The mutex must be locked before this call. Spurious wakeups may occur, its
- * best to use a loop. This waits until the condition varibale is signaled.
+ * The calling thread must be a fiber. The call returns when another fiber
+ * switches back to the current one, which can happen on a different thread.
+ * `fiber` must not be running on any thread.
+ *
+ * @param[in] fiber Pointer to the fiber to run.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palGetCurrentFiber
+ */
+PAL_API void PAL_CALL palSwitchToFiber(PalFiber* fiber);
+
+/**
+ * @brief Get the fiber running on the calling thread.
+ *
+ * @return The current fiber or nullptr if the thread was not converted with
+ * palConvertThreadToFiber().
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palSwitchToFiber
+ */
+PAL_API PalFiber* PAL_CALL palGetCurrentFiber();
+
+/**
+ * @brief Block until the value at an address changes or is woken.
+ *
+ * If the value at `address` does not equal the value at `compareAddress`,
+ * this returns immediately. Otherwise the thread sleeps until another thread
+ * calls palWakeByAddressSingle() or palWakeByAddressAll() with the same
+ * address or the timeout is up. The comparison and going to sleep are
+ * atomic with respect to wakes, so a wake after the value was changed is
+ * never lost.
+ *
+ * Spurious wakeups may occur, its best to recheck the value in a loop. The
+ * value is a 32 bit word on all platforms since that is what the Linux futex
+ * supports, so `size` must be 4 and `address` 4 byte aligned.
  *
  * Example:
  *
  * @code
- * while (!ready) { palWaitCondVar(condition, mutex); }
+ * while (palAtomicLoad32(&flag, PAL_MEMORY_ORDER_ACQUIRE) == 0) {
+ *     Int32 zero = 0;
+ *     palWaitOnAddress(&flag, &zero, sizeof(Int32), PAL_WAIT_INFINITE);
+ * }
  * @endcode
  *
- * @param[in] condVar Pointer to the condition variable.
- * @param[in] mutex Pointer to the mutex.
+ * @param[in] address Pointer to the value to wait on.
+ * @param[in] compareAddress Pointer to the value to sleep on.
+ * @param[in] size Size of the value in bytes. Must be 4.
+ * @param[in] milliseconds Timeout in milliseconds or `PAL_WAIT_INFINITE`.
+ *
+ * @return `PAL_RESULT_SUCCESS` when woken or the value differs,
+ * `PAL_RESULT_TIMEOUT` if the time to wait is up, otherwise a result code on
+ * failure. Call palFormatResult() for more information.
  *
  * Thread safety: This function is thread safe.
  *
- * @since 1.0
+ * @since 1.1
  * @ingroup pal_thread
- * @sa palWaitCondVarTimeout
+ * @sa palWakeByAddressSingle
+ * @sa palWakeByAddressAll
  */
-PAL_API PalResult PAL_CALL palWaitCondVar(
-    PalCondVar* condVar,
-    PalMutex* mutex);
+PAL_API PalResult PAL_CALL palWaitOnAddress(
+    volatile void* address,
+    const void* compareAddress,
+    Uint32 size,
+    Uint64 milliseconds);
 
 /**
- * @brief Unlock the provided mutex and wait on the condition variable.
+ * @brief Wake one thread waiting on an address.
  *
- * The mutex must be locked before this call. Spurious wakeups may occur, its
- * best to use a loop. If the condition variable is not signaled but the time to
- * wait is up `PAL_RESULT_TIMEOUT` is returned.
+ * Does nothing if no thread is waiting. The value should be changed before
+ * waking, otherwise the woken thread may go back to sleep.
  *
- * @param[in] condVar Pointer to the condition variable.
- * @param[in] mutex Pointer to the mutex.
- * @param[in] milliseconds Timeout in milliseconds.
+ * @param[in] address The address passed to palWaitOnAddress().
  *
  * Thread safety: This function is thread safe.
  *
- * @since 1.0
+ * @since 1.1
  * @ingroup pal_thread
- * @sa palWaitCondVar
+ * @sa palWaitOnAddress
  */
-PAL_API PalResult PAL_CALL palWaitCondVarTimeout(
-    PalCondVar* condVar,
-    PalMutex* mutex,
-    Uint64 milliseconds);
+PAL_API void PAL_CALL palWakeByAddressSingle(volatile void* address);
 
 /**
- * @brief Wake a single thread waiting on the condition variable.
+ * @brief Wake all threads waiting on an address.
  *
- * @param[in] condVar Pointer to the condition variable.
+ * @param[in] address The address passed to palWaitOnAddress().
  *
  * Thread safety: This function is thread safe.
  *
- * @since 1.0
+ * @since 1.1
  * @ingroup pal_thread
- * @sa palBroadcastCondVar
+ * @sa palWaitOnAddress
  */
-PAL_API void PAL_CALL palSignalCondVar(PalCondVar* condVar);
+PAL_API void PAL_CALL palWakeByAddressAll(volatile void* address);
 
 /**
- * @brief Wake all threads waiting on the condition variable.
+ * @brief Create a mutex.
  *
- * @param[in] condVar Pointer to the condition variable.
+ * @param[in] allocator Optional user-provided allocator. Set to nullptr to use
+ * default.
+ * @param[out] outMutex Pointer to a PalMutex to recieve the created mutex.
+ * Must not be nullptr.
  *
- * Thread safety: This function is thread safe.
+ * @return `PAL_RESULT_SUCCESS` on success or a result code on
+ * failure. Call palFormatResult() for more information.
  *
- * @since 1.0.
+ * Thread safety: This function is thread safe if the provided allocator is
+ * thread safe and `outMutex` is thread local.
+ *
+ * @since 1.0
  * @ingroup pal_thread
- * @sa palSignalCondVar
+ * @sa palDestroyMutex
  */
-PAL_API void PAL_CALL palBroadcastCondVar(PalCondVar* condVar);
+PAL_API PalResult PAL_CALL palCreateMutex(
+    const PalAllocator* allocator,
+    PalMutex** outMutex);
+
+/**
+ * @brief Create a mutex with a spin budget and optional statistics.
+ *
+ * A contended lock spins up to `spinCount` times before it blocks in the OS.
+ * If `adaptive` is true, the budget follows how long recent contended locks
+ * had to spin, capped at `spinCount`, so short critical sections spin and
+ * long ones block early.
+ *
+ * If `enableStats` is true, the mutex counts acquisitions, contended
+ * acquisitions and the time spent waiting. The counters are updated while
+ * the mutex is held, which adds a performance counter read to contended
+ * locks only.
+ *
+ * The allocator field in the provided PalMutexCreateInfo struct will not
+ * be copied, therefore the pointer must remain valid until the mutex is
+ * destroyed.
+ *
+ * @param[in] info Pointer to a PalMutexCreateInfo struct that specifies
+ * paramters. Must not be nullptr.
+ * @param[out] outMutex Pointer to a PalMutex to recieve the created mutex.
+ * Must not be nullptr.
+ *
+ * @return `PAL_RESULT_SUCCESS` on success or a result code on
+ * failure. Call palFormatResult() for more information.
+ *
+ * Thread safety: This function is thread safe if the provided allocator is
+ * thread safe and `outMutex` is thread local.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palCreateMutex
+ * @sa palGetMutexStats
+ */
+PAL_API PalResult PAL_CALL palCreateMutexEx(
+    const PalMutexCreateInfo* info,
+    PalMutex** outMutex);
+
+/**
+ * @brief Destroy a mutex
+ *
+ * If `mutex` is invalid, this function returns silently.
+ * The mutex must be unlocked before destroying if it was locked.
+ *
+ * @param[in] mutex Pointer to the mutex.
+ *
+ * Thread safety: This function is thread safe if the allocator used to create
+ * the mutex is thread safe and `mutex` is thread local.
+ *
+ * @since 1.0
+ * @ingroup pal_thread
+ * @sa palCreateMutex
+ */
+PAL_API void PAL_CALL palDestroyMutex(PalMutex* mutex);
+
+/**
+ * @brief Initialize a mutex in caller-owned storage.
+ *
+ * The mutex behaves like one from palCreateMutexEx() but lives inside
+ * `storage`, so no memory is allocated. The returned handle is the address
+ * of `storage`, which must stay valid and must not move until
+ * palDeinitMutex() is called. The allocator field of `info` is ignored.
+ *
+ * @param[in] storage Pointer to the storage. Must not be nullptr.
+ * @param[in] info Optional pointer to a PalMutexCreateInfo struct. Set to
+ * nullptr for defaults.
+ * @param[out] outMutex Pointer to a PalMutex to recieve the mutex handle.
+ * Must not be nullptr.
+ *
+ * @return `PAL_RESULT_SUCCESS` on success or a result code on
+ * failure. Call palFormatResult() for more information.
+ *
+ * Thread safety: This function is thread safe if `storage` and `outMutex`
+ * are thread local.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palDeinitMutex
+ */
+PAL_API PalResult PAL_CALL palInitMutex(
+    PalMutexStorage* storage,
+    const PalMutexCreateInfo* info,
+    PalMutex** outMutex);
+
+/**
+ * @brief Deinitialize a mutex created with palInitMutex().
+ *
+ * If `mutex` is invalid, this function returns silently.
+ * The mutex must not be locked. Do not call palDestroyMutex() on it.
+ *
+ * @param[in] mutex Pointer to the mutex.
+ *
+ * Thread safety: This function is thread safe if `mutex` is thread local.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palInitMutex
+ */
+PAL_API void PAL_CALL palDeinitMutex(PalMutex* mutex);
+
+/**
+ * @brief Lock a mutex. Blocks until the mutex is acquired.
+ *
+ * The mutex is not recursive. Locking it again from the owning thread
+ * deadlocks.
+ *
+ * @param[in] mutex Pointer to the mutex to lock.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.0
+ * @ingroup pal_thread
+ * @sa palUnlockMutex
+ */
+PAL_API void PAL_CALL palLockMutex(PalMutex* mutex);
+
+/**
+ * @brief Try to lock a mutex without blocking.
+ *
+ * If the mutex is held by any thread, including the calling one, this returns
+ * false immediately. Like palLockMutex(), the mutex is not recursive.
+ *
+ * @param[in] mutex Pointer to the mutex to lock.
+ *
+ * @return True if the mutex was locked, otherwise false.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palLockMutexTimeout
+ * @sa palUnlockMutex
+ */
+PAL_API bool PAL_CALL palTryLockMutex(PalMutex* mutex);
+
+/**
+ * @brief Lock a mutex, giving up after a timeout.
+ *
+ * If the mutex could not be locked before the time to wait is up
+ * `PAL_RESULT_TIMEOUT` is returned and the mutex is not held. A timeout of
+ * zero behaves like palTryLockMutex().
+ *
+ * @param[in] mutex Pointer to the mutex to lock.
+ * @param[in] milliseconds Timeout in milliseconds.
+ *
+ * @return `PAL_RESULT_SUCCESS` on success or a result code on
+ * failure. Call palFormatResult() for more information.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palTryLockMutex
+ * @sa palUnlockMutex
+ */
+PAL_API PalResult PAL_CALL palLockMutexTimeout(
+    PalMutex* mutex,
+    Uint64 milliseconds);
+
+/**
+ * @brief Unlock a mutex.
+ *
+ * The function must be called by the thread that first locked the mutex.
+ *
+ * @param[in] mutex Pointer to the mutex to unlock.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.0
+ * @ingroup pal_thread
+ * @sa palLockMutex
+ */
+PAL_API void PAL_CALL palUnlockMutex(PalMutex* mutex);
+
+/**
+ * @brief Get the contention counters of a mutex.
+ *
+ * The mutex must have been created with palCreateMutexEx() and
+ * `enableStats` set to true. The mutex is locked briefly to read a
+ * consistent set of counters, so the calling thread must not hold it.
+ *
+ * @param[in] mutex Pointer to the mutex.
+ * @param[out] outStats Pointer to a PalMutexStats to recieve the counters.
+ * Must not be nullptr.
+ *
+ * @return `PAL_RESULT_SUCCESS` on success or a result code on
+ * failure. Call palFormatResult() for more information.
+ *
+ * Thread safety: This function is thread safe if `outStats` is thread local.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palCreateMutexEx
+ */
+PAL_API PalResult PAL_CALL palGetMutexStats(
+    PalMutex* mutex,
+    PalMutexStats* outStats);
+
+/**
+ * @brief Create a condition variable.
+ *
+ * @param[in] allocator Optional user-provided allocator. Set to nullptr to use
+ * default.
+ * @param[out] outCondVar Pointer to a PalCondVar to recieve the created
+ * condition variable.
+ *
+ * @return `PAL_RESULT_SUCCESS` on success or a result code on
+ * failure. Call palFormatResult() for more information.
+ *
+ * Thread safety: This function is thread safe if the provided allocator is
+ * thread safe and `outCondVar` is thread local.
+ *
+ * @since 1.0
+ * @ingroup pal_thread
+ * @sa palDestroyCondVar
+ */
+PAL_API PalResult PAL_CALL palCreateCondVar(
+    const PalAllocator* allocator,
+    PalCondVar** outCondVar);
+
+/**
+ * @brief Destroy a condition variable.
+ *
+ * If the condition variable is invalid, this function returns silently.
+ * Threads must not wait on the condition variable or undefined
+ * behaviour.
+ *
+ * @param[in] condVar Pointer to the condition to destroy
+ *
+ * Thread safety: This function is thread safe if the allocator used to create
+ * the condition varibale is thread safe and `condVar` is thread local.
+ *
+ * @since 1.0
+ * @ingroup pal_thread
+ * @sa palCreateCondVar
+ */
+PAL_API void PAL_CALL palDestroyCondVar(PalCondVar* condVar);
+
+/**
+ * @brief Initialize a condition variable in caller-owned storage.
+ *
+ * The returned handle is the address of `storage`, which must stay valid and
+ * must not move until palDeinitCondVar() is called.
+ *
+ * @param[in] storage Pointer to the storage. Must not be nullptr.
+ * @param[out] outCondVar Pointer to a PalCondVar to recieve the condition
+ * variable handle. Must not be nullptr.
+ *
+ * @return `PAL_RESULT_SUCCESS` on success or a result code on
+ * failure. Call palFormatResult() for more information.
+ *
+ * Thread safety: This function is thread safe if `storage` and `outCondVar`
+ * are thread local.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palDeinitCondVar
+ */
+PAL_API PalResult PAL_CALL palInitCondVar(
+    PalCondVarStorage* storage,
+    PalCondVar** outCondVar);
+
+/**
+ * @brief Deinitialize a condition variable created with palInitCondVar().
+ *
+ * If `condVar` is invalid, this function returns silently.
+ * No thread must be waiting on it. Do not call palDestroyCondVar() on it.
+ *
+ * @param[in] condVar Pointer to the condition variable.
+ *
+ * Thread safety: This function is thread safe if `condVar` is thread local.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palInitCondVar
+ */
+PAL_API void PAL_CALL palDeinitCondVar(PalCondVar* condVar);
+
+/**
+ * @brief Unlock the provided mutex and wait on the condition variable.
+ *
+ * The mutex must be locked before this call. Spurious wakeups may occur, its
+ * best to use a loop. This waits until the condition varibale is signaled.
+ *
+ * Example:
+ *
+ * @code
+ * while (!ready) { palWaitCondVar(condition, mutex); }
+ * @endcode
+ *
+ * @param[in] condVar Pointer to the condition variable.
+ * @param[in] mutex Pointer to the mutex.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.0
+ * @ingroup pal_thread
+ * @sa palWaitCondVarTimeout
+ */
+PAL_API PalResult PAL_CALL palWaitCondVar(
+    PalCondVar* condVar,
+    PalMutex* mutex);
+
+/**
+ * @brief Unlock the provided mutex and wait on the condition variable.
+ *
+ * The mutex must be locked before this call. Spurious wakeups may occur, its
+ * best to use a loop. If the condition variable is not signaled but the time to
+ * wait is up `PAL_RESULT_TIMEOUT` is returned.
+ *
+ * @param[in] condVar Pointer to the condition variable.
+ * @param[in] mutex Pointer to the mutex.
+ * @param[in] milliseconds Timeout in milliseconds.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.0
+ * @ingroup pal_thread
+ * @sa palWaitCondVar
+ */
+PAL_API PalResult PAL_CALL palWaitCondVarTimeout(
+    PalCondVar* condVar,
+    PalMutex* mutex,
+    Uint64 milliseconds);
+
+/**
+ * @brief Wake a single thread waiting on the condition variable.
+ *
+ * @param[in] condVar Pointer to the condition variable.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.0
+ * @ingroup pal_thread
+ * @sa palBroadcastCondVar
+ */
+PAL_API void PAL_CALL palSignalCondVar(PalCondVar* condVar);
+
+/**
+ * @brief Wake all threads waiting on the condition variable.
+ *
+ * @param[in] condVar Pointer to the condition variable.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.0.
+ * @ingroup pal_thread
+ * @sa palSignalCondVar
+ */
+PAL_API void PAL_CALL palBroadcastCondVar(PalCondVar* condVar);
+
+/**
+ * @brief Create a reader-writer lock.
+ *
+ * Any number of threads can hold the lock shared, or a single thread can hold
+ * it exclusive. Writers are preferred: once a writer is waiting, new readers
+ * wait until it has acquired and released the lock. The lock is not
+ * recursive, a thread holding it shared must not lock it shared again while a
+ * writer could be waiting.
+ *
+ * @param[in] allocator Optional user-provided allocator. Set to nullptr to use
+ * default.
+ * @param[out] outLock Pointer to a PalRWLock to recieve the created lock.
+ * Must not be nullptr.
+ *
+ * @return `PAL_RESULT_SUCCESS` on success or a result code on
+ * failure. Call palFormatResult() for more information.
+ *
+ * Thread safety: This function is thread safe if the provided allocator is
+ * thread safe and `outLock` is thread local.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palDestroyRWLock
+ */
+PAL_API PalResult PAL_CALL palCreateRWLock(
+    const PalAllocator* allocator,
+    PalRWLock** outLock);
+
+/**
+ * @brief Destroy a reader-writer lock.
+ *
+ * If `lock` is invalid, this function returns silently.
+ * The lock must not be held when destroyed.
+ *
+ * @param[in] lock Pointer to the lock.
+ *
+ * Thread safety: This function is thread safe if the allocator used to create
+ * the lock is thread safe and `lock` is thread local.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palCreateRWLock
+ */
+PAL_API void PAL_CALL palDestroyRWLock(PalRWLock* lock);
+
+/**
+ * @brief Lock a reader-writer lock for reading.
+ *
+ * Blocks while the lock is held exclusive or a writer is waiting.
+ *
+ * @param[in] lock Pointer to the lock.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palUnlockRWLockShared
+ */
+PAL_API void PAL_CALL palLockRWLockShared(PalRWLock* lock);
+
+/**
+ * @brief Try to lock a reader-writer lock for reading without blocking.
+ *
+ * @param[in] lock Pointer to the lock.
+ *
+ * @return True if the lock was acquired, otherwise false.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palLockRWLockShared
+ */
+PAL_API bool PAL_CALL palTryLockRWLockShared(PalRWLock* lock);
+
+/**
+ * @brief Release a shared hold on a reader-writer lock.
+ *
+ * @param[in] lock Pointer to the lock.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palLockRWLockShared
+ */
+PAL_API void PAL_CALL palUnlockRWLockShared(PalRWLock* lock);
+
+/**
+ * @brief Lock a reader-writer lock for writing.
+ *
+ * Blocks while the lock is held by readers or another writer.
+ *
+ * @param[in] lock Pointer to the lock.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palUnlockRWLockExclusive
+ */
+PAL_API void PAL_CALL palLockRWLockExclusive(PalRWLock* lock);
+
+/**
+ * @brief Try to lock a reader-writer lock for writing without blocking.
+ *
+ * @param[in] lock Pointer to the lock.
+ *
+ * @return True if the lock was acquired, otherwise false.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palLockRWLockExclusive
+ */
+PAL_API bool PAL_CALL palTryLockRWLockExclusive(PalRWLock* lock);
+
+/**
+ * @brief Release an exclusive hold on a reader-writer lock.
+ *
+ * The function must be called by the thread that locked the lock exclusive.
+ *
+ * @param[in] lock Pointer to the lock.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palLockRWLockExclusive
+ */
+PAL_API void PAL_CALL palUnlockRWLockExclusive(PalRWLock* lock);
+
+/**
+ * @brief Create a counting semaphore.
+ *
+ * Waiting decrements the count, blocking while it is zero. Posting
+ * increments it and wakes as many waiters as it added. Waits and posts that
+ * do not need to block or wake a thread do not enter the OS.
+ *
+ * @param[in] allocator Optional user-provided allocator. Set to nullptr to use
+ * default.
+ * @param[in] initialCount The initial count. Must not exceed `INT32_MAX`.
+ * @param[out] outSemaphore Pointer to a PalSemaphore to recieve the created
+ * semaphore. Must not be nullptr.
+ *
+ * @return `PAL_RESULT_SUCCESS` on success or a result code on
+ * failure. Call palFormatResult() for more information.
+ *
+ * Thread safety: This function is thread safe if the provided allocator is
+ * thread safe and `outSemaphore` is thread local.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palDestroySemaphore
+ */
+PAL_API PalResult PAL_CALL palCreateSemaphore(
+    const PalAllocator* allocator,
+    Uint32 initialCount,
+    PalSemaphore** outSemaphore);
+
+/**
+ * @brief Destroy a semaphore.
+ *
+ * If `semaphore` is invalid, this function returns silently.
+ * No thread must be waiting on the semaphore when destroyed.
+ *
+ * @param[in] semaphore Pointer to the semaphore.
+ *
+ * Thread safety: This function is thread safe if the allocator used to create
+ * the semaphore is thread safe and `semaphore` is thread local.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palCreateSemaphore
+ */
+PAL_API void PAL_CALL palDestroySemaphore(PalSemaphore* semaphore);
+
+/**
+ * @brief Decrement a semaphore, waiting while its count is zero.
+ *
+ * @param[in] semaphore Pointer to the semaphore.
+ *
+ * @return `PAL_RESULT_SUCCESS` on success or a result code on
+ * failure. Call palFormatResult() for more information.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palWaitSemaphoreTimeout
+ * @sa palPostSemaphore
+ */
+PAL_API PalResult PAL_CALL palWaitSemaphore(PalSemaphore* semaphore);
+
+/**
+ * @brief Decrement a semaphore, waiting at most the provided time.
+ *
+ * If the count stays zero until the time to wait is up `PAL_RESULT_TIMEOUT`
+ * is returned and the count is not changed. A timeout of zero only checks
+ * the count.
+ *
+ * @param[in] semaphore Pointer to the semaphore.
+ * @param[in] milliseconds Timeout in milliseconds.
+ *
+ * @return `PAL_RESULT_SUCCESS` on success or a result code on
+ * failure. Call palFormatResult() for more information.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palWaitSemaphore
+ */
+PAL_API PalResult PAL_CALL palWaitSemaphoreTimeout(
+    PalSemaphore* semaphore,
+    Uint64 milliseconds);
+
+/**
+ * @brief Increment a semaphore and wake waiting threads.
+ *
+ * @param[in] semaphore Pointer to the semaphore.
+ * @param[in] count The amount to add. Must be greater than zero.
+ *
+ * @return `PAL_RESULT_SUCCESS` on success or a result code on
+ * failure. Call palFormatResult() for more information.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palWaitSemaphore
+ */
+PAL_API PalResult PAL_CALL palPostSemaphore(
+    PalSemaphore* semaphore,
+    Uint32 count);
+
+/**
+ * @brief Create a synchronization event.
+ *
+ * An event is either signaled or not. Waiting on a signaled event returns
+ * immediately. A manual reset event stays signaled and releases every
+ * waiter until palResetSyncEvent() is called. An auto reset event releases
+ * a single waiter and goes back to not signaled. Setting an already signaled
+ * event does nothing.
+ *
+ * @param[in] allocator Optional user-provided allocator. Set to nullptr to use
+ * default.
+ * @param[in] manualReset True for a manual reset event, false for auto reset.
+ * @param[in] signaled The initial state of the event.
+ * @param[out] outEvent Pointer to a PalSyncEvent to recieve the created event.
+ * Must not be nullptr.
+ *
+ * @return `PAL_RESULT_SUCCESS` on success or a result code on
+ * failure. Call palFormatResult() for more information.
+ *
+ * Thread safety: This function is thread safe if the provided allocator is
+ * thread safe and `outEvent` is thread local.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palDestroySyncEvent
+ */
+PAL_API PalResult PAL_CALL palCreateSyncEvent(
+    const PalAllocator* allocator,
+    bool manualReset,
+    bool signaled,
+    PalSyncEvent** outEvent);
+
+/**
+ * @brief Destroy a synchronization event.
+ *
+ * If `event` is invalid, this function returns silently.
+ * No thread must be waiting on the event when destroyed.
+ *
+ * @param[in] event Pointer to the event.
+ *
+ * Thread safety: This function is thread safe if the allocator used to create
+ * the event is thread safe and `event` is thread local.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palCreateSyncEvent
+ */
+PAL_API void PAL_CALL palDestroySyncEvent(PalSyncEvent* event);
+
+/**
+ * @brief Signal an event.
+ *
+ * @param[in] event Pointer to the event.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palResetSyncEvent
+ */
+PAL_API void PAL_CALL palSetSyncEvent(PalSyncEvent* event);
+
+/**
+ * @brief Set an event back to not signaled.
+ *
+ * @param[in] event Pointer to the event.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palSetSyncEvent
+ */
+PAL_API void PAL_CALL palResetSyncEvent(PalSyncEvent* event);
+
+/**
+ * @brief Wait until an event is signaled.
+ *
+ * @param[in] event Pointer to the event.
+ *
+ * @return `PAL_RESULT_SUCCESS` on success or a result code on
+ * failure. Call palFormatResult() for more information.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palWaitSyncEventTimeout
+ */
+PAL_API PalResult PAL_CALL palWaitSyncEvent(PalSyncEvent* event);
+
+/**
+ * @brief Wait until an event is signaled or the timeout is up.
+ *
+ * If the event is not signaled before the time to wait is up
+ * `PAL_RESULT_TIMEOUT` is returned.
+ *
+ * @param[in] event Pointer to the event.
+ * @param[in] milliseconds Timeout in milliseconds.
+ *
+ * @return `PAL_RESULT_SUCCESS` on success or a result code on
+ * failure. Call palFormatResult() for more information.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palWaitSyncEvent
+ */
+PAL_API PalResult PAL_CALL palWaitSyncEventTimeout(
+    PalSyncEvent* event,
+    Uint64 milliseconds);
+
+/**
+ * @brief Create a reusable thread barrier.
+ *
+ * The barrier blocks threads calling palWaitBarrier() until `count` threads
+ * have arrived, then releases all of them and resets for the next phase.
+ * Waiting threads spin briefly before they block, so phases that finish
+ * close together do not enter the OS.
+ *
+ * @param[in] allocator Optional user-provided allocator. Set to nullptr to use
+ * default.
+ * @param[in] count Number of threads per phase. Must be greater than zero.
+ * @param[out] outBarrier Pointer to a PalBarrier to recieve the created
+ * barrier. Must not be nullptr.
+ *
+ * @return `PAL_RESULT_SUCCESS` on success or a result code on
+ * failure. Call palFormatResult() for more information.
+ *
+ * Thread safety: This function is thread safe if the provided allocator is
+ * thread safe and `outBarrier` is thread local.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palDestroyBarrier
+ */
+PAL_API PalResult PAL_CALL palCreateBarrier(
+    const PalAllocator* allocator,
+    Uint32 count,
+    PalBarrier** outBarrier);
+
+/**
+ * @brief Destroy a barrier.
+ *
+ * If `barrier` is invalid, this function returns silently.
+ * No thread must be waiting on the barrier when destroyed.
+ *
+ * @param[in] barrier Pointer to the barrier.
+ *
+ * Thread safety: This function is thread safe if the allocator used to create
+ * the barrier is thread safe and `barrier` is thread local.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palCreateBarrier
+ */
+PAL_API void PAL_CALL palDestroyBarrier(PalBarrier* barrier);
+
+/**
+ * @brief Wait until all threads of the current phase reached the barrier.
+ *
+ * Exactly one thread per phase, the last to arrive, gets true. It can be
+ * used to run serial work between phases.
+ *
+ * @param[in] barrier Pointer to the barrier.
+ *
+ * @return True for the last thread to arrive, otherwise false.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palCreateBarrier
+ */
+PAL_API bool PAL_CALL palWaitBarrier(PalBarrier* barrier);
+
+/**
+ * @brief Create a one-shot countdown latch.
+ *
+ * The latch opens once its count reaches zero and stays open. Unlike a
+ * barrier, the threads counting down do not have to wait.
+ *
+ * @param[in] allocator Optional user-provided allocator. Set to nullptr to use
+ * default.
+ * @param[in] count The initial count. Must not exceed `INT32_MAX`.
+ * @param[out] outLatch Pointer to a PalLatch to recieve the created latch.
+ * Must not be nullptr.
+ *
+ * @return `PAL_RESULT_SUCCESS` on success or a result code on
+ * failure. Call palFormatResult() for more information.
+ *
+ * Thread safety: This function is thread safe if the provided allocator is
+ * thread safe and `outLatch` is thread local.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palDestroyLatch
+ */
+PAL_API PalResult PAL_CALL palCreateLatch(
+    const PalAllocator* allocator,
+    Uint32 count,
+    PalLatch** outLatch);
+
+/**
+ * @brief Destroy a latch.
+ *
+ * If `latch` is invalid, this function returns silently.
+ * No thread must be waiting on the latch when destroyed.
+ *
+ * @param[in] latch Pointer to the latch.
+ *
+ * Thread safety: This function is thread safe if the allocator used to create
+ * the latch is thread safe and `latch` is thread local.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palCreateLatch
+ */
+PAL_API void PAL_CALL palDestroyLatch(PalLatch* latch);
+
+/**
+ * @brief Decrement the count of a latch.
+ *
+ * Waiting threads are released when the count reaches zero. The count must
+ * not be decremented below zero.
+ *
+ * @param[in] latch Pointer to the latch.
+ * @param[in] count The amount to subtract.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palWaitLatch
+ */
+PAL_API void PAL_CALL palCountDownLatch(
+    PalLatch* latch,
+    Uint32 count);
+
+/**
+ * @brief Check if a latch is open without blocking.
+ *
+ * @param[in] latch Pointer to the latch.
+ *
+ * @return True if the count reached zero, otherwise false.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palWaitLatch
+ */
+PAL_API bool PAL_CALL palTryWaitLatch(PalLatch* latch);
+
+/**
+ * @brief Wait until the count of a latch reaches zero.
+ *
+ * @param[in] latch Pointer to the latch.
+ *
+ * Thread safety: This function is thread safe.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palCountDownLatch
+ */
+PAL_API void PAL_CALL palWaitLatch(PalLatch* latch);
+
+/**
+ * @brief Create a bounded ring buffer.
+ *
+ * Elements are copied in and out, so any element size works. The indices
+ * of producers and consumers live on their own cache lines.
+ * `PAL_RING_BUFFER_SPSC` is a Lamport queue where each side keeps a cached
+ * copy of the other side's index and only reads the shared one when the
+ * cache says the buffer is full or empty. `PAL_RING_BUFFER_MPMC` gives
+ * every cell a sequence number, so producers and consumers only contend on
+ * their own index.
+ *
+ * If `blocking` is true, palPushRingBuffer() and palPopRingBuffer() can wait
+ * for space or elements on a PalCondVar. The non blocking calls then also
+ * check for waiting threads after every push or pop, which costs a memory
+ * fence.
+ *
+ * The allocator field in the provided PalRingBufferCreateInfo struct will
+ * not be copied, therefore the pointer must remain valid until the ring
+ * buffer is destroyed.
+ *
+ * @param[in] info Pointer to a PalRingBufferCreateInfo struct that specifies
+ * paramters. Must not be nullptr.
+ * @param[out] outRingBuffer Pointer to a PalRingBuffer to recieve the created
+ * ring buffer. Must not be nullptr.
+ *
+ * @return `PAL_RESULT_SUCCESS` on success or a result code on
+ * failure. Call palFormatResult() for more information.
+ *
+ * Thread safety: This function is thread safe if the provided allocator is
+ * thread safe and `outRingBuffer` is thread local.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palDestroyRingBuffer
+ */
+PAL_API PalResult PAL_CALL palCreateRingBuffer(
+    const PalRingBufferCreateInfo* info,
+    PalRingBuffer** outRingBuffer);
+
+/**
+ * @brief Destroy a ring buffer.
+ *
+ * If `ringBuffer` is invalid, this function returns silently.
+ * No thread must be using the ring buffer when destroyed. Elements still in
+ * it are dropped.
+ *
+ * @param[in] ringBuffer Pointer to the ring buffer.
+ *
+ * Thread safety: This function is thread safe if the allocator used to create
+ * the ring buffer is thread safe and `ringBuffer` is thread local.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palCreateRingBuffer
+ */
+PAL_API void PAL_CALL palDestroyRingBuffer(PalRingBuffer* ringBuffer);
+
+/**
+ * @brief Copy an element into a ring buffer without blocking.
+ *
+ * @param[in] ringBuffer Pointer to the ring buffer.
+ * @param[in] element Pointer to `elementSize` bytes to copy.
+ *
+ * @return True if the element was pushed, false if the buffer is full.
+ *
+ * Thread safety: This function is thread safe for producers the ring buffer
+ * type allows.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palTryPopRingBuffer
+ */
+PAL_API bool PAL_CALL palTryPushRingBuffer(
+    PalRingBuffer* ringBuffer,
+    const void* element);
+
+/**
+ * @brief Copy the oldest element out of a ring buffer without blocking.
+ *
+ * @param[in] ringBuffer Pointer to the ring buffer.
+ * @param[out] outElement Pointer to `elementSize` bytes to recieve the
+ * element.
+ *
+ * @return True if an element was popped, false if the buffer is empty.
+ *
+ * Thread safety: This function is thread safe for consumers the ring buffer
+ * type allows.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palTryPushRingBuffer
+ */
+PAL_API bool PAL_CALL palTryPopRingBuffer(
+    PalRingBuffer* ringBuffer,
+    void* outElement);
+
+/**
+ * @brief Copy an element into a ring buffer, waiting for space if full.
+ *
+ * The ring buffer must be created with `blocking` set to true.
+ *
+ * @param[in] ringBuffer Pointer to the ring buffer.
+ * @param[in] element Pointer to `elementSize` bytes to copy.
+ * @param[in] milliseconds Timeout in milliseconds or `PAL_WAIT_INFINITE`.
+ *
+ * @return `PAL_RESULT_SUCCESS` on success, `PAL_RESULT_TIMEOUT` if no space
+ * was freed in time or a result code on failure. Call palFormatResult() for
+ * more information.
+ *
+ * Thread safety: This function is thread safe for producers the ring buffer
+ * type allows.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palPopRingBuffer
+ */
+PAL_API PalResult PAL_CALL palPushRingBuffer(
+    PalRingBuffer* ringBuffer,
+    const void* element,
+    Uint64 milliseconds);
+
+/**
+ * @brief Copy the oldest element out of a ring buffer, waiting if empty.
+ *
+ * The ring buffer must be created with `blocking` set to true.
+ *
+ * @param[in] ringBuffer Pointer to the ring buffer.
+ * @param[out] outElement Pointer to `elementSize` bytes to recieve the
+ * element.
+ * @param[in] milliseconds Timeout in milliseconds or `PAL_WAIT_INFINITE`.
+ *
+ * @return `PAL_RESULT_SUCCESS` on success, `PAL_RESULT_TIMEOUT` if no
+ * element arrived in time or a result code on failure. Call
+ * palFormatResult() for more information.
+ *
+ * Thread safety: This function is thread safe for consumers the ring buffer
+ * type allows.
+ *
+ * @since 1.1
+ * @ingroup pal_thread
+ * @sa palPushRingBuffer
+ */
+PAL_API PalResult PAL_CALL palPopRingBuffer(
+    PalRingBuffer* ringBuffer,
+    void* outElement,
+    Uint64 milliseconds);
 
 /** @} */ // end of pal_thread group
 
@@ -1,35 +1,103 @@
 
 dofile("pal_config.lua")
 
+local logLevels = {
+    trace = 0,
+    debug = 1,
+    info = 2,
+    warn = 3,
+    error = 4,
+    fatal = 5,
+    off = 6
+}
+
+-- modules that have a backend on the target platform
+local platformModules = {
+    windows = {
+        system = true,
+        thread = true,
+        video = true,
+        opengl = true,
+        profiler = true
+    },
+    linux = {
+        thread = true,
+        profiler = true
+    }
+}
+
+local function hasModule(name, enabled)
+    local modules = platformModules[os.target()] or {}
+    return enabled and modules[name] == true
+end
+
+-- modules that will be built. Used by the config header and tests
+PAL_HAS_SYSTEM = hasModule("system", PAL_BUILD_SYSTEM)
+PAL_HAS_THREAD = hasModule("thread", PAL_BUILD_THREAD)
+PAL_HAS_VIDEO = hasModule("video", PAL_BUILD_VIDEO)
+PAL_HAS_OPENGL = hasModule("opengl", PAL_BUILD_OPENGL)
+PAL_HAS_PROFILER = hasModule("profiler", PAL_BUILD_PROFILER)
+
+-- jobs are built on pal_thread and have no backend of their own
+PAL_HAS_JOBS = PAL_BUILD_JOBS and PAL_HAS_THREAD
+
 function writeConfig(path)
     local file = io.open(path, "w")
     file:write("\n// Auto Generated Config Header From pal_config.lua\n")
     file:write("// Must not be edited manually\n\n")
 
-    if (PAL_BUILD_SYSTEM) then
+    if (PAL_HAS_SYSTEM) then
         file:write("#define PAL_HAS_SYSTEM 1\n")
     else
         file:write("#define PAL_HAS_SYSTEM 0\n")
     end
 
-    if (PAL_BUILD_THREAD) then
+    if (PAL_HAS_THREAD) then
         file:write("#define PAL_HAS_THREAD 1\n")
     else
         file:write("#define PAL_HAS_THREAD 0\n")
     end
 
-    if (PAL_BUILD_VIDEO) then
+    if (PAL_HAS_VIDEO) then
         file:write("#define PAL_HAS_VIDEO 1\n")
     else
         file:write("#define PAL_HAS_VIDEO 0\n")
     end
 
-    if (PAL_BUILD_OPENGL) then
+    if (PAL_HAS_OPENGL) then
         file:write("#define PAL_HAS_OPENGL 1\n")
     else
         file:write("#define PAL_HAS_OPENGL 0\n")
     end
-    
+
+    if (PAL_HAS_JOBS) then
+        file:write("#define PAL_HAS_JOBS 1\n")
+    else
+        file:write("#define PAL_HAS_JOBS 0\n")
+    end
+
+    if (PAL_HAS_PROFILER) then
+        file:write("#define PAL_HAS_PROFILER 1\n")
+    else
+        file:write("#define PAL_HAS_PROFILER 0\n")
+    end
+
+    if (PAL_HAS_PROFILER and PAL_PROFILE_INTERNALS) then
+        file:write("#define PAL_PROFILE_INTERNALS 1\n")
+    else
+        file:write("#define PAL_PROFILE_INTERNALS 0\n")
+    end
+
+    local debugLevel = logLevels[PAL_LOG_LEVEL_DEBUG] or 0
+    local releaseLevel = logLevels[PAL_LOG_LEVEL_RELEASE] or 0
+    file:write("\n#ifndef PAL_LOG_LEVEL\n")
+    file:write("#ifdef NDEBUG\n")
+    file:write("#define PAL_LOG_LEVEL " .. releaseLevel .. "\n")
+    file:write("#else\n")
+    file:write("#define PAL_LOG_LEVEL " .. debugLevel .. "\n")
+    file:write("#endif // NDEBUG\n")
+    file:write("#endif // PAL_LOG_LEVEL\n")
+
     file:close()
 end
 
@@ -59,6 +127,10 @@ project "PAL"
         "src/pal_event.c"
     }
 
+    filter {"system:linux", "configurations:*"}
+        links { "pthread" }
+    filter {}
+
     if (PAL_BUILD_SYSTEM) then
         filter {"system:windows", "configurations:*"}
         files { "src/system/pal_system_win32.c" }
@@ -68,9 +140,25 @@ project "PAL"
     if (PAL_BUILD_THREAD) then
         filter {"system:windows", "configurations:*"}
         files { "src/thread/pal_thread_win32.c" }
+        links { "Synchronization" }
+        filter {}
+
+        filter {"system:linux", "configurations:*"}
+        files { "src/thread/pal_thread_linux.c" }
         filter {}
     end
 
+    -- sync primitives, ring buffers, cpu domains and TLS slots are built
+    -- on the backend
+    if (PAL_HAS_THREAD) then
+        files {
+            "src/thread/pal_ring_buffer.c",
+            "src/thread/pal_sync.c",
+            "src/thread/pal_topology.c",
+            "src/thread/pal_tls.c"
+        }
+    end
+
     if (PAL_BUILD_VIDEO) then
         filter {"system:windows", "configurations:*"}
         files { "src/video/pal_video_win32.c" }
@@ -83,4 +171,15 @@ project "PAL"
         filter {}
     end
 
+    if (PAL_HAS_JOBS) then
+        files {
+            "src/jobs/pal_jobs.c",
+            "src/jobs/pal_thread_pool.c"
+        }
+    end
+
+    if (PAL_HAS_PROFILER) then
+        files { "src/pal_profiler.c" }
+    end
+
     writeConfig("include/pal/pal_config.h")
\ No newline at end of file
@@ -15,4 +15,20 @@ PAL_BUILD_THREAD = true
 PAL_BUILD_VIDEO = true
 
 -- build opengl module
-PAL_BUILD_OPENGL = true
\ No newline at end of file
+PAL_BUILD_OPENGL = true
+
+-- build jobs module (needs the thread module)
+PAL_BUILD_JOBS = true
+
+-- build profiler module
+PAL_BUILD_PROFILER = true
+
+-- record profiler zones in PAL's own hot paths (needs the profiler module)
+PAL_PROFILE_INTERNALS = false
+
+-- lowest log level kept by the PAL_LOG_* macros in debug builds
+-- one of "trace", "debug", "info", "warn", "error", "fatal", "off"
+PAL_LOG_LEVEL_DEBUG = "trace"
+
+-- lowest log level kept by the PAL_LOG_* macros in release builds
+PAL_LOG_LEVEL_RELEASE = "info"
\ No newline at end of file
@@ -36,6 +36,10 @@ workspace "PAL_workspace"
         systemversion "latest"
         cdialect "C99"
 
+    filter {"system:linux", "configurations:*"}
+        architecture "x64"
+        cdialect "C99"
+
     filter "configurations:Debug"
         symbols "on"
         runtime "Debug"
@@ -44,6 +48,7 @@ workspace "PAL_workspace"
         symbols "off"
         runtime "Release"
         optimize "full"
+        defines { "NDEBUG" }
 
     filter {}
 
@@ -83,9 +88,10 @@ workspace "PAL_workspace"
         }
     end
 
+    -- pal.lua decides which modules the tests can use
+    include "pal.lua"
+
     if (PAL_BUILD_TESTS) then
         include "tests/tests.lua"
     end
-
-    include "pal.lua"
     
\ No newline at end of file
@@ -0,0 +1,551 @@
+
+/**
+
+Copyright (C) 2025 Nicholas Agbo
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+
+ */
+
+// ==================================================
+// Includes
+// ==================================================
+
+#include "pal/pal_atomic.h"
+#include "pal/pal_jobs.h"
+
+#include <string.h>
+
+// ==================================================
+// Typedefs, enums and structs
+// ==================================================
+
+#define PAL_DEFAULT_JOBS_PER_WORKER 4096
+#define PAL_JOB_CACHE_LINE 64
+#define PAL_JOB_SPIN_COUNT 64
+
+struct PalJob {
+    PalJobFn func;
+    void* userData;
+    PalJob* parent;
+    volatile Int32 unfinished; // the job and its unfinished children
+};
+
+// jobs are padded so workers finishing neighbours do not share a cache line
+typedef union {
+    PalJob job;
+    char padding[PAL_JOB_CACHE_LINE];
+} JobSlot;
+
+typedef struct {
+    volatile Int64 top; // thieves take from here
+    char padding0[PAL_JOB_CACHE_LINE - sizeof(Int64)];
+    volatile Int64 bottom; // the owner pushes and pops here
+    char padding1[PAL_JOB_CACHE_LINE - sizeof(Int64)];
+    void* volatile* jobs;
+    JobSlot* arena;
+    Uint64 arenaIndex; // owner only
+    Uint32 random;     // owner only, picks steal victims
+    Int32 index;
+    PalThread* thread;
+    PalJobSystem* system;
+} Worker;
+
+struct PalJobSystem {
+    const PalAllocator* allocator;
+    Worker** workers;
+    Uint32 workerCount;
+    Uint32 mask; // jobs per worker - 1
+    PalTLSId tlsId;
+    PalMutex* mutex;     // points into mutexStorage
+    PalCondVar* condVar; // points into condVarStorage
+    PalMutexStorage mutexStorage;
+    PalCondVarStorage condVarStorage;
+    volatile Int32 queued; // jobs sitting in all deques
+    volatile Int32 sleeping;
+    volatile Int32 running;
+};
+
+// ==================================================
+// Internal API
+// ==================================================
+
+static inline Worker* getWorker(PalJobSystem* system)
+{
+    return (Worker*)palGetTLS(system->tlsId);
+}
+
+static inline Uint32 nextRandom(Worker* worker)
+{
+    // xorshift32
+    Uint32 x = worker->random;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    worker->random = x;
+    return x;
+}
+
+static inline void wakeWorker(PalJobSystem* system)
+{
+    // sequentially consistent, sleeping and queued are a Dekker pair
+    if (palAtomicLoad32(&system->sleeping, PAL_MEMORY_ORDER_SEQ_CST) > 0) {
+        palLockMutex(system->mutex);
+        palSignalCondVar(system->condVar);
+        palUnlockMutex(system->mutex);
+    }
+}
+
+static void finishJob(PalJob* job)
+{
+    // the last child to finish finishes the parent. The parent is read first
+    // since a finished job can be recycled by its creator right away
+    while (job) {
+        PalJob* parent = job->parent;
+        Int32 prev = palAtomicFetchAdd32(
+            &job->unfinished,
+            -1,
+            PAL_MEMORY_ORDER_ACQ_REL);
+
+        if (prev != 1) {
+            break;
+        }
+        job = parent;
+    }
+}
+
+static inline void executeJob(
+    PalJobSystem* system,
+    PalJob* job)
+{
+    job->func(system, job, job->userData);
+    finishJob(job);
+}
+
+static inline bool pushJob(
+    Worker* worker,
+    PalJob* job)
+{
+    Uint32 mask = worker->system->mask;
+    Int64 bottom = palAtomicLoad64(&worker->bottom, PAL_MEMORY_ORDER_RELAXED);
+    Int64 top = palAtomicLoad64(&worker->top, PAL_MEMORY_ORDER_ACQUIRE);
+    if (bottom - top > (Int64)mask) {
+        return false;
+    }
+
+    void* volatile* slot = &worker->jobs[bottom & mask];
+    palAtomicStorePtr(slot, job, PAL_MEMORY_ORDER_RELAXED);
+    palAtomicStore64(&worker->bottom, bottom + 1, PAL_MEMORY_ORDER_RELEASE);
+    return true;
+}
+
+static inline PalJob* popJob(Worker* worker)
+{
+    Uint32 mask = worker->system->mask;
+    Int64 bottom = palAtomicLoad64(&worker->bottom, PAL_MEMORY_ORDER_RELAXED);
+    bottom--;
+    palAtomicStore64(&worker->bottom, bottom, PAL_MEMORY_ORDER_RELAXED);
+    palAtomicThreadFence(PAL_MEMORY_ORDER_SEQ_CST);
+    Int64 top = palAtomicLoad64(&worker->top, PAL_MEMORY_ORDER_RELAXED);
+
+    if (top > bottom) {
+        // empty
+        palAtomicStore64(&worker->bottom, top, PAL_MEMORY_ORDER_RELAXED);
+        return nullptr;
+    }
+
+    void* volatile* slot = &worker->jobs[bottom & mask];
+    PalJob* job = palAtomicLoadPtr(slot, PAL_MEMORY_ORDER_RELAXED);
+    if (top == bottom) {
+        // last job. Race thieves for it
+        if (!palAtomicCompareExchange64(
+                &worker->top,
+                &top,
+                top + 1,
+                PAL_MEMORY_ORDER_SEQ_CST)) {
+            job = nullptr;
+        }
+        palAtomicStore64(&worker->bottom, bottom + 1, PAL_MEMORY_ORDER_RELAXED);
+    }
+    return job;
+}
+
+static inline PalJob* stealJob(Worker* victim)
+{
+    Int64 top = palAtomicLoad64(&victim->top, PAL_MEMORY_ORDER_ACQUIRE);
+    palAtomicThreadFence(PAL_MEMORY_ORDER_SEQ_CST);
+    Int64 bottom = palAtomicLoad64(&victim->bottom, PAL_MEMORY_ORDER_ACQUIRE);
+
+    if (top >= bottom) {
+        return nullptr;
+    }
+
+    void* volatile* slot = &victim->jobs[top & victim->system->mask];
+    PalJob* job = palAtomicLoadPtr(slot, PAL_MEMORY_ORDER_RELAXED);
+    if (!palAtomicCompareExchange64(
+            &victim->top,
+            &top,
+            top + 1,
+            PAL_MEMORY_ORDER_SEQ_CST)) {
+        // lost the race to the owner or another thief
+        return nullptr;
+    }
+    return job;
+}
+
+static PalJob* findJob(Worker* worker)
+{
+    PalJobSystem* system = worker->system;
+    PalJob* job = popJob(worker);
+
+    if (!job && system->workerCount > 1) {
+        Uint32 count = system->workerCount;
+        Uint32 start = nextRandom(worker);
+        for (Uint32 i = 0; i < count && !job; i++) {
+            Worker* victim = system->workers[(start + i) % count];
+            if (victim != worker) {
+                job = stealJob(victim);
+            }
+        }
+    }
+
+    if (job) {
+        palAtomicFetchAdd32(&system->queued, -1, PAL_MEMORY_ORDER_SEQ_CST);
+    }
+    return job;
+}
+
+static void* workerEntry(void* arg)
+{
+    Worker* worker = arg;
+    PalJobSystem* system = worker->system;
+    palSetTLS(system->tlsId, worker);
+
+    Uint32 idle = 0;
+    while (palAtomicLoad32(&system->running, PAL_MEMORY_ORDER_ACQUIRE)) {
+        PalJob* job = findJob(worker);
+        if (job) {
+            executeJob(system, job);
+            idle = 0;
+            continue;
+        }
+
+        if (++idle < PAL_JOB_SPIN_COUNT) {
+            palYield();
+            continue;
+        }
+
+        // nothing to run or steal, sleep until a job is pushed
+        palLockMutex(system->mutex);
+        palAtomicFetchAdd32(&system->sleeping, 1, PAL_MEMORY_ORDER_SEQ_CST);
+        while (system->running &&
+               !palAtomicLoad32(&system->queued, PAL_MEMORY_ORDER_SEQ_CST)) {
+            palWaitCondVar(system->condVar, system->mutex);
+        }
+        palAtomicFetchAdd32(&system->sleeping, -1, PAL_MEMORY_ORDER_RELAXED);
+        palUnlockMutex(system->mutex);
+        idle = 0;
+    }
+
+    return nullptr;
+}
+
+static void freeJobSystem(PalJobSystem* system)
+{
+    // stop and join the workers that were started
+    palAtomicStore32(&system->running, 0, PAL_MEMORY_ORDER_RELEASE);
+    palLockMutex(system->mutex);
+    palBroadcastCondVar(system->condVar);
+    palUnlockMutex(system->mutex);
+
+    // join every worker before freeing, thieves still read other deques
+    for (Uint32 i = 0; i < system->workerCount; i++) {
+        Worker* worker = system->workers[i];
+        if (worker && worker->thread) {
+            palJoinThread(worker->thread, nullptr);
+            palDetachThread(worker->thread);
+        }
+    }
+
+    for (Uint32 i = 0; i < system->workerCount; i++) {
+        palFree(system->allocator, system->workers[i]);
+    }
+
+    // the creating thread is no longer a worker
+    palSetTLS(system->tlsId, nullptr);
+    palDestroyTLS(system->tlsId);
+    palDeinitCondVar(system->condVar);
+    palDeinitMutex(system->mutex);
+    palFree(system->allocator, system->workers);
+    palFree(system->allocator, system);
+}
+
+// ==================================================
+// Public API
+// ==================================================
+
+PalResult PAL_CALL palCreateJobSystem(
+    const PalJobSystemCreateInfo* info,
+    PalJobSystem** outSystem)
+{
+    if (!info || !outSystem) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    if (info->allocator) {
+        if (!info->allocator->allocate || !info->allocator->free) {
+            return PAL_RESULT_INVALID_ALLOCATOR;
+        }
+    }
+
+    if (info->workerCount == 0) {
+        return PAL_RESULT_INVALID_ARGUMENT;
+    }
+
+    Uint32 maxJobs = info->maxJobsPerWorker;
+    if (maxJobs == 0) {
+        maxJobs = PAL_DEFAULT_JOBS_PER_WORKER;
+    }
+
+    // round up to a power of two so ring indices can be masked
+    Uint32 capacity = 1;
+    while (capacity < maxJobs) {
+        capacity <<= 1;
+    }
+
+    PalJobSystem* system;
+    system = palAllocate(info->allocator, sizeof(PalJobSystem), 0);
+    if (!system) {
+        return PAL_RESULT_OUT_OF_MEMORY;
+    }
+
+    memset(system, 0, sizeof(PalJobSystem));
+    system->allocator = info->allocator;
+    system->workerCount = info->workerCount;
+    system->mask = capacity - 1;
+    system->running = 1;
+
+    Uint64 size = sizeof(Worker*) * info->workerCount;
+    system->workers = palAllocate(info->allocator, size, 0);
+    if (!system->workers) {
+        palFree(info->allocator, system);
+        return PAL_RESULT_OUT_OF_MEMORY;
+    }
+    memset(system->workers, 0, size);
+
+    // the idle lock lives in the system block, nothing to allocate
+    palInitMutex(&system->mutexStorage, nullptr, &system->mutex);
+    palInitCondVar(&system->condVarStorage, &system->condVar);
+
+    system->tlsId = palCreateTLS(nullptr);
+    if (!system->tlsId) {
+        palDeinitCondVar(system->condVar);
+        palDeinitMutex(system->mutex);
+        palFree(info->allocator, system->workers);
+        palFree(info->allocator, system);
+        return PAL_RESULT_PLATFORM_FAILURE;
+    }
+
+    // worker, deque and job ring share one cache aligned block
+    const Uint64 align = PAL_JOB_CACHE_LINE - 1;
+    Uint64 workerSize = (sizeof(Worker) + align) & ~align;
+    Uint64 dequeSize = (sizeof(PalJob*) * capacity + align) & ~align;
+    size = workerSize + dequeSize + sizeof(JobSlot) * capacity;
+
+    for (Uint32 i = 0; i < info->workerCount; i++) {
+        Uint8* block;
+        block = palAllocate(info->allocator, size, PAL_JOB_CACHE_LINE);
+        if (!block) {
+            freeJobSystem(system);
+            return PAL_RESULT_OUT_OF_MEMORY;
+        }
+
+        memset(block, 0, size);
+        Worker* worker = (Worker*)block;
+        worker->jobs = (void* volatile*)(block + workerSize);
+        worker->arena = (JobSlot*)(block + workerSize + dequeSize);
+        worker->random = 0x9E3779B9u * (i + 1);
+        worker->index = (Int32)i;
+        worker->system = system;
+        system->workers[i] = worker;
+    }
+
+    // the creating thread is worker 0
+    palSetTLS(system->tlsId, system->workers[0]);
+
+    // one core per worker, SMT siblings share the caches anyway
+    Int32 coreCount = 0;
+    PalCpuSet* cores = nullptr;
+    bool pin = info->pinWorkers;
+    if (!(palGetThreadFeatures() & PAL_THREAD_FEATURE_AFFINITY)) {
+        pin = false;
+    }
+
+    if (pin) {
+        PalResult result = palEnumerateCpuDomains(
+            info->allocator,
+            PAL_CPU_DOMAIN_CORE,
+            &coreCount,
+            nullptr);
+
+        if (result == PAL_RESULT_SUCCESS && coreCount > 0) {
+            size = sizeof(PalCpuSet) * coreCount;
+            cores = palAllocate(info->allocator, size, 0);
+        }
+
+        if (cores) {
+            result = palEnumerateCpuDomains(
+                info->allocator,
+                PAL_CPU_DOMAIN_CORE,
+                &coreCount,
+                cores);
+        }
+
+        // failing to get the topology is not fatal, workers are not pinned
+        if (!cores || result != PAL_RESULT_SUCCESS) {
+            pin = false;
+        }
+    }
+
+    PalThreadCreateInfo createInfo = {0};
+    createInfo.allocator = info->allocator;
+    createInfo.entry = workerEntry;
+    createInfo.stackSize = info->stackSize;
+    for (Uint32 i = 1; i < info->workerCount; i++) {
+        Worker* worker = system->workers[i];
+        createInfo.arg = worker;
+
+        PalResult result = palCreateThread(&createInfo, &worker->thread);
+        if (result != PAL_RESULT_SUCCESS) {
+            worker->thread = nullptr;
+            palFree(info->allocator, cores);
+            freeJobSystem(system);
+            return result;
+        }
+
+        if (pin) {
+            // failing to pin is not fatal, the worker still runs
+            palSetThreadCpuSet(worker->thread, &cores[i % coreCount]);
+        }
+    }
+    palFree(info->allocator, cores);
+
+    *outSystem = system;
+    return PAL_RESULT_SUCCESS;
+}
+
+void PAL_CALL palDestroyJobSystem(PalJobSystem* system)
+{
+    if (system) {
+        freeJobSystem(system);
+    }
+}
+
+PalJob* PAL_CALL palCreateJob(
+    PalJobSystem* system,
+    PalJob* parent,
+    PalJobFn func,
+    void* userData)
+{
+    if (!system || !func) {
+        return nullptr;
+    }
+
+    Worker* worker = getWorker(system);
+    if (!worker) {
+        return nullptr;
+    }
+
+    // jobs are recycled in creation order
+    JobSlot* slot = &worker->arena[worker->arenaIndex & system->mask];
+    PalJob* job = &slot->job;
+    if (palAtomicLoad32(&job->unfinished, PAL_MEMORY_ORDER_ACQUIRE) > 0) {
+        return nullptr;
+    }
+
+    worker->arenaIndex++;
+    job->func = func;
+    job->userData = userData;
+    job->parent = parent;
+    job->unfinished = 1;
+
+    if (parent) {
+        palAtomicFetchAdd32(&parent->unfinished, 1, PAL_MEMORY_ORDER_RELAXED);
+    }
+    return job;
+}
+
+void PAL_CALL palRunJob(
+    PalJobSystem* system,
+    PalJob* job)
+{
+    if (!system || !job) {
+        return;
+    }
+
+    Worker* worker = getWorker(system);
+    if (!worker) {
+        return;
+    }
+
+    // count the job first so a worker that sees it queued never goes to sleep
+    palAtomicFetchAdd32(&system->queued, 1, PAL_MEMORY_ORDER_SEQ_CST);
+    if (!pushJob(worker, job)) {
+        // the deque is full, run it now rather than dropping it
+        palAtomicFetchAdd32(&system->queued, -1, PAL_MEMORY_ORDER_RELAXED);
+        executeJob(system, job);
+        return;
+    }
+    wakeWorker(system);
+}
+
+void PAL_CALL palJobWait(
+    PalJobSystem* system,
+    PalJob* job)
+{
+    if (!system || !job) {
+        return;
+    }
+
+    Worker* worker = getWorker(system);
+    if (!worker) {
+        return;
+    }
+
+    while (palAtomicLoad32(&job->unfinished, PAL_MEMORY_ORDER_ACQUIRE) > 0) {
+        PalJob* next = findJob(worker);
+        if (next) {
+            executeJob(system, next);
+
+        } else {
+            palYield();
+        }
+    }
+}
+
+Int32 PAL_CALL palGetJobWorkerIndex(PalJobSystem* system)
+{
+    if (!system) {
+        return -1;
+    }
+
+    Worker* worker = getWorker(system);
+    if (!worker) {
+        return -1;
+    }
+    return worker->index;
+}
@@ -0,0 +1,495 @@
+
+/**
+
+Copyright (C) 2025 Nicholas Agbo
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+
+ */
+
+// ==================================================
+// Includes
+// ==================================================
+
+#include "pal/pal_atomic.h"
+#include "pal/pal_jobs.h"
+
+#include <string.h>
+
+// ==================================================
+// Typedefs, enums and structs
+// ==================================================
+
+#define PAL_DEFAULT_POOL_CAPACITY 1024
+#define PAL_POOL_CACHE_LINE 64
+#define PAL_POOL_CHUNKS_PER_THREAD 8
+#define PAL_POOL_HELP_INTERVAL 1 // ms between queue checks in palParallelFor
+
+typedef struct {
+    volatile Int32 sequence; // says whether the cell is empty or full
+    PalTaskFn func;
+    void* userData;
+} TaskCell;
+
+struct PalThreadPool {
+    volatile Int32 enqueuePos;
+    char padding0[PAL_POOL_CACHE_LINE - sizeof(Int32)];
+    volatile Int32 dequeuePos;
+    char padding1[PAL_POOL_CACHE_LINE - sizeof(Int32)];
+    volatile Int32 pending; // submitted tasks that have not finished
+    volatile Int32 waiters; // threads in palWaitThreadPool()
+    volatile Int32 running;
+    char padding2[PAL_POOL_CACHE_LINE - sizeof(Int32) * 3];
+    const PalAllocator* allocator;
+    TaskCell* cells;
+    Uint32 mask; // queue capacity - 1
+    Uint32 workerCount;
+    PalSemaphore* tasks; // counts queued tasks, idle workers sleep on it
+    PalThread** threads;
+};
+
+typedef struct {
+    PalParallelForFn func;
+    void* userData;
+    Uint64 count;
+    Uint64 grainSize;
+    volatile Int64 next;    // first index of the next chunk
+    volatile Int32 helpers; // helper tasks still running
+} ParallelFor;
+
+// ==================================================
+// Internal API
+// ==================================================
+
+static bool pushTask(
+    PalThreadPool* pool,
+    PalTaskFn func,
+    void* userData)
+{
+    // bounded MPMC queue, each cell sequence tells producers and consumers
+    // whose turn it is. Positions wrap, so compare them as differences
+    TaskCell* cell;
+    Int32 pos = palAtomicLoad32(&pool->enqueuePos, PAL_MEMORY_ORDER_RELAXED);
+    for (;;) {
+        cell = &pool->cells[(Uint32)pos & pool->mask];
+        Int32 seq;
+        seq = palAtomicLoad32(&cell->sequence, PAL_MEMORY_ORDER_ACQUIRE);
+        Int32 diff = (Int32)((Uint32)seq - (Uint32)pos);
+
+        if (diff == 0) {
+            if (palAtomicCompareExchange32(
+                    &pool->enqueuePos,
+                    &pos,
+                    (Int32)((Uint32)pos + 1),
+                    PAL_MEMORY_ORDER_RELAXED)) {
+                break;
+            }
+
+        } else if (diff < 0) {
+            // the cell still holds a task from the previous lap
+            return false;
+
+        } else {
+            pos = palAtomicLoad32(&pool->enqueuePos, PAL_MEMORY_ORDER_RELAXED);
+        }
+    }
+
+    cell->func = func;
+    cell->userData = userData;
+    palAtomicStore32(
+        &cell->sequence,
+        (Int32)((Uint32)pos + 1),
+        PAL_MEMORY_ORDER_RELEASE);
+
+    return true;
+}
+
+static bool popTask(
+    PalThreadPool* pool,
+    PalTaskFn* outFunc,
+    void** outUserData)
+{
+    TaskCell* cell;
+    Int32 pos = palAtomicLoad32(&pool->dequeuePos, PAL_MEMORY_ORDER_RELAXED);
+    for (;;) {
+        cell = &pool->cells[(Uint32)pos & pool->mask];
+        Int32 seq;
+        seq = palAtomicLoad32(&cell->sequence, PAL_MEMORY_ORDER_ACQUIRE);
+        Int32 diff = (Int32)((Uint32)seq - ((Uint32)pos + 1));
+
+        if (diff == 0) {
+            if (palAtomicCompareExchange32(
+                    &pool->dequeuePos,
+                    &pos,
+                    (Int32)((Uint32)pos + 1),
+                    PAL_MEMORY_ORDER_RELAXED)) {
+                break;
+            }
+
+        } else if (diff < 0) {
+            // empty or the producer has not published the cell yet
+            return false;
+
+        } else {
+            pos = palAtomicLoad32(&pool->dequeuePos, PAL_MEMORY_ORDER_RELAXED);
+        }
+    }
+
+    *outFunc = cell->func;
+    *outUserData = cell->userData;
+
+    // hand the cell to the producer one lap ahead
+    palAtomicStore32(
+        &cell->sequence,
+        (Int32)((Uint32)pos + pool->mask + 1),
+        PAL_MEMORY_ORDER_RELEASE);
+
+    return true;
+}
+
+static inline void finishTask(PalThreadPool* pool)
+{
+    // sequentially consistent, pending and waiters are a Dekker pair
+    Int32 prev;
+    prev = palAtomicFetchAdd32(&pool->pending, -1, PAL_MEMORY_ORDER_SEQ_CST);
+    if (prev == 1 &&
+        palAtomicLoad32(&pool->waiters, PAL_MEMORY_ORDER_SEQ_CST) > 0) {
+        palWakeByAddressAll(&pool->pending);
+    }
+}
+
+static bool queueTask(
+    PalThreadPool* pool,
+    PalTaskFn func,
+    void* userData)
+{
+    palAtomicFetchAdd32(&pool->pending, 1, PAL_MEMORY_ORDER_RELAXED);
+    if (!pushTask(pool, func, userData)) {
+        finishTask(pool);
+        return false;
+    }
+
+    palPostSemaphore(pool->tasks, 1);
+    return true;
+}
+
+static inline bool isQueueEmpty(PalThreadPool* pool)
+{
+    Int32 enqueue;
+    Int32 dequeue;
+    enqueue = palAtomicLoad32(&pool->enqueuePos, PAL_MEMORY_ORDER_ACQUIRE);
+    dequeue = palAtomicLoad32(&pool->dequeuePos, PAL_MEMORY_ORDER_ACQUIRE);
+    return enqueue == dequeue;
+}
+
+static inline bool runQueuedTask(PalThreadPool* pool)
+{
+    PalTaskFn func;
+    void* userData;
+    if (!popTask(pool, &func, &userData)) {
+        return false;
+    }
+
+    func(userData);
+    finishTask(pool);
+    return true;
+}
+
+static void* workerEntry(void* arg)
+{
+    PalThreadPool* pool = arg;
+
+    for (;;) {
+        palWaitSemaphore(pool->tasks);
+        // every post follows a push, but a producer that claimed an earlier
+        // cell can still be publishing it, so retry while the queue is not
+        // empty. An empty queue means a waiting caller ran the task for us
+        while (!runQueuedTask(pool)) {
+            if (!palAtomicLoad32(&pool->running, PAL_MEMORY_ORDER_ACQUIRE)) {
+                return nullptr;
+            }
+
+            if (isQueueEmpty(pool)) {
+                break;
+            }
+            palYield();
+        }
+    }
+}
+
+static void runChunks(ParallelFor* loop)
+{
+    for (;;) {
+        Uint64 begin = (Uint64)palAtomicFetchAdd64(
+            &loop->next,
+            (Int64)loop->grainSize,
+            PAL_MEMORY_ORDER_RELAXED);
+
+        if (begin >= loop->count) {
+            break;
+        }
+
+        Uint64 end = begin + loop->grainSize;
+        if (end > loop->count) {
+            end = loop->count;
+        }
+        loop->func(begin, end, loop->userData);
+    }
+}
+
+static void PAL_CALL parallelForTask(void* userData)
+{
+    ParallelFor* loop = userData;
+    runChunks(loop);
+
+    // the loop lives on the caller stack, do not touch it after this
+    Int32 prev;
+    prev = palAtomicFetchAdd32(&loop->helpers, -1, PAL_MEMORY_ORDER_SEQ_CST);
+    if (prev == 1) {
+        palWakeByAddressAll(&loop->helpers);
+    }
+}
+
+static void freeThreadPool(PalThreadPool* pool)
+{
+    // stop and join the workers that were started. Each exits on the
+    // shutdown post since the queue is empty by now
+    palAtomicStore32(&pool->running, 0, PAL_MEMORY_ORDER_RELEASE);
+    palPostSemaphore(pool->tasks, pool->workerCount);
+
+    for (Uint32 i = 0; i < pool->workerCount; i++) {
+        if (pool->threads[i]) {
+            palJoinThread(pool->threads[i], nullptr);
+            palDetachThread(pool->threads[i]);
+        }
+    }
+
+    palDestroySemaphore(pool->tasks);
+    palFree(pool->allocator, pool->threads);
+    palFree(pool->allocator, pool->cells);
+    palFree(pool->allocator, pool);
+}
+
+// ==================================================
+// Public API
+// ==================================================
+
+PalResult PAL_CALL palCreateThreadPool(
+    const PalThreadPoolCreateInfo* info,
+    PalThreadPool** outPool)
+{
+    if (!info || !outPool) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    if (info->allocator) {
+        if (!info->allocator->allocate || !info->allocator->free) {
+            return PAL_RESULT_INVALID_ALLOCATOR;
+        }
+    }
+
+    if (info->workerCount == 0) {
+        return PAL_RESULT_INVALID_ARGUMENT;
+    }
+
+    Uint32 maxTasks = info->queueCapacity;
+    if (maxTasks == 0) {
+        maxTasks = PAL_DEFAULT_POOL_CAPACITY;
+    }
+
+    // round up to a power of two so positions can be masked
+    Uint32 capacity = 2;
+    while (capacity < maxTasks) {
+        capacity <<= 1;
+    }
+
+    PalThreadPool* pool;
+    Uint64 size = sizeof(PalThreadPool);
+    pool = palAllocate(info->allocator, size, PAL_POOL_CACHE_LINE);
+    if (!pool) {
+        return PAL_RESULT_OUT_OF_MEMORY;
+    }
+
+    memset(pool, 0, sizeof(PalThreadPool));
+    pool->allocator = info->allocator;
+    pool->mask = capacity - 1;
+    pool->running = 1;
+
+    size = sizeof(TaskCell) * capacity;
+    pool->cells = palAllocate(info->allocator, size, PAL_POOL_CACHE_LINE);
+    if (!pool->cells) {
+        palFree(info->allocator, pool);
+        return PAL_RESULT_OUT_OF_MEMORY;
+    }
+
+    for (Uint32 i = 0; i < capacity; i++) {
+        pool->cells[i].sequence = (Int32)i;
+        pool->cells[i].func = nullptr;
+        pool->cells[i].userData = nullptr;
+    }
+
+    size = sizeof(PalThread*) * info->workerCount;
+    pool->threads = palAllocate(info->allocator, size, 0);
+    if (!pool->threads) {
+        palFree(info->allocator, pool->cells);
+        palFree(info->allocator, pool);
+        return PAL_RESULT_OUT_OF_MEMORY;
+    }
+    memset(pool->threads, 0, size);
+
+    PalResult result;
+    result = palCreateSemaphore(info->allocator, 0, &pool->tasks);
+    if (result != PAL_RESULT_SUCCESS) {
+        palFree(info->allocator, pool->threads);
+        palFree(info->allocator, pool->cells);
+        palFree(info->allocator, pool);
+        return result;
+    }
+
+    PalThreadCreateInfo createInfo = {0};
+    createInfo.allocator = info->allocator;
+    createInfo.entry = workerEntry;
+    createInfo.arg = pool;
+    createInfo.stackSize = info->stackSize;
+    pool->workerCount = info->workerCount;
+    for (Uint32 i = 0; i < info->workerCount; i++) {
+        result = palCreateThread(&createInfo, &pool->threads[i]);
+        if (result != PAL_RESULT_SUCCESS) {
+            pool->threads[i] = nullptr;
+            freeThreadPool(pool);
+            return result;
+        }
+    }
+
+    *outPool = pool;
+    return PAL_RESULT_SUCCESS;
+}
+
+void PAL_CALL palDestroyThreadPool(PalThreadPool* pool)
+{
+    if (pool) {
+        palWaitThreadPool(pool);
+        freeThreadPool(pool);
+    }
+}
+
+PalResult PAL_CALL palSubmitTask(
+    PalThreadPool* pool,
+    PalTaskFn func,
+    void* userData)
+{
+    if (!pool || !func) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    if (!queueTask(pool, func, userData)) {
+        // the queue is full, run it here instead of blocking
+        func(userData);
+    }
+    return PAL_RESULT_SUCCESS;
+}
+
+void PAL_CALL palWaitThreadPool(PalThreadPool* pool)
+{
+    if (!pool) {
+        return;
+    }
+
+    palAtomicFetchAdd32(&pool->waiters, 1, PAL_MEMORY_ORDER_SEQ_CST);
+    Int32 pending;
+    pending = palAtomicLoad32(&pool->pending, PAL_MEMORY_ORDER_SEQ_CST);
+    while (pending != 0) {
+        palWaitOnAddress(
+            &pool->pending,
+            &pending,
+            sizeof(Int32),
+            PAL_WAIT_INFINITE);
+
+        pending = palAtomicLoad32(&pool->pending, PAL_MEMORY_ORDER_SEQ_CST);
+    }
+    palAtomicFetchAdd32(&pool->waiters, -1, PAL_MEMORY_ORDER_RELAXED);
+}
+
+PalResult PAL_CALL palParallelFor(
+    PalThreadPool* pool,
+    Uint64 count,
+    Uint64 grainSize,
+    PalParallelForFn func,
+    void* userData)
+{
+    if (!pool || !func) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    if (count == 0) {
+        return PAL_RESULT_SUCCESS;
+    }
+
+    // the calling thread takes chunks too
+    Uint64 threads = (Uint64)pool->workerCount + 1;
+    if (grainSize == 0) {
+        grainSize = count / (threads * PAL_POOL_CHUNKS_PER_THREAD);
+        if (grainSize == 0) {
+            grainSize = 1;
+        }
+    }
+
+    ParallelFor loop;
+    loop.func = func;
+    loop.userData = userData;
+    loop.count = count;
+    loop.grainSize = grainSize;
+    loop.next = 0;
+    loop.helpers = 0;
+
+    // one helper per worker is enough, each keeps taking chunks. A full
+    // queue only means fewer helpers since the caller finishes the rest
+    Uint64 chunks = (count + grainSize - 1) / grainSize;
+    Uint64 helpers = chunks - 1;
+    if (helpers > pool->workerCount) {
+        helpers = pool->workerCount;
+    }
+
+    for (Uint64 i = 0; i < helpers; i++) {
+        palAtomicFetchAdd32(&loop.helpers, 1, PAL_MEMORY_ORDER_RELAXED);
+        if (!queueTask(pool, parallelForTask, &loop)) {
+            palAtomicFetchAdd32(&loop.helpers, -1, PAL_MEMORY_ORDER_RELAXED);
+            break;
+        }
+    }
+
+    runChunks(&loop);
+
+    // every chunk is taken, wait for the helpers. A helper can still be
+    // queued behind tasks that wait on this thread, so run queued tasks
+    // instead of sleeping while there are any. The post for a task run here
+    // is left alone, a worker that takes it finds the queue empty and sleeps
+    Int32 active;
+    active = palAtomicLoad32(&loop.helpers, PAL_MEMORY_ORDER_SEQ_CST);
+    while (active != 0) {
+        if (!runQueuedTask(pool)) {
+            palWaitOnAddress(
+                &loop.helpers,
+                &active,
+                sizeof(Int32),
+                PAL_POOL_HELP_INTERVAL);
+        }
+        active = palAtomicLoad32(&loop.helpers, PAL_MEMORY_ORDER_SEQ_CST);
+    }
+
+    return PAL_RESULT_SUCCESS;
+}
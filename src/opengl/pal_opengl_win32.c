@@ -22,6 +22,8 @@
 #include <stdlib.h>
 #include <windows.h>
 
+#include "pal_profiler_internal.h"
+
 // ==================================================
 // Typedefs, enums and structs
 // ==================================================
@@ -995,7 +997,11 @@ PalResult PAL_CALL palSwapBuffers(
         return PAL_RESULT_INVALID_GL_WINDOW;
     }
 
-    if (!s_Gdi.swapBuffers(hdc)) {
+    PAL_ZONE_BEGIN("palSwapBuffers");
+    BOOL swapped = s_Gdi.swapBuffers(hdc);
+    PAL_ZONE_END();
+
+    if (!swapped) {
         DWORD error = GetLastError();
         if (error == ERROR_INVALID_PIXEL_FORMAT) {
             return PAL_RESULT_INVALID_GL_FBCONFIG;
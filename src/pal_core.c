@@ -25,6 +25,14 @@ freely, subject to the following restrictions:
 // Includes
 // ==================================================
 
+#ifndef _WIN32
+// clock_gettime, CLOCK_MONOTONIC_RAW and posix_memalign
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif // _GNU_SOURCE
+#endif // _WIN32
+
+#include "pal/pal_atomic.h"
 #include "pal/pal_core.h"
 
 #ifdef _WIN32
@@ -42,6 +50,11 @@ freely, subject to the following restrictions:
 #endif // UNICODE
 
 #include <windows.h>
+#else
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
 #endif // _WIN32
 
 #if defined(_MSC_VER) || defined(__MINGW32__)
@@ -50,6 +63,9 @@ freely, subject to the following restrictions:
 
 #include <stdarg.h>
 #include <stdio.h>
+#include <stdlib.h>
+
+#include "pal_cpuid.h"
 
 // ==================================================
 // Typedefs, enums and structs
@@ -60,16 +76,22 @@ freely, subject to the following restrictions:
 #define PAL_VERSION_MINOR 0
 #define PAL_VERSION_BUILD 0
 #define PAL_VERSION_STRING "1.0.0"
-#define PAL_LOG_MSG_SIZE 4096
+#define PAL_LOG_STACK_SIZE 512
+#define PAL_DEFAULT_CALIBRATION_MS 10
 
-static volatile LONG s_TlsID = 0;
+// Holds a non null value while a thread is inside a log callback.
+// Stored as index + 1 so 0 can mean "not created".
+#ifdef _WIN32
+static volatile Int32 s_TlsID = 0;
+#else
+static pthread_key_t s_TlsKey;
+static pthread_once_t s_TlsOnce = PTHREAD_ONCE_INIT;
+static bool s_TlsValid = false;
+#endif // _WIN32
 
-typedef struct {
-    char tmp[PAL_LOG_MSG_SIZE];
-    char buffer[PAL_LOG_MSG_SIZE];
-    wchar_t wideBuffer[PAL_LOG_MSG_SIZE];
-    bool isLogging;
-} LogTLSData;
+// set once by palCalibrateTicks()
+static PalTickSource s_TickSource = PAL_TICK_SOURCE_OS;
+static Uint64 s_TickFrequency = 0;
 
 // ==================================================
 // Internal API
@@ -81,12 +103,16 @@ static inline void* alignedAlloc(
 {
 #if defined(_MSC_VER) || defined(__MINGW32__)
     return _aligned_malloc(size, alignment);
-#elif defined(_ISOC11_SOURCE) ||                                               \
-    defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
-    return aligned_alloc(alignment, size);
 #else
+    // posix_memalign requires a multiple of sizeof(void*)
+    if (alignment < sizeof(void*)) {
+        alignment = sizeof(void*);
+    }
+
     void* ptr = nullptr;
-    posix_memalign(&ptr, alignment);
+    if (posix_memalign(&ptr, (size_t)alignment, (size_t)size) != 0) {
+        return nullptr;
+    }
     return ptr;
 #endif // _MSC_VER
 }
@@ -100,98 +126,163 @@ static inline void alignedFree(void* ptr)
 #endif // _MSC_VER
 }
 
-static void destroyTlsData(void* data)
+#ifndef _WIN32
+static void createTlsKey()
 {
-    LogTLSData* tlsData = data;
-    if (tlsData) {
-        palFree(nullptr, tlsData);
-    }
+    s_TlsValid = pthread_key_create(&s_TlsKey, nullptr) == 0;
 }
+#endif // _WIN32
 
-static inline LogTLSData* getLogTlsData()
+static inline bool isLogging()
 {
 #ifdef _WIN32
-    LogTLSData* data = FlsGetValue((DWORD)s_TlsID);
+    Int32 id = palAtomicLoad32(&s_TlsID, PAL_MEMORY_ORDER_ACQUIRE);
+    if (id == 0) {
+        return false;
+    }
+    return FlsGetValue((DWORD)(id - 1)) != nullptr;
+#else
+    if (!s_TlsValid) {
+        return false;
+    }
+    return pthread_getspecific(s_TlsKey) != nullptr;
 #endif // _WIN32
+}
 
-    if (!data) {
-        data = palAllocate(nullptr, sizeof(LogTLSData), 0);
-        memset(data, 0, sizeof(LogTLSData));
+static inline void setLogging(bool logging)
+{
+    void* value = logging ? (void*)1 : nullptr;
 
-        // create TLS if it has not been created
 #ifdef _WIN32
-        if (s_TlsID == 0) {
-            DWORD TLSIndex = FlsAlloc(destroyTlsData);
-            if (TLSIndex == TLS_OUT_OF_INDEXES) {
-                // FIXME: Use a global log buffer with a mutex
-                return nullptr;
-            } else {
-                // update the TLS using atomic operations to avoid thread race
-                LONG prev = InterlockedCompareExchange(
-                    (volatile LONG*)&s_TlsID,
-                    (LONG)TLSIndex,
-                    0);
-
-                if (prev != 0) {
-                    // Another thread has already set this,
-                    // destroy the tls index
-                    FlsFree(TLSIndex);
-                }
-            }
+    // create TLS if it has not been created
+    Int32 id = palAtomicLoad32(&s_TlsID, PAL_MEMORY_ORDER_ACQUIRE);
+    if (id == 0) {
+        DWORD TLSIndex = FlsAlloc(nullptr);
+        if (TLSIndex == FLS_OUT_OF_INDEXES) {
+            return;
+        }
+
+        // update the TLS using atomic operations to avoid thread race
+        id = (Int32)TLSIndex + 1;
+        Int32 expected = 0;
+        if (!palAtomicCompareExchange32(
+                &s_TlsID,
+                &expected,
+                id,
+                PAL_MEMORY_ORDER_ACQ_REL)) {
+            // Another thread has already set this,
+            // destroy the tls index
+            FlsFree(TLSIndex);
+            id = expected;
         }
-        FlsSetValue(s_TlsID, data);
-#endif // _WIN32
     }
-    return data;
+    FlsSetValue((DWORD)(id - 1), value);
+#else
+    pthread_once(&s_TlsOnce, createTlsKey);
+    if (s_TlsValid) {
+        pthread_setspecific(s_TlsKey, value);
+    }
+#endif // _WIN32
 }
 
-static inline void updateLogTlsData(LogTLSData* data)
+static inline void writeToConsole(
+    const char* msg,
+    int size)
 {
 #ifdef _WIN32
-    FlsSetValue(s_TlsID, data);
+    // convert including the null terminator
+    wchar_t stackBuffer[PAL_LOG_STACK_SIZE];
+    wchar_t* buffer = stackBuffer;
+    int len = MultiByteToWideChar(CP_UTF8, 0, msg, size + 1, nullptr, 0);
+    if (!len) {
+        return;
+    }
+
+    if (len > PAL_LOG_STACK_SIZE) {
+        buffer = palAllocate(nullptr, sizeof(wchar_t) * len, 0);
+        if (!buffer) {
+            return;
+        }
+    }
+
+    MultiByteToWideChar(CP_UTF8, 0, msg, size + 1, buffer, len);
+    HANDLE console = GetStdHandle(STD_ERROR_HANDLE);
+    if (console) {
+        WriteConsoleW(console, buffer, (DWORD)len - 1, NULL, 0);
+    } else {
+        OutputDebugStringW(buffer);
+    }
+
+    if (buffer != stackBuffer) {
+        palFree(nullptr, buffer);
+    }
+#else
+    // write(2) may write partially or get interrupted by signals
+    while (size > 0) {
+        ssize_t written = write(STDERR_FILENO, msg, (size_t)size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+
+        msg += written;
+        size -= (int)written;
+    }
 #endif // _WIN32
 }
 
-static inline void formatArgs(
+static void logArgs(
+    const PalLogger* logger,
     const char* fmt,
-    va_list argsList,
-    char* buffer)
+    va_list argsList)
 {
-    va_list argsListCopy;
-    va_copy(argsListCopy, argsList);
-    int len = vsnprintf(nullptr, 0, fmt, argsListCopy);
-    va_end(argsListCopy);
+    bool useCallback = logger && logger->callback;
+    if (useCallback && isLogging()) {
+        // block recursion before paying for formatting
+        return;
+    }
 
+    // most messages fit on the stack. Larger ones get a buffer sized to the
+    // message, with room for the console newline
+    char stackBuffer[PAL_LOG_STACK_SIZE];
+    char* buffer = stackBuffer;
+
+    va_list argsListCopy;
     va_copy(argsListCopy, argsList);
-    vsnprintf(buffer, len + 1, fmt, argsListCopy);
+    int len = vsnprintf(stackBuffer, PAL_LOG_STACK_SIZE, fmt, argsListCopy);
     va_end(argsListCopy);
-    buffer[len] = 0;
-}
+    if (len < 0) {
+        return;
+    }
 
-static inline void format(
-    char* buffer,
-    const char* fmt,
-    ...)
-{
-    va_list argPtr;
-    va_start(argPtr, fmt);
-    formatArgs(fmt, argPtr, buffer);
-    va_end(argPtr);
-}
+    if (len + 2 > PAL_LOG_STACK_SIZE) {
+        buffer = palAllocate(nullptr, (Uint64)len + 2, 0);
+        if (!buffer) {
+            return;
+        }
 
-static inline void writeToConsole(LogTLSData* data)
-{
-    HANDLE console = GetStdHandle(STD_ERROR_HANDLE);
-    int len = MultiByteToWideChar(CP_UTF8, 0, data->buffer, -1, nullptr, 0);
-    if (!len) {
-        return;
+        va_copy(argsListCopy, argsList);
+        vsnprintf(buffer, (size_t)len + 1, fmt, argsListCopy);
+        va_end(argsListCopy);
     }
 
-    MultiByteToWideChar(CP_UTF8, 0, data->buffer, -1, data->wideBuffer, len);
-    if (console) {
-        WriteConsoleW(console, data->wideBuffer, (DWORD)len - 1, NULL, 0);
+    if (useCallback) {
+        // update the tls to stop recursive calls
+        setLogging(true);
+        logger->callback(logger->userData, buffer);
+        setLogging(false);
+
     } else {
-        OutputDebugStringW(data->wideBuffer);
+        // add newline character to the string
+        buffer[len] = '\n';
+        buffer[len + 1] = '\0';
+        writeToConsole(buffer, len + 1);
+    }
+
+    if (buffer != stackBuffer) {
+        palFree(nullptr, buffer);
     }
 }
 
@@ -334,37 +425,32 @@ void PAL_CALL palLog(
     const char* fmt,
     ...)
 {
-    if (!fmt) {
+    if (!fmt || !palShouldLog(logger, PAL_LOG_LEVEL_INFO, 0)) {
         return;
     }
 
-    LogTLSData* data = getLogTlsData();
     va_list argPtr;
     va_start(argPtr, fmt);
-    formatArgs(fmt, argPtr, data->tmp);
+    logArgs(logger, fmt, argPtr);
     va_end(argPtr);
+}
 
-    // check to see if a user supplied a logger
-    if (logger && logger->callback) {
-        if (data->isLogging) {
-            // block recursion
-            return;
-        }
-
-        // update the tls to stop recursive calls
-        memcpy(data->buffer, data->tmp, PAL_LOG_MSG_SIZE);
-        data->isLogging = true;
-        updateLogTlsData(data);
-        logger->callback(logger->userData, data->buffer);
-
-    } else {
-        // add newline character to the string
-        format(data->buffer, "%s\n", data->tmp);
-        writeToConsole(data);
+void PAL_CALL palLogEx(
+    const PalLogger* logger,
+    PalLogLevel level,
+    Uint32 category,
+    const char* fmt,
+    ...)
+{
+    // filter before paying for formatting
+    if (!fmt || !palShouldLog(logger, level, category)) {
+        return;
     }
 
-    data->isLogging = false;
-    updateLogTlsData(data);
+    va_list argPtr;
+    va_start(argPtr, fmt);
+    logArgs(logger, fmt, argPtr);
+    va_end(argPtr);
 }
 
 Uint64 PAL_CALL palGetPerformanceCounter()
@@ -373,6 +459,11 @@ Uint64 PAL_CALL palGetPerformanceCounter()
     LARGE_INTEGER counter;
     QueryPerformanceCounter(&counter);
     return (Uint64)counter.QuadPart;
+#else
+    // raw hardware time, not slewed by NTP. Counted in nanoseconds
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return (Uint64)ts.tv_sec * 1000000000ull + (Uint64)ts.tv_nsec;
 #endif // _WIN32
 }
 
@@ -382,5 +473,68 @@ Uint64 PAL_CALL palGetPerformanceFrequency()
     LARGE_INTEGER frequency;
     QueryPerformanceFrequency(&frequency);
     return (Uint64)frequency.QuadPart;
+#else
+    return 1000000000ull;
 #endif // _WIN32
-}
\ No newline at end of file
+}
+
+PalTickSource PAL_CALL palCalibrateTicks(Uint64 milliseconds)
+{
+#if PAL_HAS_CPUID
+    if (!hasInvariantTsc()) {
+        s_TickSource = PAL_TICK_SOURCE_OS;
+        return s_TickSource;
+    }
+
+    if (milliseconds == 0) {
+        milliseconds = PAL_DEFAULT_CALIBRATION_MS;
+    }
+
+    // spin instead of sleeping so the thread is not descheduled between the
+    // two clocks
+    Uint64 osFrequency = palGetPerformanceFrequency();
+    Uint64 osStart = palGetPerformanceCounter();
+    Uint64 tscStart = readTsc();
+    Uint64 osTarget = osStart + (osFrequency * milliseconds) / 1000;
+
+    Uint64 osEnd = osStart;
+    while (osEnd < osTarget) {
+        osEnd = palGetPerformanceCounter();
+    }
+    Uint64 tscEnd = readTsc();
+
+    double elapsed = (double)(osEnd - osStart) / (double)osFrequency;
+    s_TickFrequency = (Uint64)((double)(tscEnd - tscStart) / elapsed);
+    s_TickSource = PAL_TICK_SOURCE_TSC;
+#else
+    s_TickSource = PAL_TICK_SOURCE_OS;
+#endif // PAL_HAS_CPUID
+    return s_TickSource;
+}
+
+Uint64 PAL_CALL palGetTicks()
+{
+#if PAL_HAS_CPUID
+    if (s_TickSource == PAL_TICK_SOURCE_TSC) {
+        return readTsc();
+    }
+#endif // PAL_HAS_CPUID
+    return palGetPerformanceCounter();
+}
+
+Uint64 PAL_CALL palGetTicksFrequency()
+{
+    if (s_TickSource == PAL_TICK_SOURCE_TSC) {
+        return s_TickFrequency;
+    }
+    return palGetPerformanceFrequency();
+}
+
+Uint64 PAL_CALL palTicksToNanoseconds(Uint64 ticks)
+{
+    // split to avoid overflowing for large tick counts
+    Uint64 frequency = palGetTicksFrequency();
+    Uint64 seconds = ticks / frequency;
+    Uint64 remainder = ticks % frequency;
+    return seconds * 1000000000ull + (remainder * 1000000000ull) / frequency;
+}
@@ -0,0 +1,80 @@
+
+/**
+
+Copyright (C) 2025 Nicholas Agbo
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+
+ */
+
+// Internal CPUID helpers shared by the core and system modules.
+
+#ifndef _PAL_CPUID_H
+#define _PAL_CPUID_H
+
+#include "pal/pal_core.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) ||             \
+    defined(__i386__)
+#define PAL_HAS_CPUID 1
+#else
+#define PAL_HAS_CPUID 0
+#endif // x86
+
+#if PAL_HAS_CPUID
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif // _MSC_VER
+
+static inline void cpuid(
+    int regs[4],
+    int leaf,
+    int subLeaf)
+{
+#if defined(_MSC_VER)
+    __cpuidex(regs, leaf, subLeaf);
+#else
+    // gcc, clang
+    __asm__ __volatile__(
+        "cpuid"
+        : "=a"(regs[0]), "=b"(regs[1]), "=c"(regs[2]), "=d"(regs[3])
+        : "a"(leaf), "c"(subLeaf));
+#endif // _MSC_VER
+}
+
+static inline Uint64 readTsc()
+{
+    return (Uint64)__rdtsc();
+}
+
+static inline bool hasInvariantTsc()
+{
+    int regs[4] = {0};
+    cpuid(regs, 0x80000000, 0);
+    if ((unsigned int)regs[0] < 0x80000007) {
+        return false;
+    }
+
+    // CPUID.80000007H:EDX[8] is the invariant TSC bit
+    cpuid(regs, 0x80000007, 0);
+    return (regs[3] & (1 << 8)) != 0;
+}
+#endif // PAL_HAS_CPUID
+
+#endif // _PAL_CPUID_H
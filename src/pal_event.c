@@ -28,6 +28,8 @@ freely, subject to the following restrictions:
 #include "pal/pal_event.h"
 #include <string.h>
 
+#include "pal_profiler_internal.h"
+
 // ==================================================
 // Typedefs, enums and structs
 // ==================================================
@@ -186,18 +188,20 @@ void PAL_CALL palPushEvent(
         return;
     }
 
+    PAL_ZONE_BEGIN("palPushEvent");
+
     // get the event mode
     PalDispatchMode mode = eventDriver->modes[event->type];
     if (mode == PAL_DISPATCH_CALLBACK) {
         if (eventDriver->callback) {
             eventDriver->callback(eventDriver->userData, event);
         }
-        return; // we have dispatched the event
-    }
 
-    if (mode == PAL_DISPATCH_POLL) {
+    } else if (mode == PAL_DISPATCH_POLL) {
         eventDriver->queue->push(eventDriver->queue, event);
     }
+
+    PAL_ZONE_END();
 }
 
 bool PAL_CALL palPollEvent(
@@ -0,0 +1,654 @@
+
+/**
+
+Copyright (C) 2025 Nicholas Agbo
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+
+ */
+
+// ==================================================
+// Includes
+// ==================================================
+
+#ifndef _WIN32
+// syscall and SYS_gettid
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif // _GNU_SOURCE
+#endif // _WIN32
+
+#include "pal/pal_atomic.h"
+#include "pal/pal_profiler.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif // WIN32_LEAN_AND_MEAN
+
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif // NOMINMAX
+
+// set unicode
+#ifndef UNICODE
+#define UNICODE
+#endif // UNICODE
+
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif // _WIN32
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+// ==================================================
+// Typedefs, enums and structs
+// ==================================================
+
+#define PAL_DEFAULT_PROFILE_EVENTS 65536
+#define PAL_PROFILE_WRITE_SIZE 4096
+#define PAL_PROFILE_BINARY_VERSION 1
+#define PAL_PROFILE_END_NAME 0xFFFFFFFF
+#define PAL_PROFILE_MIN_NAMES 64
+#define PAL_PROFILE_MAX_NAMES ((Uint64)1 << 32) // name indices are Uint32
+
+typedef struct {
+    const char* name; // nullptr for end events
+    Uint64 time;
+} ProfileEvent;
+
+typedef struct ThreadBuffer {
+    struct ThreadBuffer* next;
+    Uint32 threadId;
+    Uint32 depth;          // open recorded zones. Owner thread only
+    Uint32 skipped;        // open dropped zones. Owner thread only
+    volatile Int32 count;  // published with release semantics
+    ProfileEvent events[];
+} ThreadBuffer;
+
+typedef struct {
+    ThreadBuffer* buffer;
+    Uint32 count;
+} BufferSnapshot;
+
+typedef struct {
+    const char* name;
+    Uint32 index;
+} NameEntry;
+
+typedef struct {
+    NameEntry* table;
+    const char** names; // unique names in first seen order
+    Uint64 capacity;    // power of two, at least twice the name count
+    Uint32 count;
+} NameTable;
+
+typedef struct {
+    PalProfileWriteFn write;
+    void* userData;
+    Uint64 size;
+    char data[PAL_PROFILE_WRITE_SIZE];
+} Writer;
+
+typedef struct {
+    bool initialized;
+    Uint32 capacity;
+    Uint64 startTime;
+    const PalAllocator* allocator;
+    ThreadBuffer* volatile buffers;
+
+#ifdef _WIN32
+    DWORD tlsId;
+#else
+    pthread_key_t tlsKey;
+#endif // _WIN32
+} Profiler;
+
+static Profiler s_Profiler;
+
+// ==================================================
+// Internal API
+// ==================================================
+
+static inline ThreadBuffer* loadBuffers()
+{
+    void* volatile* list = (void* volatile*)&s_Profiler.buffers;
+    return palAtomicLoadPtr(list, PAL_MEMORY_ORDER_ACQUIRE);
+}
+
+static inline Uint32 getThreadId()
+{
+#ifdef _WIN32
+    return (Uint32)GetCurrentThreadId();
+#else
+    return (Uint32)syscall(SYS_gettid);
+#endif // _WIN32
+}
+
+static inline ThreadBuffer* getTlsBuffer()
+{
+#ifdef _WIN32
+    return FlsGetValue(s_Profiler.tlsId);
+#else
+    return pthread_getspecific(s_Profiler.tlsKey);
+#endif // _WIN32
+}
+
+static inline void setTlsBuffer(ThreadBuffer* buffer)
+{
+#ifdef _WIN32
+    FlsSetValue(s_Profiler.tlsId, buffer);
+#else
+    pthread_setspecific(s_Profiler.tlsKey, buffer);
+#endif // _WIN32
+}
+
+static ThreadBuffer* createThreadBuffer()
+{
+    Uint64 size = sizeof(ThreadBuffer);
+    size += sizeof(ProfileEvent) * (Uint64)s_Profiler.capacity;
+
+    // cache line aligned so buffers of different threads never share a line
+    ThreadBuffer* buffer = palAllocate(s_Profiler.allocator, size, 64);
+    if (!buffer) {
+        return nullptr;
+    }
+
+    memset(buffer, 0, sizeof(ThreadBuffer));
+    buffer->threadId = getThreadId();
+
+    // push to the list of buffers. The list only grows until shutdown
+    void* volatile* list = (void* volatile*)&s_Profiler.buffers;
+    void* head = loadBuffers();
+    do {
+        buffer->next = head;
+    } while (!palAtomicCompareExchangePtr(
+        list,
+        &head,
+        buffer,
+        PAL_MEMORY_ORDER_RELEASE));
+
+    setTlsBuffer(buffer);
+    return buffer;
+}
+
+static inline void flushWriter(Writer* writer)
+{
+    if (writer->size) {
+        writer->write(writer->userData, writer->data, writer->size);
+        writer->size = 0;
+    }
+}
+
+static void writeBytes(
+    Writer* writer,
+    const void* data,
+    Uint64 size)
+{
+    const char* bytes = data;
+    while (size) {
+        Uint64 space = PAL_PROFILE_WRITE_SIZE - writer->size;
+        Uint64 copy = size < space ? size : space;
+        memcpy(writer->data + writer->size, bytes, copy);
+        writer->size += copy;
+        bytes += copy;
+        size -= copy;
+
+        if (writer->size == PAL_PROFILE_WRITE_SIZE) {
+            flushWriter(writer);
+        }
+    }
+}
+
+static void writeFormat(
+    Writer* writer,
+    const char* fmt,
+    ...)
+{
+    char buffer[128];
+    va_list argPtr;
+    va_start(argPtr, fmt);
+    int len = vsnprintf(buffer, sizeof(buffer), fmt, argPtr);
+    va_end(argPtr);
+
+    if (len > 0) {
+        writeBytes(writer, buffer, (Uint64)len);
+    }
+}
+
+static void writeJsonString(
+    Writer* writer,
+    const char* string)
+{
+    writeBytes(writer, "\"", 1);
+    for (const char* c = string; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            char escaped[2] = {'\\', *c};
+            writeBytes(writer, escaped, 2);
+
+        } else if ((unsigned char)*c < 0x20) {
+            writeFormat(writer, "\\u%04x", (unsigned int)(unsigned char)*c);
+
+        } else {
+            writeBytes(writer, c, 1);
+        }
+    }
+    writeBytes(writer, "\"", 1);
+}
+
+static Uint32 snapshotBuffers(
+    ThreadBuffer* head,
+    BufferSnapshot* snapshots)
+{
+    // the list only grows at the head, so everything after a loaded head is
+    // stable. Count only if no array was provided
+    Uint32 count = 0;
+    for (ThreadBuffer* buffer = head; buffer; buffer = buffer->next) {
+        if (snapshots) {
+            snapshots[count].buffer = buffer;
+            snapshots[count].count = (Uint32)palAtomicLoad32(
+                &buffer->count,
+                PAL_MEMORY_ORDER_ACQUIRE);
+        }
+        count++;
+    }
+    return count;
+}
+
+static void exportChrome(
+    Writer* writer,
+    BufferSnapshot* snapshots,
+    Uint32 threadCount)
+{
+    double scale = 1000000.0 / (double)palGetPerformanceFrequency();
+    bool first = true;
+
+    writeFormat(writer, "{\"traceEvents\":[");
+    for (Uint32 i = 0; i < threadCount; i++) {
+        ThreadBuffer* buffer = snapshots[i].buffer;
+        for (Uint32 j = 0; j < snapshots[i].count; j++) {
+            ProfileEvent* event = &buffer->events[j];
+            double time = (double)(event->time - s_Profiler.startTime) * scale;
+            if (!first) {
+                writeBytes(writer, ",\n", 2);
+            }
+            first = false;
+
+            if (event->name) {
+                writeFormat(writer, "{\"name\":");
+                writeJsonString(writer, event->name);
+                writeFormat(writer, ",\"ph\":\"B\"");
+
+            } else {
+                writeFormat(writer, "{\"ph\":\"E\"");
+            }
+
+            writeFormat(
+                writer,
+                ",\"ts\":%.3f,\"pid\":1,\"tid\":%u}",
+                time,
+                buffer->threadId);
+        }
+    }
+    writeFormat(writer, "],\"displayTimeUnit\":\"ns\"}\n");
+}
+
+static NameEntry* findName(
+    NameEntry* table,
+    Uint64 capacity,
+    const char* name)
+{
+    // open addressing on the name pointer. Capacity is a power of two
+    Uint64 index = (Uint64)((UintPtr)name >> 3) * 2654435761u;
+    for (;;) {
+        index &= capacity - 1;
+        if (!table[index].name || table[index].name == name) {
+            return &table[index];
+        }
+        index++;
+    }
+}
+
+static PalResult growNameTable(NameTable* names)
+{
+    // double the capacity and rehash. The first table has no names
+    Uint64 capacity = PAL_PROFILE_MIN_NAMES;
+    if (names->capacity) {
+        capacity = names->capacity * 2;
+    }
+
+    if (capacity > PAL_PROFILE_MAX_NAMES) {
+        return PAL_RESULT_OUT_OF_MEMORY;
+    }
+
+    Uint64 size = sizeof(NameEntry) * capacity;
+    NameEntry* table = palAllocate(s_Profiler.allocator, size, 0);
+    if (!table) {
+        return PAL_RESULT_OUT_OF_MEMORY;
+    }
+    memset(table, 0, size);
+
+    size = sizeof(char*) * (capacity / 2);
+    const char** list = palAllocate(s_Profiler.allocator, size, 0);
+    if (!list) {
+        palFree(s_Profiler.allocator, table);
+        return PAL_RESULT_OUT_OF_MEMORY;
+    }
+
+    for (Uint32 i = 0; i < names->count; i++) {
+        NameEntry* entry = findName(table, capacity, names->names[i]);
+        entry->name = names->names[i];
+        entry->index = i;
+        list[i] = names->names[i];
+    }
+
+    palFree(s_Profiler.allocator, names->names);
+    palFree(s_Profiler.allocator, names->table);
+    names->table = table;
+    names->names = list;
+    names->capacity = capacity;
+    return PAL_RESULT_SUCCESS;
+}
+
+static PalResult exportBinary(
+    Writer* writer,
+    BufferSnapshot* snapshots,
+    Uint32 threadCount)
+{
+    // sized by unique names, a capture usually reuses a few of them
+    NameTable names = {0};
+    PalResult result = growNameTable(&names);
+    if (result != PAL_RESULT_SUCCESS) {
+        return result;
+    }
+
+    for (Uint32 i = 0; i < threadCount; i++) {
+        ThreadBuffer* buffer = snapshots[i].buffer;
+        for (Uint32 j = 0; j < snapshots[i].count; j++) {
+            const char* name = buffer->events[j].name;
+            if (!name) {
+                continue;
+            }
+
+            NameEntry* entry = findName(names.table, names.capacity, name);
+            if (entry->name) {
+                continue;
+            }
+
+            // keep the table at most half full
+            if (((Uint64)names.count + 1) * 2 > names.capacity) {
+                result = growNameTable(&names);
+                if (result != PAL_RESULT_SUCCESS) {
+                    palFree(s_Profiler.allocator, names.names);
+                    palFree(s_Profiler.allocator, names.table);
+                    return result;
+                }
+                entry = findName(names.table, names.capacity, name);
+            }
+
+            entry->name = name;
+            entry->index = names.count;
+            names.names[names.count++] = name;
+        }
+    }
+
+    // header
+    Uint32 version = PAL_PROFILE_BINARY_VERSION;
+    Uint64 frequency = palGetPerformanceFrequency();
+    writeBytes(writer, "PALP", 4);
+    writeBytes(writer, &version, sizeof(Uint32));
+    writeBytes(writer, &frequency, sizeof(Uint64));
+    writeBytes(writer, &names.count, sizeof(Uint32));
+    writeBytes(writer, &threadCount, sizeof(Uint32));
+
+    for (Uint32 i = 0; i < names.count; i++) {
+        size_t len = strlen(names.names[i]);
+        Uint16 nameSize = len > 0xFFFF ? 0xFFFF : (Uint16)len;
+        writeBytes(writer, &nameSize, sizeof(Uint16));
+        writeBytes(writer, names.names[i], nameSize);
+    }
+
+    for (Uint32 i = 0; i < threadCount; i++) {
+        ThreadBuffer* buffer = snapshots[i].buffer;
+        writeBytes(writer, &buffer->threadId, sizeof(Uint32));
+        writeBytes(writer, &snapshots[i].count, sizeof(Uint32));
+
+        for (Uint32 j = 0; j < snapshots[i].count; j++) {
+            ProfileEvent* event = &buffer->events[j];
+            Uint32 record[2] = {PAL_PROFILE_END_NAME, 1};
+            if (event->name) {
+                NameEntry* entry;
+                entry = findName(names.table, names.capacity, event->name);
+                record[0] = entry->index;
+                record[1] = 0;
+            }
+
+            writeBytes(writer, record, sizeof(record));
+            writeBytes(writer, &event->time, sizeof(Uint64));
+        }
+    }
+
+    palFree(s_Profiler.allocator, names.names);
+    palFree(s_Profiler.allocator, names.table);
+    return PAL_RESULT_SUCCESS;
+}
+
+// ==================================================
+// Public API
+// ==================================================
+
+PalResult PAL_CALL palInitProfiler(
+    const PalAllocator* allocator,
+    Uint32 maxEventsPerThread)
+{
+    if (s_Profiler.initialized) {
+        return PAL_RESULT_SUCCESS;
+    }
+
+    if (allocator && (!allocator->allocate || !allocator->free)) {
+        return PAL_RESULT_INVALID_ALLOCATOR;
+    }
+
+    // a fresh TLS slot, so stale buffers from a previous init are not reused
+#ifdef _WIN32
+    s_Profiler.tlsId = FlsAlloc(nullptr);
+    if (s_Profiler.tlsId == FLS_OUT_OF_INDEXES) {
+        return PAL_RESULT_PLATFORM_FAILURE;
+    }
+#else
+    if (pthread_key_create(&s_Profiler.tlsKey, nullptr) != 0) {
+        return PAL_RESULT_PLATFORM_FAILURE;
+    }
+#endif // _WIN32
+
+    s_Profiler.capacity = maxEventsPerThread;
+    if (s_Profiler.capacity == 0) {
+        s_Profiler.capacity = PAL_DEFAULT_PROFILE_EVENTS;
+    }
+
+    s_Profiler.allocator = allocator;
+    s_Profiler.buffers = nullptr;
+    s_Profiler.startTime = palGetPerformanceCounter();
+    s_Profiler.initialized = true;
+    return PAL_RESULT_SUCCESS;
+}
+
+void PAL_CALL palShutdownProfiler()
+{
+    if (!s_Profiler.initialized) {
+        return;
+    }
+
+    s_Profiler.initialized = false;
+    ThreadBuffer* buffer = s_Profiler.buffers;
+    while (buffer) {
+        ThreadBuffer* next = buffer->next;
+        palFree(s_Profiler.allocator, buffer);
+        buffer = next;
+    }
+    s_Profiler.buffers = nullptr;
+
+#ifdef _WIN32
+    FlsFree(s_Profiler.tlsId);
+#else
+    pthread_key_delete(s_Profiler.tlsKey);
+#endif // _WIN32
+}
+
+void PAL_CALL palProfileBegin(const char* name)
+{
+    if (!s_Profiler.initialized || !name) {
+        return;
+    }
+
+    ThreadBuffer* buffer = getTlsBuffer();
+    if (!buffer) {
+        buffer = createThreadBuffer();
+        if (!buffer) {
+            return;
+        }
+    }
+
+    // keep room for the end events of all open zones. Once a zone is dropped,
+    // its children are dropped too so begin and end events stay paired
+    Uint32 count = (Uint32)buffer->count;
+    if (buffer->skipped || count + buffer->depth + 2 > s_Profiler.capacity) {
+        buffer->skipped++;
+        return;
+    }
+
+    ProfileEvent* event = &buffer->events[count];
+    event->name = name;
+    event->time = palGetPerformanceCounter();
+    buffer->depth++;
+    palAtomicStore32(
+        &buffer->count,
+        (Int32)count + 1,
+        PAL_MEMORY_ORDER_RELEASE);
+}
+
+void PAL_CALL palProfileEnd()
+{
+    // read the time first so the profiler overhead is not part of the zone
+    Uint64 time = palGetPerformanceCounter();
+    if (!s_Profiler.initialized) {
+        return;
+    }
+
+    ThreadBuffer* buffer = getTlsBuffer();
+    if (!buffer) {
+        return;
+    }
+
+    if (buffer->skipped) {
+        buffer->skipped--;
+        return;
+    }
+
+    if (!buffer->depth) {
+        // unbalanced end
+        return;
+    }
+
+    Uint32 count = (Uint32)buffer->count;
+    ProfileEvent* event = &buffer->events[count];
+    event->name = nullptr;
+    event->time = time;
+    buffer->depth--;
+    palAtomicStore32(
+        &buffer->count,
+        (Int32)count + 1,
+        PAL_MEMORY_ORDER_RELEASE);
+}
+
+PalResult PAL_CALL palExportProfile(
+    PalProfileFormat format,
+    PalProfileWriteFn write,
+    void* userData)
+{
+    if (!write) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    if (!s_Profiler.initialized) {
+        return PAL_RESULT_INVALID_ARGUMENT;
+    }
+
+    if (format != PAL_PROFILE_FORMAT_CHROME_JSON &&
+        format != PAL_PROFILE_FORMAT_BINARY) {
+        return PAL_RESULT_INVALID_ARGUMENT;
+    }
+
+    // the writer is too large for the stack
+    Writer* writer = palAllocate(s_Profiler.allocator, sizeof(Writer), 0);
+    if (!writer) {
+        return PAL_RESULT_OUT_OF_MEMORY;
+    }
+
+    writer->write = write;
+    writer->userData = userData;
+    writer->size = 0;
+
+    // freeze the event counts so every pass sees the same events. Threads
+    // registered after this are left for the next export
+    ThreadBuffer* head = loadBuffers();
+    Uint32 threadCount = snapshotBuffers(head, nullptr);
+    BufferSnapshot* snapshots = nullptr;
+    if (threadCount) {
+        Uint64 size = sizeof(BufferSnapshot) * (Uint64)threadCount;
+        snapshots = palAllocate(s_Profiler.allocator, size, 0);
+        if (!snapshots) {
+            palFree(s_Profiler.allocator, writer);
+            return PAL_RESULT_OUT_OF_MEMORY;
+        }
+        snapshotBuffers(head, snapshots);
+    }
+
+    PalResult result = PAL_RESULT_SUCCESS;
+    if (format == PAL_PROFILE_FORMAT_CHROME_JSON) {
+        exportChrome(writer, snapshots, threadCount);
+
+    } else {
+        result = exportBinary(writer, snapshots, threadCount);
+    }
+
+    flushWriter(writer);
+    palFree(s_Profiler.allocator, snapshots);
+    palFree(s_Profiler.allocator, writer);
+    return result;
+}
+
+void PAL_CALL palResetProfile()
+{
+    if (!s_Profiler.initialized) {
+        return;
+    }
+
+    ThreadBuffer* buffer = loadBuffers();
+    while (buffer) {
+        buffer->depth = 0;
+        buffer->skipped = 0;
+        palAtomicStore32(&buffer->count, 0, PAL_MEMORY_ORDER_RELEASE);
+        buffer = buffer->next;
+    }
+    s_Profiler.startTime = palGetPerformanceCounter();
+}
@@ -0,0 +1,42 @@
+
+/**
+
+Copyright (C) 2025 Nicholas Agbo
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+
+ */
+
+// Zones used to instrument PAL's own hot paths. Compiled out unless the
+// profiler is built and PAL_PROFILE_INTERNALS is enabled in pal_config.lua.
+
+#ifndef _PAL_PROFILER_INTERNAL_H
+#define _PAL_PROFILER_INTERNAL_H
+
+#include "pal/pal_config.h"
+
+#if PAL_HAS_PROFILER && PAL_PROFILE_INTERNALS
+#include "pal/pal_profiler.h"
+
+#define PAL_ZONE_BEGIN(name) palProfileBegin(name)
+#define PAL_ZONE_END() palProfileEnd()
+#else
+#define PAL_ZONE_BEGIN(name) ((void)0)
+#define PAL_ZONE_END() ((void)0)
+#endif // PAL_HAS_PROFILER
+
+#endif // _PAL_PROFILER_INTERNAL_H
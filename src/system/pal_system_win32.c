@@ -43,9 +43,7 @@ freely, subject to the following restrictions:
 #include <string.h>
 #include <windows.h>
 
-#if defined(_MSC_VER)
-#include <intrin.h>
-#endif // _MSC_VER
+#include "pal_cpuid.h"
 
 // ==================================================
 // Typedefs, enums and structs
@@ -57,22 +55,6 @@ typedef LONG(WINAPI* RtlGetVersionFn)(PRTL_OSVERSIONINFOW);
 // Internal API
 // ==================================================
 
-static inline void cpuid(
-    int regs[4],
-    int leaf,
-    int subLeaf)
-{
-#if defined(_MSC_VER)
-    __cpuidex(regs, leaf, subLeaf);
-#else
-    // gcc, clang
-    __asm__ __volatile__(
-        "cpuid"
-        : "=a"(regs[0]), "=b"(regs[1]), "=c"(regs[2]), "=d"(regs[3])
-        : "a"(leaf), "b"(subLeaf));
-#endif // _MSC_VER
-}
-
 static inline bool getVersionWin32(PalVersion* version)
 {
     OSVERSIONINFOEXW ver = {0};
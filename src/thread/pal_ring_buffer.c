@@ -0,0 +1,513 @@
+
+/**
+
+Copyright (C) 2025 Nicholas Agbo
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+
+ */
+
+// ==================================================
+// Includes
+// ==================================================
+
+#include "pal/pal_atomic.h"
+#include "pal/pal_thread.h"
+
+#include <string.h>
+
+// ==================================================
+// Typedefs, enums and structs
+// ==================================================
+
+#define PAL_RING_CACHE_LINE 64
+#define PAL_RING_MAX_CAPACITY (1u << 30) // positions are compared as Int32
+
+// MPMC cells start with their sequence, padded to keep elements aligned
+#define PAL_RING_CELL_HEADER 8
+
+struct PalRingBuffer {
+    volatile Int32 tail; // next position to push
+    Int32 cachedHead;    // SPSC producer's copy of head
+    char padding0[PAL_RING_CACHE_LINE - sizeof(Int32) * 2];
+    volatile Int32 head; // next position to pop
+    Int32 cachedTail;    // SPSC consumer's copy of tail
+    char padding1[PAL_RING_CACHE_LINE - sizeof(Int32) * 2];
+    volatile Int32 pushWaiters;
+    volatile Int32 popWaiters;
+    char padding2[PAL_RING_CACHE_LINE - sizeof(Int32) * 2];
+    const PalAllocator* allocator;
+    Uint8* cells;
+    Uint32 mask; // capacity - 1
+    Uint32 elementSize;
+    Uint32 stride; // bytes between cells
+    PalRingBufferType type;
+    bool blocking;
+    PalMutex* mutex;
+    PalCondVar* notFull;
+    PalCondVar* notEmpty;
+    PalMutexStorage mutexStorage;
+    PalCondVarStorage notFullStorage;
+    PalCondVarStorage notEmptyStorage;
+};
+
+// ==================================================
+// Internal API
+// ==================================================
+
+static inline Uint8* getCell(
+    PalRingBuffer* ringBuffer,
+    Uint32 pos)
+{
+    Uint32 index = pos & ringBuffer->mask;
+    return ringBuffer->cells + (UintPtr)index * ringBuffer->stride;
+}
+
+static inline volatile Int32* getSequence(
+    PalRingBuffer* ringBuffer,
+    Uint32 pos)
+{
+    return (volatile Int32*)getCell(ringBuffer, pos);
+}
+
+static bool pushSPSC(
+    PalRingBuffer* ringBuffer,
+    const void* element)
+{
+    // only the producer writes tail, so it can be read relaxed
+    Uint32 tail = (Uint32)palAtomicLoad32(
+        &ringBuffer->tail,
+        PAL_MEMORY_ORDER_RELAXED);
+
+    if (tail - (Uint32)ringBuffer->cachedHead > ringBuffer->mask) {
+        // full as far as we knew, look at the consumer's index
+        ringBuffer->cachedHead = palAtomicLoad32(
+            &ringBuffer->head,
+            PAL_MEMORY_ORDER_ACQUIRE);
+
+        if (tail - (Uint32)ringBuffer->cachedHead > ringBuffer->mask) {
+            return false;
+        }
+    }
+
+    memcpy(getCell(ringBuffer, tail), element, ringBuffer->elementSize);
+    palAtomicStore32(
+        &ringBuffer->tail,
+        (Int32)(tail + 1),
+        PAL_MEMORY_ORDER_RELEASE);
+
+    return true;
+}
+
+static bool popSPSC(
+    PalRingBuffer* ringBuffer,
+    void* outElement)
+{
+    Uint32 head = (Uint32)palAtomicLoad32(
+        &ringBuffer->head,
+        PAL_MEMORY_ORDER_RELAXED);
+
+    if (head == (Uint32)ringBuffer->cachedTail) {
+        // empty as far as we knew, look at the producer's index
+        ringBuffer->cachedTail = palAtomicLoad32(
+            &ringBuffer->tail,
+            PAL_MEMORY_ORDER_ACQUIRE);
+
+        if (head == (Uint32)ringBuffer->cachedTail) {
+            return false;
+        }
+    }
+
+    memcpy(outElement, getCell(ringBuffer, head), ringBuffer->elementSize);
+    palAtomicStore32(
+        &ringBuffer->head,
+        (Int32)(head + 1),
+        PAL_MEMORY_ORDER_RELEASE);
+
+    return true;
+}
+
+static bool pushMPMC(
+    PalRingBuffer* ringBuffer,
+    const void* element)
+{
+    // each cell sequence tells producers and consumers whose turn it is.
+    // Positions wrap, so compare them as differences
+    volatile Int32* sequence;
+    Int32 pos = palAtomicLoad32(&ringBuffer->tail, PAL_MEMORY_ORDER_RELAXED);
+    for (;;) {
+        sequence = getSequence(ringBuffer, (Uint32)pos);
+        Int32 seq = palAtomicLoad32(sequence, PAL_MEMORY_ORDER_ACQUIRE);
+        Int32 diff = (Int32)((Uint32)seq - (Uint32)pos);
+
+        if (diff == 0) {
+            if (palAtomicCompareExchange32(
+                    &ringBuffer->tail,
+                    &pos,
+                    (Int32)((Uint32)pos + 1),
+                    PAL_MEMORY_ORDER_RELAXED)) {
+                break;
+            }
+
+        } else if (diff < 0) {
+            // the cell still holds an element from the previous lap
+            return false;
+
+        } else {
+            pos = palAtomicLoad32(
+                &ringBuffer->tail,
+                PAL_MEMORY_ORDER_RELAXED);
+        }
+    }
+
+    Uint8* data = (Uint8*)sequence + PAL_RING_CELL_HEADER;
+    memcpy(data, element, ringBuffer->elementSize);
+    palAtomicStore32(
+        sequence,
+        (Int32)((Uint32)pos + 1),
+        PAL_MEMORY_ORDER_RELEASE);
+
+    return true;
+}
+
+static bool popMPMC(
+    PalRingBuffer* ringBuffer,
+    void* outElement)
+{
+    volatile Int32* sequence;
+    Int32 pos = palAtomicLoad32(&ringBuffer->head, PAL_MEMORY_ORDER_RELAXED);
+    for (;;) {
+        sequence = getSequence(ringBuffer, (Uint32)pos);
+        Int32 seq = palAtomicLoad32(sequence, PAL_MEMORY_ORDER_ACQUIRE);
+        Int32 diff = (Int32)((Uint32)seq - ((Uint32)pos + 1));
+
+        if (diff == 0) {
+            if (palAtomicCompareExchange32(
+                    &ringBuffer->head,
+                    &pos,
+                    (Int32)((Uint32)pos + 1),
+                    PAL_MEMORY_ORDER_RELAXED)) {
+                break;
+            }
+
+        } else if (diff < 0) {
+            // empty or the producer has not published the cell yet
+            return false;
+
+        } else {
+            pos = palAtomicLoad32(
+                &ringBuffer->head,
+                PAL_MEMORY_ORDER_RELAXED);
+        }
+    }
+
+    Uint8* data = (Uint8*)sequence + PAL_RING_CELL_HEADER;
+    memcpy(outElement, data, ringBuffer->elementSize);
+
+    // hand the cell to the producer one lap ahead
+    palAtomicStore32(
+        sequence,
+        (Int32)((Uint32)pos + ringBuffer->mask + 1),
+        PAL_MEMORY_ORDER_RELEASE);
+
+    return true;
+}
+
+static inline bool pushElement(
+    PalRingBuffer* ringBuffer,
+    const void* element)
+{
+    if (ringBuffer->type == PAL_RING_BUFFER_SPSC) {
+        return pushSPSC(ringBuffer, element);
+    }
+    return pushMPMC(ringBuffer, element);
+}
+
+static inline bool popElement(
+    PalRingBuffer* ringBuffer,
+    void* outElement)
+{
+    if (ringBuffer->type == PAL_RING_BUFFER_SPSC) {
+        return popSPSC(ringBuffer, outElement);
+    }
+    return popMPMC(ringBuffer, outElement);
+}
+
+static void wakeWaiters(
+    PalRingBuffer* ringBuffer,
+    volatile Int32* waiters,
+    PalCondVar* condVar)
+{
+    // the push or pop before this and the waiter count are a Dekker pair
+    palAtomicThreadFence(PAL_MEMORY_ORDER_SEQ_CST);
+    if (palAtomicLoad32(waiters, PAL_MEMORY_ORDER_RELAXED) == 0) {
+        return;
+    }
+
+    // waiters that time out could swallow a signal, wake all of them
+    palLockMutex(ringBuffer->mutex);
+    palBroadcastCondVar(condVar);
+    palUnlockMutex(ringBuffer->mutex);
+}
+
+static PalResult waitForElement(
+    PalRingBuffer* ringBuffer,
+    bool push,
+    void* element,
+    Uint64 milliseconds)
+{
+    volatile Int32* waiters = &ringBuffer->popWaiters;
+    PalCondVar* condVar = ringBuffer->notEmpty;
+    if (push) {
+        waiters = &ringBuffer->pushWaiters;
+        condVar = ringBuffer->notFull;
+    }
+
+    Uint64 frequency = palGetPerformanceFrequency();
+    Uint64 start = palGetPerformanceCounter();
+    PalResult result = PAL_RESULT_SUCCESS;
+
+    palLockMutex(ringBuffer->mutex);
+    palAtomicFetchAdd32(waiters, 1, PAL_MEMORY_ORDER_SEQ_CST);
+    for (;;) {
+        bool done;
+        if (push) {
+            done = pushElement(ringBuffer, element);
+        } else {
+            done = popElement(ringBuffer, element);
+        }
+
+        if (done) {
+            break;
+        }
+
+        Uint64 wait = PAL_WAIT_INFINITE;
+        if (milliseconds != PAL_WAIT_INFINITE) {
+            Uint64 elapsed = palGetPerformanceCounter() - start;
+            elapsed = elapsed * 1000 / frequency;
+            if (elapsed >= milliseconds) {
+                result = PAL_RESULT_TIMEOUT;
+                break;
+            }
+            wait = milliseconds - elapsed;
+        }
+
+        palWaitCondVarTimeout(condVar, ringBuffer->mutex, wait);
+    }
+
+    palAtomicFetchAdd32(waiters, -1, PAL_MEMORY_ORDER_RELAXED);
+    palUnlockMutex(ringBuffer->mutex);
+    return result;
+}
+
+// ==================================================
+// Public API
+// ==================================================
+
+PalResult PAL_CALL palCreateRingBuffer(
+    const PalRingBufferCreateInfo* info,
+    PalRingBuffer** outRingBuffer)
+{
+    if (!info || !outRingBuffer) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    if (info->allocator) {
+        if (!info->allocator->allocate || !info->allocator->free) {
+            return PAL_RESULT_INVALID_ALLOCATOR;
+        }
+    }
+
+    if (info->type != PAL_RING_BUFFER_SPSC &&
+        info->type != PAL_RING_BUFFER_MPMC) {
+        return PAL_RESULT_INVALID_ARGUMENT;
+    }
+
+    if (info->capacity == 0 || info->capacity > PAL_RING_MAX_CAPACITY) {
+        return PAL_RESULT_INVALID_ARGUMENT;
+    }
+
+    if (info->elementSize == 0) {
+        return PAL_RESULT_INVALID_ARGUMENT;
+    }
+
+    // the sequence scheme needs two cells to tell full from empty
+    Uint32 capacity = 2;
+    while (capacity < info->capacity) {
+        capacity <<= 1;
+    }
+
+    Uint32 stride = info->elementSize;
+    if (info->type == PAL_RING_BUFFER_MPMC) {
+        stride = PAL_RING_CELL_HEADER + info->elementSize;
+        stride = (stride + PAL_RING_CELL_HEADER - 1);
+        stride &= ~(Uint32)(PAL_RING_CELL_HEADER - 1);
+    }
+
+    PalRingBuffer* ringBuffer = palAllocate(
+        info->allocator,
+        sizeof(PalRingBuffer),
+        PAL_RING_CACHE_LINE);
+
+    if (!ringBuffer) {
+        return PAL_RESULT_OUT_OF_MEMORY;
+    }
+
+    memset(ringBuffer, 0, sizeof(PalRingBuffer));
+    ringBuffer->cells = palAllocate(
+        info->allocator,
+        (Uint64)capacity * stride,
+        PAL_RING_CACHE_LINE);
+
+    if (!ringBuffer->cells) {
+        palFree(info->allocator, ringBuffer);
+        return PAL_RESULT_OUT_OF_MEMORY;
+    }
+
+    ringBuffer->allocator = info->allocator;
+    ringBuffer->mask = capacity - 1;
+    ringBuffer->elementSize = info->elementSize;
+    ringBuffer->stride = stride;
+    ringBuffer->type = info->type;
+    ringBuffer->blocking = info->blocking;
+
+    if (info->type == PAL_RING_BUFFER_MPMC) {
+        for (Uint32 i = 0; i < capacity; i++) {
+            *getSequence(ringBuffer, i) = (Int32)i;
+        }
+    }
+
+    // the blocking calls only use the lock to sleep, never to push or pop
+    if (info->blocking) {
+        palInitMutex(&ringBuffer->mutexStorage, nullptr, &ringBuffer->mutex);
+        palInitCondVar(&ringBuffer->notFullStorage, &ringBuffer->notFull);
+        palInitCondVar(&ringBuffer->notEmptyStorage, &ringBuffer->notEmpty);
+    }
+
+    *outRingBuffer = ringBuffer;
+    return PAL_RESULT_SUCCESS;
+}
+
+void PAL_CALL palDestroyRingBuffer(PalRingBuffer* ringBuffer)
+{
+    if (!ringBuffer) {
+        return;
+    }
+
+    if (ringBuffer->blocking) {
+        palDeinitCondVar(ringBuffer->notEmpty);
+        palDeinitCondVar(ringBuffer->notFull);
+        palDeinitMutex(ringBuffer->mutex);
+    }
+
+    palFree(ringBuffer->allocator, ringBuffer->cells);
+    palFree(ringBuffer->allocator, ringBuffer);
+}
+
+bool PAL_CALL palTryPushRingBuffer(
+    PalRingBuffer* ringBuffer,
+    const void* element)
+{
+    if (!ringBuffer || !element) {
+        return false;
+    }
+
+    if (!pushElement(ringBuffer, element)) {
+        return false;
+    }
+
+    if (ringBuffer->blocking) {
+        wakeWaiters(ringBuffer, &ringBuffer->popWaiters, ringBuffer->notEmpty);
+    }
+    return true;
+}
+
+bool PAL_CALL palTryPopRingBuffer(
+    PalRingBuffer* ringBuffer,
+    void* outElement)
+{
+    if (!ringBuffer || !outElement) {
+        return false;
+    }
+
+    if (!popElement(ringBuffer, outElement)) {
+        return false;
+    }
+
+    if (ringBuffer->blocking) {
+        wakeWaiters(ringBuffer, &ringBuffer->pushWaiters, ringBuffer->notFull);
+    }
+    return true;
+}
+
+PalResult PAL_CALL palPushRingBuffer(
+    PalRingBuffer* ringBuffer,
+    const void* element,
+    Uint64 milliseconds)
+{
+    if (!ringBuffer || !element) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    if (!ringBuffer->blocking) {
+        return PAL_RESULT_INVALID_ARGUMENT;
+    }
+
+    if (!pushElement(ringBuffer, element)) {
+        PalResult result = waitForElement(
+            ringBuffer,
+            true,
+            (void*)element,
+            milliseconds);
+
+        if (result != PAL_RESULT_SUCCESS) {
+            return result;
+        }
+    }
+
+    wakeWaiters(ringBuffer, &ringBuffer->popWaiters, ringBuffer->notEmpty);
+    return PAL_RESULT_SUCCESS;
+}
+
+PalResult PAL_CALL palPopRingBuffer(
+    PalRingBuffer* ringBuffer,
+    void* outElement,
+    Uint64 milliseconds)
+{
+    if (!ringBuffer || !outElement) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    if (!ringBuffer->blocking) {
+        return PAL_RESULT_INVALID_ARGUMENT;
+    }
+
+    if (!popElement(ringBuffer, outElement)) {
+        PalResult result = waitForElement(
+            ringBuffer,
+            false,
+            outElement,
+            milliseconds);
+
+        if (result != PAL_RESULT_SUCCESS) {
+            return result;
+        }
+    }
+
+    wakeWaiters(ringBuffer, &ringBuffer->pushWaiters, ringBuffer->notFull);
+    return PAL_RESULT_SUCCESS;
+}
@@ -0,0 +1,1107 @@
+
+/**
+
+Copyright (C) 2025 Nicholas Agbo
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+
+ */
+
+// ==================================================
+// Includes
+// ==================================================
+
+#include "pal/pal_atomic.h"
+#include "pal/pal_thread.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif // WIN32_LEAN_AND_MEAN
+
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif // NOMINMAX
+
+// set unicode
+#ifndef UNICODE
+#define UNICODE
+#endif // UNICODE
+
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif // _WIN32
+
+#include <string.h>
+
+// ==================================================
+// Typedefs, enums and structs
+// ==================================================
+
+// The primitives here are built on palWaitOnAddress() so every platform
+// with a thread backend shares one implementation. Each parks on a single
+// 32 bit word and keeps a waiter count so uncontended calls never enter
+// the OS.
+
+#define PAL_MUTEX_SPIN_COUNT 100
+#define PAL_MUTEX_ADAPTIVE_MIN_SPINS 10
+
+// barrier and latch waits are usually longer than lock holds
+#define PAL_BARRIER_SPIN_COUNT 1000
+
+// precise sleep starts spinning this long before the deadline plus twice
+// the average lateness of recent sleeps, which is capped
+#define PAL_SLEEP_SPIN_NS 50000
+#define PAL_SLEEP_INITIAL_LATENESS_NS 500000
+#define PAL_SLEEP_MAX_LATENESS_NS 4000000
+
+// mutex states
+#define PAL_MUTEX_UNLOCKED 0
+#define PAL_MUTEX_LOCKED 1
+#define PAL_MUTEX_CONTENDED 2
+
+struct PalMutex {
+    const PalAllocator* allocator;
+    volatile Int32 state;
+    Int32 spinCount;
+    volatile Int32 spins; // adaptive spin estimate, read without the lock
+    bool adaptive;
+    bool enableStats;
+    PalMutexStats stats; // updated by the owner
+};
+
+struct PalCondVar {
+    const PalAllocator* allocator;
+    volatile Int32 seq;
+    volatile Int32 waiters;
+};
+
+struct PalSemaphore {
+    const PalAllocator* allocator;
+    volatile Int32 count;   // waiters park here while zero
+    volatile Int32 waiters; // posts skip the wake while zero
+};
+
+struct PalSyncEvent {
+    const PalAllocator* allocator;
+    volatile Int32 signaled; // waiters park here while zero
+    volatile Int32 waiters;
+    bool manualReset;
+};
+
+struct PalBarrier {
+    const PalAllocator* allocator;
+    volatile Int32 arrived;
+    volatile Int32 generation; // waiters park here until the phase ends
+    volatile Int32 waiters;
+    Int32 count;
+    Int32 spinCount;
+};
+
+struct PalLatch {
+    const PalAllocator* allocator;
+    volatile Int32 count; // waiters park here until zero
+    volatile Int32 waiters;
+    Int32 spinCount;
+};
+
+// shared by every thread, lateness comes from the timer not the caller
+static volatile Int64 s_SleepLateness = PAL_SLEEP_INITIAL_LATENESS_NS;
+
+// the public storage types must be able to hold the structs above
+typedef char MutexStorageCheck
+    [sizeof(PalMutexStorage) >= sizeof(PalMutex) ? 1 : -1];
+
+typedef char CondVarStorageCheck
+    [sizeof(PalCondVarStorage) >= sizeof(PalCondVar) ? 1 : -1];
+
+// ==================================================
+// Internal API
+// ==================================================
+
+static inline Int32 getProcessorCount()
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (Int32)info.dwNumberOfProcessors;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (Int32)count : 1;
+#endif // _WIN32
+}
+
+static inline PalResult waitOnWord(
+    volatile Int32* word,
+    Int32 expected,
+    Uint64 milliseconds)
+{
+    return palWaitOnAddress(word, &expected, sizeof(Int32), milliseconds);
+}
+
+static inline Uint64 getDeadline(Uint64 milliseconds)
+{
+    Uint64 frequency = palGetPerformanceFrequency();
+    return palGetPerformanceCounter() + milliseconds * frequency / 1000;
+}
+
+static inline bool getRemainingTime(
+    Uint64 deadline,
+    Uint64* outMilliseconds)
+{
+    // waits that wake up without making progress wait again for the
+    // remaining time. A deadline of zero waits without a limit
+    if (deadline == 0) {
+        *outMilliseconds = PAL_WAIT_INFINITE;
+        return true;
+    }
+
+    Uint64 now = palGetPerformanceCounter();
+    if (now >= deadline) {
+        return false;
+    }
+
+    Uint64 frequency = palGetPerformanceFrequency();
+    *outMilliseconds = ((deadline - now) * 1000 + frequency - 1) / frequency;
+    return true;
+}
+
+static inline Uint64 counterToNanoseconds(
+    Uint64 counter,
+    Uint64 frequency)
+{
+    // split so long durations do not overflow
+    Uint64 seconds = counter / frequency;
+    Uint64 rest = counter % frequency;
+    return seconds * 1000000000ull + rest * 1000000000ull / frequency;
+}
+
+static inline bool tryLockMutex(PalMutex* mutex)
+{
+    Int32 state = PAL_MUTEX_UNLOCKED;
+    return palAtomicCompareExchange32(
+        &mutex->state,
+        &state,
+        PAL_MUTEX_LOCKED,
+        PAL_MEMORY_ORDER_ACQUIRE);
+}
+
+static bool lockMutexContended(
+    PalMutex* mutex,
+    Uint64 deadline)
+{
+    // the contended state tells the owner to wake us on unlock
+    Int32 state = palAtomicExchange32(
+        &mutex->state,
+        PAL_MUTEX_CONTENDED,
+        PAL_MEMORY_ORDER_ACQUIRE);
+
+    Uint64 timeout;
+    while (state != PAL_MUTEX_UNLOCKED) {
+        if (!getRemainingTime(deadline, &timeout)) {
+            // the owner may wake nobody on unlock, that is harmless
+            return false;
+        }
+
+        waitOnWord(&mutex->state, PAL_MUTEX_CONTENDED, timeout);
+        state = palAtomicExchange32(
+            &mutex->state,
+            PAL_MUTEX_CONTENDED,
+            PAL_MEMORY_ORDER_ACQUIRE);
+    }
+    return true;
+}
+
+static bool spinMutex(
+    PalMutex* mutex,
+    Int32 limit,
+    Int32* outSpins)
+{
+    Int32 spins = 0;
+    for (; spins < limit; spins++) {
+        palCpuPause();
+        Int32 state = palAtomicLoad32(&mutex->state, PAL_MEMORY_ORDER_RELAXED);
+        if (state == PAL_MUTEX_UNLOCKED && tryLockMutex(mutex)) {
+            break;
+        }
+    }
+
+    *outSpins = spins;
+    return spins < limit;
+}
+
+static void lockMutexSlow(PalMutex* mutex)
+{
+    Uint64 start = 0;
+    if (mutex->enableStats) {
+        start = palGetPerformanceCounter();
+    }
+
+    // glibc style adaptive spinning: spin a little longer than recent
+    // contended locks needed, never more than the spin count
+    Int32 limit = mutex->spinCount;
+    Int32 estimate = 0;
+    if (mutex->adaptive) {
+        estimate = palAtomicLoad32(&mutex->spins, PAL_MEMORY_ORDER_RELAXED);
+        Int32 max = estimate * 2 + PAL_MUTEX_ADAPTIVE_MIN_SPINS;
+        limit = max < limit ? max : limit;
+    }
+
+    Int32 spins = 0;
+    if (!spinMutex(mutex, limit, &spins)) {
+        lockMutexContended(mutex, 0);
+    }
+
+    // we own the mutex now, so plain stats updates are safe
+    if (mutex->adaptive) {
+        estimate += (spins - estimate) / 8;
+        palAtomicStore32(&mutex->spins, estimate, PAL_MEMORY_ORDER_RELAXED);
+    }
+
+    if (mutex->enableStats) {
+        mutex->stats.acquisitions++;
+        mutex->stats.contentions++;
+        mutex->stats.waitTicks += palGetPerformanceCounter() - start;
+    }
+}
+
+static void initMutex(
+    PalMutex* mutex,
+    const PalMutexCreateInfo* info)
+{
+    memset(mutex, 0, sizeof(PalMutex));
+    mutex->state = PAL_MUTEX_UNLOCKED;
+    mutex->spinCount = PAL_MUTEX_SPIN_COUNT;
+    if (info) {
+        if (info->spinCount) {
+            mutex->spinCount = (Int32)info->spinCount;
+        }
+        mutex->adaptive = info->adaptive;
+        mutex->enableStats = info->enableStats;
+    }
+}
+
+static inline void lockMutex(PalMutex* mutex)
+{
+    if (tryLockMutex(mutex)) {
+        if (mutex->enableStats) {
+            mutex->stats.acquisitions++;
+        }
+        return;
+    }
+    lockMutexSlow(mutex);
+}
+
+static inline void unlockMutex(PalMutex* mutex)
+{
+    Int32 prev = palAtomicExchange32(
+        &mutex->state,
+        PAL_MUTEX_UNLOCKED,
+        PAL_MEMORY_ORDER_RELEASE);
+
+    if (prev == PAL_MUTEX_CONTENDED) {
+        palWakeByAddressSingle(&mutex->state);
+    }
+}
+
+static PalResult waitCondVar(
+    PalCondVar* condVar,
+    PalMutex* mutex,
+    Uint64 milliseconds)
+{
+    palAtomicFetchAdd32(&condVar->waiters, 1, PAL_MEMORY_ORDER_SEQ_CST);
+    Int32 seq = palAtomicLoad32(&condVar->seq, PAL_MEMORY_ORDER_SEQ_CST);
+    unlockMutex(mutex);
+
+    // a signal before we sleep changes seq, so it is not lost
+    PalResult result = waitOnWord(&condVar->seq, seq, milliseconds);
+
+    // relock as contended since other waiters might have been woken with us
+    lockMutexContended(mutex, 0);
+    palAtomicFetchAdd32(&condVar->waiters, -1, PAL_MEMORY_ORDER_RELAXED);
+    return result;
+}
+
+static inline bool tryWaitSemaphore(PalSemaphore* semaphore)
+{
+    Int32 count = palAtomicLoad32(
+        &semaphore->count,
+        PAL_MEMORY_ORDER_RELAXED);
+
+    while (count > 0) {
+        if (palAtomicCompareExchange32(
+                &semaphore->count,
+                &count,
+                count - 1,
+                PAL_MEMORY_ORDER_ACQUIRE)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static PalResult waitSemaphore(
+    PalSemaphore* semaphore,
+    Uint64 deadline)
+{
+    Uint64 timeout;
+    while (!tryWaitSemaphore(semaphore)) {
+        if (!getRemainingTime(deadline, &timeout)) {
+            return PAL_RESULT_TIMEOUT;
+        }
+
+        // pairs with the post incrementing count before reading waiters.
+        // The wait rechecks count, so a post in between is not lost
+        palAtomicFetchAdd32(&semaphore->waiters, 1, PAL_MEMORY_ORDER_SEQ_CST);
+        waitOnWord(&semaphore->count, 0, timeout);
+        palAtomicFetchAdd32(&semaphore->waiters, -1, PAL_MEMORY_ORDER_RELAXED);
+    }
+    return PAL_RESULT_SUCCESS;
+}
+
+static inline bool tryWaitSyncEvent(PalSyncEvent* event)
+{
+    if (event->manualReset) {
+        Int32 signaled = palAtomicLoad32(
+            &event->signaled,
+            PAL_MEMORY_ORDER_ACQUIRE);
+        return signaled != 0;
+    }
+
+    // auto reset events are consumed by the waiter that sees them
+    Int32 signaled = 1;
+    return palAtomicCompareExchange32(
+        &event->signaled,
+        &signaled,
+        0,
+        PAL_MEMORY_ORDER_ACQUIRE);
+}
+
+static PalResult waitSyncEvent(
+    PalSyncEvent* event,
+    Uint64 deadline)
+{
+    Uint64 timeout;
+    while (!tryWaitSyncEvent(event)) {
+        if (!getRemainingTime(deadline, &timeout)) {
+            return PAL_RESULT_TIMEOUT;
+        }
+
+        palAtomicFetchAdd32(&event->waiters, 1, PAL_MEMORY_ORDER_SEQ_CST);
+        waitOnWord(&event->signaled, 0, timeout);
+        palAtomicFetchAdd32(&event->waiters, -1, PAL_MEMORY_ORDER_RELAXED);
+    }
+    return PAL_RESULT_SUCCESS;
+}
+
+// ==================================================
+// Public API
+// ==================================================
+
+// ==================================================
+// Mutex
+// ==================================================
+
+PalResult PAL_CALL palCreateMutex(
+    const PalAllocator* allocator,
+    PalMutex** outMutex)
+{
+    PalMutexCreateInfo info = {0};
+    info.allocator = allocator;
+    return palCreateMutexEx(&info, outMutex);
+}
+
+PalResult PAL_CALL palCreateMutexEx(
+    const PalMutexCreateInfo* info,
+    PalMutex** outMutex)
+{
+    if (!info || !outMutex) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    const PalAllocator* allocator = info->allocator;
+    if (allocator) {
+        if (!allocator->allocate || !allocator->free) {
+            return PAL_RESULT_INVALID_ALLOCATOR;
+        }
+    }
+
+    PalMutex* mutex = palAllocate(allocator, sizeof(PalMutex), 0);
+    if (!mutex) {
+        return PAL_RESULT_OUT_OF_MEMORY;
+    }
+
+    initMutex(mutex, info);
+    mutex->allocator = allocator;
+    *outMutex = mutex;
+    return PAL_RESULT_SUCCESS;
+}
+
+void PAL_CALL palDestroyMutex(PalMutex* mutex)
+{
+    if (mutex) {
+        palFree(mutex->allocator, mutex);
+    }
+}
+
+PalResult PAL_CALL palInitMutex(
+    PalMutexStorage* storage,
+    const PalMutexCreateInfo* info,
+    PalMutex** outMutex)
+{
+    if (!storage || !outMutex) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    // the storage is the mutex, there is nothing to free
+    PalMutex* mutex = (PalMutex*)storage;
+    initMutex(mutex, info);
+    mutex->allocator = nullptr;
+    *outMutex = mutex;
+    return PAL_RESULT_SUCCESS;
+}
+
+void PAL_CALL palDeinitMutex(PalMutex* mutex)
+{
+    if (mutex) {
+        memset(mutex, 0, sizeof(PalMutex));
+    }
+}
+
+void PAL_CALL palLockMutex(PalMutex* mutex)
+{
+    if (mutex) {
+        lockMutex(mutex);
+    }
+}
+
+bool PAL_CALL palTryLockMutex(PalMutex* mutex)
+{
+    if (!mutex) {
+        return false;
+    }
+    return tryLockMutex(mutex);
+}
+
+PalResult PAL_CALL palLockMutexTimeout(
+    PalMutex* mutex,
+    Uint64 milliseconds)
+{
+    if (!mutex) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    if (tryLockMutex(mutex)) {
+        return PAL_RESULT_SUCCESS;
+    }
+
+    if (milliseconds == 0) {
+        return PAL_RESULT_TIMEOUT;
+    }
+
+    // spin like palLockMutex first, waits this short do not need the clock
+    Int32 spins = 0;
+    if (spinMutex(mutex, mutex->spinCount, &spins)) {
+        return PAL_RESULT_SUCCESS;
+    }
+
+    if (!lockMutexContended(mutex, getDeadline(milliseconds))) {
+        return PAL_RESULT_TIMEOUT;
+    }
+    return PAL_RESULT_SUCCESS;
+}
+
+void PAL_CALL palUnlockMutex(PalMutex* mutex)
+{
+    if (mutex) {
+        unlockMutex(mutex);
+    }
+}
+
+PalResult PAL_CALL palGetMutexStats(
+    PalMutex* mutex,
+    PalMutexStats* outStats)
+{
+    if (!mutex || !outStats) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    if (!mutex->enableStats) {
+        return PAL_RESULT_INVALID_ARGUMENT;
+    }
+
+    // not through lockMutex, so reading does not count as an acquisition
+    if (!tryLockMutex(mutex)) {
+        lockMutexContended(mutex, 0);
+    }
+    *outStats = mutex->stats;
+    unlockMutex(mutex);
+    return PAL_RESULT_SUCCESS;
+}
+
+// ==================================================
+// Condition Variable
+// ==================================================
+
+PalResult PAL_CALL palCreateCondVar(
+    const PalAllocator* allocator,
+    PalCondVar** outCondVar)
+{
+    if (!outCondVar) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    if (allocator) {
+        if (!allocator->allocate || !allocator->free) {
+            return PAL_RESULT_INVALID_ALLOCATOR;
+        }
+    }
+
+    PalCondVar* condVar = palAllocate(allocator, sizeof(PalCondVar), 0);
+    if (!condVar) {
+        return PAL_RESULT_OUT_OF_MEMORY;
+    }
+
+    condVar->seq = 0;
+    condVar->waiters = 0;
+    condVar->allocator = allocator;
+    *outCondVar = condVar;
+    return PAL_RESULT_SUCCESS;
+}
+
+void PAL_CALL palDestroyCondVar(PalCondVar* condVar)
+{
+    if (condVar) {
+        palFree(condVar->allocator, condVar);
+    }
+}
+
+PalResult PAL_CALL palInitCondVar(
+    PalCondVarStorage* storage,
+    PalCondVar** outCondVar)
+{
+    if (!storage || !outCondVar) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    PalCondVar* condVar = (PalCondVar*)storage;
+    condVar->seq = 0;
+    condVar->waiters = 0;
+    condVar->allocator = nullptr;
+    *outCondVar = condVar;
+    return PAL_RESULT_SUCCESS;
+}
+
+void PAL_CALL palDeinitCondVar(PalCondVar* condVar)
+{
+    if (condVar) {
+        memset(condVar, 0, sizeof(PalCondVar));
+    }
+}
+
+PalResult PAL_CALL palWaitCondVar(
+    PalCondVar* condVar,
+    PalMutex* mutex)
+{
+    if (!condVar || !mutex) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    return waitCondVar(condVar, mutex, PAL_WAIT_INFINITE);
+}
+
+PalResult PAL_CALL palWaitCondVarTimeout(
+    PalCondVar* condVar,
+    PalMutex* mutex,
+    Uint64 milliseconds)
+{
+    if (!condVar || !mutex) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    return waitCondVar(condVar, mutex, milliseconds);
+}
+
+void PAL_CALL palSignalCondVar(PalCondVar* condVar)
+{
+    if (!condVar) {
+        return;
+    }
+
+    palAtomicFetchAdd32(&condVar->seq, 1, PAL_MEMORY_ORDER_SEQ_CST);
+    if (palAtomicLoad32(&condVar->waiters, PAL_MEMORY_ORDER_SEQ_CST)) {
+        palWakeByAddressSingle(&condVar->seq);
+    }
+}
+
+void PAL_CALL palBroadcastCondVar(PalCondVar* condVar)
+{
+    if (!condVar) {
+        return;
+    }
+
+    palAtomicFetchAdd32(&condVar->seq, 1, PAL_MEMORY_ORDER_SEQ_CST);
+    if (palAtomicLoad32(&condVar->waiters, PAL_MEMORY_ORDER_SEQ_CST)) {
+        palWakeByAddressAll(&condVar->seq);
+    }
+}
+
+// ==================================================
+// Semaphore
+// ==================================================
+
+PalResult PAL_CALL palCreateSemaphore(
+    const PalAllocator* allocator,
+    Uint32 initialCount,
+    PalSemaphore** outSemaphore)
+{
+    if (!outSemaphore) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    if (initialCount > INT32_MAX) {
+        return PAL_RESULT_INVALID_ARGUMENT;
+    }
+
+    if (allocator) {
+        if (!allocator->allocate || !allocator->free) {
+            return PAL_RESULT_INVALID_ALLOCATOR;
+        }
+    }
+
+    PalSemaphore* semaphore = palAllocate(allocator, sizeof(PalSemaphore), 0);
+    if (!semaphore) {
+        return PAL_RESULT_OUT_OF_MEMORY;
+    }
+
+    semaphore->count = (Int32)initialCount;
+    semaphore->waiters = 0;
+    semaphore->allocator = allocator;
+    *outSemaphore = semaphore;
+    return PAL_RESULT_SUCCESS;
+}
+
+void PAL_CALL palDestroySemaphore(PalSemaphore* semaphore)
+{
+    if (semaphore) {
+        palFree(semaphore->allocator, semaphore);
+    }
+}
+
+PalResult PAL_CALL palWaitSemaphore(PalSemaphore* semaphore)
+{
+    if (!semaphore) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+    return waitSemaphore(semaphore, 0);
+}
+
+PalResult PAL_CALL palWaitSemaphoreTimeout(
+    PalSemaphore* semaphore,
+    Uint64 milliseconds)
+{
+    if (!semaphore) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    if (tryWaitSemaphore(semaphore)) {
+        return PAL_RESULT_SUCCESS;
+    }
+
+    if (milliseconds == 0) {
+        return PAL_RESULT_TIMEOUT;
+    }
+
+    return waitSemaphore(semaphore, getDeadline(milliseconds));
+}
+
+PalResult PAL_CALL palPostSemaphore(
+    PalSemaphore* semaphore,
+    Uint32 count)
+{
+    if (!semaphore) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    if (count == 0 || count > INT32_MAX) {
+        return PAL_RESULT_INVALID_ARGUMENT;
+    }
+
+    palAtomicFetchAdd32(
+        &semaphore->count,
+        (Int32)count,
+        PAL_MEMORY_ORDER_SEQ_CST);
+
+    Int32 waiters = palAtomicLoad32(
+        &semaphore->waiters,
+        PAL_MEMORY_ORDER_SEQ_CST);
+
+    if (waiters == 0) {
+        return PAL_RESULT_SUCCESS;
+    }
+
+    // there is no wake for a count, woken waiters that lose the race for
+    // the count park again
+    if (count == 1) {
+        palWakeByAddressSingle(&semaphore->count);
+    } else {
+        palWakeByAddressAll(&semaphore->count);
+    }
+    return PAL_RESULT_SUCCESS;
+}
+
+// ==================================================
+// Sync Event
+// ==================================================
+
+PalResult PAL_CALL palCreateSyncEvent(
+    const PalAllocator* allocator,
+    bool manualReset,
+    bool signaled,
+    PalSyncEvent** outEvent)
+{
+    if (!outEvent) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    if (allocator) {
+        if (!allocator->allocate || !allocator->free) {
+            return PAL_RESULT_INVALID_ALLOCATOR;
+        }
+    }
+
+    PalSyncEvent* event = palAllocate(allocator, sizeof(PalSyncEvent), 0);
+    if (!event) {
+        return PAL_RESULT_OUT_OF_MEMORY;
+    }
+
+    event->signaled = signaled ? 1 : 0;
+    event->waiters = 0;
+    event->manualReset = manualReset;
+    event->allocator = allocator;
+    *outEvent = event;
+    return PAL_RESULT_SUCCESS;
+}
+
+void PAL_CALL palDestroySyncEvent(PalSyncEvent* event)
+{
+    if (event) {
+        palFree(event->allocator, event);
+    }
+}
+
+void PAL_CALL palSetSyncEvent(PalSyncEvent* event)
+{
+    if (!event) {
+        return;
+    }
+
+    Int32 prev = palAtomicExchange32(
+        &event->signaled,
+        1,
+        PAL_MEMORY_ORDER_SEQ_CST);
+
+    if (prev) {
+        return;
+    }
+
+    if (palAtomicLoad32(&event->waiters, PAL_MEMORY_ORDER_SEQ_CST)) {
+        // a woken auto reset waiter that loses the race parks again
+        if (event->manualReset) {
+            palWakeByAddressAll(&event->signaled);
+        } else {
+            palWakeByAddressSingle(&event->signaled);
+        }
+    }
+}
+
+void PAL_CALL palResetSyncEvent(PalSyncEvent* event)
+{
+    if (event) {
+        palAtomicStore32(&event->signaled, 0, PAL_MEMORY_ORDER_RELAXED);
+    }
+}
+
+PalResult PAL_CALL palWaitSyncEvent(PalSyncEvent* event)
+{
+    if (!event) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+    return waitSyncEvent(event, 0);
+}
+
+PalResult PAL_CALL palWaitSyncEventTimeout(
+    PalSyncEvent* event,
+    Uint64 milliseconds)
+{
+    if (!event) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    if (tryWaitSyncEvent(event)) {
+        return PAL_RESULT_SUCCESS;
+    }
+
+    if (milliseconds == 0) {
+        return PAL_RESULT_TIMEOUT;
+    }
+
+    return waitSyncEvent(event, getDeadline(milliseconds));
+}
+
+// ==================================================
+// Barrier
+// ==================================================
+
+PalResult PAL_CALL palCreateBarrier(
+    const PalAllocator* allocator,
+    Uint32 count,
+    PalBarrier** outBarrier)
+{
+    if (!outBarrier) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    if (count == 0 || count > INT32_MAX) {
+        return PAL_RESULT_INVALID_ARGUMENT;
+    }
+
+    if (allocator) {
+        if (!allocator->allocate || !allocator->free) {
+            return PAL_RESULT_INVALID_ALLOCATOR;
+        }
+    }
+
+    PalBarrier* barrier = palAllocate(allocator, sizeof(PalBarrier), 0);
+    if (!barrier) {
+        return PAL_RESULT_OUT_OF_MEMORY;
+    }
+
+    barrier->arrived = 0;
+    barrier->generation = 0;
+    barrier->waiters = 0;
+    barrier->count = (Int32)count;
+
+    // spinning only helps when every thread of a phase can be running
+    barrier->spinCount = 0;
+    if (barrier->count <= getProcessorCount()) {
+        barrier->spinCount = PAL_BARRIER_SPIN_COUNT;
+    }
+
+    barrier->allocator = allocator;
+    *outBarrier = barrier;
+    return PAL_RESULT_SUCCESS;
+}
+
+void PAL_CALL palDestroyBarrier(PalBarrier* barrier)
+{
+    if (barrier) {
+        palFree(barrier->allocator, barrier);
+    }
+}
+
+bool PAL_CALL palWaitBarrier(PalBarrier* barrier)
+{
+    if (!barrier) {
+        return false;
+    }
+
+    Int32 generation = palAtomicLoad32(
+        &barrier->generation,
+        PAL_MEMORY_ORDER_ACQUIRE);
+
+    Int32 arrived = palAtomicFetchAdd32(
+        &barrier->arrived,
+        1,
+        PAL_MEMORY_ORDER_ACQ_REL);
+
+    if (arrived + 1 == barrier->count) {
+        // reset before the next phase can start arriving
+        palAtomicStore32(&barrier->arrived, 0, PAL_MEMORY_ORDER_RELAXED);
+        palAtomicFetchAdd32(&barrier->generation, 1, PAL_MEMORY_ORDER_SEQ_CST);
+        if (palAtomicLoad32(&barrier->waiters, PAL_MEMORY_ORDER_SEQ_CST)) {
+            palWakeByAddressAll(&barrier->generation);
+        }
+        return true;
+    }
+
+    for (Int32 i = 0; i < barrier->spinCount; i++) {
+        Int32 current = palAtomicLoad32(
+            &barrier->generation,
+            PAL_MEMORY_ORDER_ACQUIRE);
+
+        if (current != generation) {
+            return false;
+        }
+        palCpuPause();
+    }
+
+    // one wake releases the whole phase instead of a broadcast per waiter
+    palAtomicFetchAdd32(&barrier->waiters, 1, PAL_MEMORY_ORDER_SEQ_CST);
+    while (palAtomicLoad32(&barrier->generation, PAL_MEMORY_ORDER_ACQUIRE) ==
+           generation) {
+        waitOnWord(&barrier->generation, generation, PAL_WAIT_INFINITE);
+    }
+    palAtomicFetchAdd32(&barrier->waiters, -1, PAL_MEMORY_ORDER_RELAXED);
+    return false;
+}
+
+// ==================================================
+// Latch
+// ==================================================
+
+PalResult PAL_CALL palCreateLatch(
+    const PalAllocator* allocator,
+    Uint32 count,
+    PalLatch** outLatch)
+{
+    if (!outLatch) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    if (count > INT32_MAX) {
+        return PAL_RESULT_INVALID_ARGUMENT;
+    }
+
+    if (allocator) {
+        if (!allocator->allocate || !allocator->free) {
+            return PAL_RESULT_INVALID_ALLOCATOR;
+        }
+    }
+
+    PalLatch* latch = palAllocate(allocator, sizeof(PalLatch), 0);
+    if (!latch) {
+        return PAL_RESULT_OUT_OF_MEMORY;
+    }
+
+    latch->count = (Int32)count;
+    latch->waiters = 0;
+    latch->spinCount = 0;
+    if (getProcessorCount() > 1) {
+        latch->spinCount = PAL_BARRIER_SPIN_COUNT;
+    }
+
+    latch->allocator = allocator;
+    *outLatch = latch;
+    return PAL_RESULT_SUCCESS;
+}
+
+void PAL_CALL palDestroyLatch(PalLatch* latch)
+{
+    if (latch) {
+        palFree(latch->allocator, latch);
+    }
+}
+
+void PAL_CALL palCountDownLatch(
+    PalLatch* latch,
+    Uint32 count)
+{
+    if (!latch || count == 0) {
+        return;
+    }
+
+    Int32 prev = palAtomicFetchAdd32(
+        &latch->count,
+        -(Int32)count,
+        PAL_MEMORY_ORDER_SEQ_CST);
+
+    if (prev == (Int32)count) {
+        if (palAtomicLoad32(&latch->waiters, PAL_MEMORY_ORDER_SEQ_CST)) {
+            palWakeByAddressAll(&latch->count);
+        }
+    }
+}
+
+bool PAL_CALL palTryWaitLatch(PalLatch* latch)
+{
+    if (!latch) {
+        return false;
+    }
+    return palAtomicLoad32(&latch->count, PAL_MEMORY_ORDER_ACQUIRE) == 0;
+}
+
+void PAL_CALL palWaitLatch(PalLatch* latch)
+{
+    if (!latch) {
+        return;
+    }
+
+    for (Int32 i = 0; i < latch->spinCount; i++) {
+        if (palAtomicLoad32(&latch->count, PAL_MEMORY_ORDER_ACQUIRE) == 0) {
+            return;
+        }
+        palCpuPause();
+    }
+
+    palAtomicFetchAdd32(&latch->waiters, 1, PAL_MEMORY_ORDER_SEQ_CST);
+    Int32 count = palAtomicLoad32(&latch->count, PAL_MEMORY_ORDER_ACQUIRE);
+    while (count != 0) {
+        // count downs that do not open the latch make this return early
+        waitOnWord(&latch->count, count, PAL_WAIT_INFINITE);
+        count = palAtomicLoad32(&latch->count, PAL_MEMORY_ORDER_ACQUIRE);
+    }
+    palAtomicFetchAdd32(&latch->waiters, -1, PAL_MEMORY_ORDER_RELAXED);
+}
+
+// ==================================================
+// Precise Sleep
+// ==================================================
+
+void PAL_CALL palPreciseSleepUntil(Uint64 counter)
+{
+    Uint64 frequency = palGetPerformanceFrequency();
+    Uint64 now = palGetPerformanceCounter();
+    while (now < counter) {
+        Int64 lateness;
+        lateness = palAtomicLoad64(&s_SleepLateness, PAL_MEMORY_ORDER_RELAXED);
+
+        Uint64 remaining = counterToNanoseconds(counter - now, frequency);
+        Uint64 margin = (Uint64)lateness * 2 + PAL_SLEEP_SPIN_NS;
+        if (remaining <= margin) {
+            break;
+        }
+
+        // sleep short of the deadline and learn how late the timer is
+        Uint64 request = remaining - margin;
+        palSleepNanoseconds(request);
+        Uint64 after = palGetPerformanceCounter();
+
+        Int64 late = (Int64)counterToNanoseconds(after - now, frequency);
+        late -= (Int64)request;
+        if (late < 0) {
+            late = 0;
+        } else if (late > PAL_SLEEP_MAX_LATENESS_NS) {
+            late = PAL_SLEEP_MAX_LATENESS_NS;
+        }
+
+        // moving average over about eight sleeps
+        lateness += (late - lateness) / 8;
+        palAtomicStore64(
+            &s_SleepLateness,
+            lateness,
+            PAL_MEMORY_ORDER_RELAXED);
+
+        now = after;
+    }
+
+    while (now < counter) {
+        palCpuPause();
+        now = palGetPerformanceCounter();
+    }
+}
@@ -0,0 +1,1696 @@
+
+/**
+
+Copyright (C) 2025 Nicholas Agbo
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+
+ */
+
+// ==================================================
+// Includes
+// ==================================================
+
+// pthread_setname_np, sched_setaffinity and syscall
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif // _GNU_SOURCE
+
+#include "pal/pal_atomic.h"
+#include "pal/pal_thread.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+// fibers switch with hand written assembly on x86-64, others use ucontext
+#if defined(__x86_64__)
+#define PAL_FIBER_ASM 1
+#else
+#define PAL_FIBER_ASM 0
+#include <ucontext.h>
+#endif // __x86_64__
+
+// ==================================================
+// Typedefs, enums and structs
+// ==================================================
+
+#define PAL_THREAD_NAME_SIZE 16
+
+// nice values used for the thread priorities
+#define PAL_NICE_LOW 10
+#define PAL_NICE_NORMAL 0
+#define PAL_NICE_HIGH -5
+
+// scheduling levels are nice values 10 to -10
+#define PAL_NICE_STEP 5
+#define PAL_SCHEDULING_LEVEL_MIN -2
+#define PAL_SCHEDULING_LEVEL_MAX 2
+
+// reader-writer lock state. The low bits count readers
+#define PAL_RWLOCK_WRITER 0x40000000
+#define PAL_RWLOCK_SPIN_COUNT 100
+
+// sysfs topology, a processor has core, L2, L3 and package keys
+#define PAL_SYS_PATH_SIZE 128
+#define PAL_SYS_VALUE_SIZE 32
+#define PAL_SYS_LIST_SIZE 4096
+#define PAL_SYS_MAX_CACHES 8
+#define PAL_TOPOLOGY_KEYS 4
+
+// /proc/self/task/<tid> files, stat fields are counted after the name
+#define PAL_PROC_STAT_SIZE 1024
+#define PAL_PROC_STATUS_SIZE 4096
+#define PAL_STAT_UTIME_FIELD 11
+#define PAL_STAT_STIME_FIELD 12
+#define PAL_STAT_CPU_FIELD 36
+
+#define PAL_DEFAULT_FIBER_STACK_SIZE (256 * 1024)
+
+// populates stack pages without touching them, Linux 5.14
+#ifndef MADV_POPULATE_WRITE
+#define MADV_POPULATE_WRITE 23
+#endif // MADV_POPULATE_WRITE
+
+// a new fiber stack is laid out like one suspended in switchFiberContext()
+#define PAL_FIBER_FRAME_SIZE 8
+#define PAL_FIBER_FRAME_R13 3
+#define PAL_FIBER_FRAME_R12 4
+#define PAL_FIBER_FRAME_RET 7
+#define PAL_FIBER_MXCSR 0x1F80 // all exceptions masked, round to nearest
+#define PAL_FIBER_FPU_CW 0x037F
+
+struct PalThread {
+    pthread_t handle;
+    volatile Int32 tid; // published by the thread when it starts
+    volatile Int32 refs;
+    volatile Int32 exited;
+    bool joined;
+    bool foreign; // not created by PAL, lives in its own TLS
+    const PalAllocator* allocator;
+    PalThreadFn func;
+    void* arg;
+    void* retval; // published by exited
+    Uint64 stackCommit;
+    char name[PAL_THREAD_NAME_SIZE];
+};
+
+struct PalFiber {
+#if PAL_FIBER_ASM
+    void* sp; // stack pointer of a suspended fiber
+#else
+    ucontext_t context;
+#endif // PAL_FIBER_ASM
+    const PalAllocator* allocator;
+    PalFiberFn func;
+    void* arg;
+    PalFiber* previous; // fiber that last switched to this one
+    void* stack;        // mapping with the guard page, nullptr for threads
+    size_t stackSize;
+    bool finished;
+};
+
+struct PalRWLock {
+    const PalAllocator* allocator;
+    volatile Int32 state;
+    volatile Int32 writersWaiting; // new readers back off while non zero
+    volatile Int32 writerSeq;      // writers park here
+    volatile Int32 readersWaiting; // readers park on state
+};
+
+static __thread PalThread* s_CurrentThread = nullptr;
+static __thread PalThread s_ForeignThread;
+static __thread PalFiber* s_CurrentFiber = nullptr;
+
+// ==================================================
+// Internal API
+// ==================================================
+
+static inline long futexWait(
+    volatile Int32* addr,
+    Int32 expected,
+    const struct timespec* timeout)
+{
+    // returns 0 when woken, otherwise -1 with errno set
+    return syscall(
+        SYS_futex,
+        addr,
+        FUTEX_WAIT_PRIVATE,
+        expected,
+        timeout,
+        nullptr,
+        0);
+}
+
+static inline void futexWake(
+    volatile Int32* addr,
+    int count)
+{
+    syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+}
+
+static inline void millisecondsToTimespec(
+    Uint64 milliseconds,
+    struct timespec* ts)
+{
+    ts->tv_sec = (time_t)(milliseconds / 1000);
+    ts->tv_nsec = (long)((milliseconds % 1000) * 1000000);
+}
+
+static inline pid_t getThreadId(PalThread* thread)
+{
+    // the thread publishes its id when it starts running
+    Int32 tid = palAtomicLoad32(&thread->tid, PAL_MEMORY_ORDER_ACQUIRE);
+    while (tid == 0) {
+        futexWait(&thread->tid, 0, nullptr);
+        tid = palAtomicLoad32(&thread->tid, PAL_MEMORY_ORDER_ACQUIRE);
+    }
+    return (pid_t)tid;
+}
+
+static inline bool isThreadAlive(PalThread* thread)
+{
+    if (thread->joined) {
+        return false;
+    }
+    return palAtomicLoad32(&thread->exited, PAL_MEMORY_ORDER_ACQUIRE) == 0;
+}
+
+static void releaseThread(PalThread* thread)
+{
+    // the thread and its creator each hold a reference
+    if (palAtomicFetchAdd32(&thread->refs, -1, PAL_MEMORY_ORDER_ACQ_REL) == 1) {
+        palFree(thread->allocator, thread);
+    }
+}
+
+static void commitStack(Uint64 size)
+{
+    pthread_attr_t attr;
+    if (pthread_getattr_np(pthread_self(), &attr) != 0) {
+        return;
+    }
+
+    void* base = nullptr;
+    size_t stackSize = 0;
+    pthread_attr_getstack(&attr, &base, &stackSize);
+    pthread_attr_destroy(&attr);
+
+    // the stack grows down from base + stackSize
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    if (size > stackSize) {
+        size = stackSize;
+    }
+
+    UintPtr top = ((UintPtr)base + stackSize) & ~(UintPtr)(page - 1);
+    UintPtr bottom = (top - (UintPtr)size) & ~(UintPtr)(page - 1);
+    if (bottom < (UintPtr)base) {
+        bottom = ((UintPtr)base + page - 1) & ~(UintPtr)(page - 1);
+    }
+
+    if (madvise((void*)bottom, top - bottom, MADV_POPULATE_WRITE) == 0) {
+        return;
+    }
+
+    // older kernels, writing a byte back faults the page in and keeps what
+    // the used part of the stack holds
+    for (UintPtr addr = top - page; addr >= bottom; addr -= page) {
+        volatile Uint8* byte = (volatile Uint8*)addr;
+        *byte = *byte;
+    }
+}
+
+static void* threadEntryToLinux(void* arg)
+{
+    PalThread* thread = arg;
+    s_CurrentThread = thread;
+    if (thread->stackCommit) {
+        commitStack(thread->stackCommit);
+    }
+
+    Int32 tid = (Int32)syscall(SYS_gettid);
+    palAtomicStore32(&thread->tid, tid, PAL_MEMORY_ORDER_RELEASE);
+    futexWake(&thread->tid, INT_MAX);
+
+    void* ret = thread->func(thread->arg);
+    thread->retval = ret;
+    palAtomicStore32(&thread->exited, 1, PAL_MEMORY_ORDER_RELEASE);
+    futexWake(&thread->exited, INT_MAX);
+    releaseThread(thread);
+    return ret;
+}
+
+static inline bool tryLockShared(PalRWLock* lock)
+{
+    Int32 state = palAtomicLoad32(&lock->state, PAL_MEMORY_ORDER_RELAXED);
+    while (!(state & PAL_RWLOCK_WRITER) &&
+           !palAtomicLoad32(&lock->writersWaiting, PAL_MEMORY_ORDER_RELAXED)) {
+        if (palAtomicCompareExchange32(
+                &lock->state,
+                &state,
+                state + 1,
+                PAL_MEMORY_ORDER_ACQUIRE)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static inline bool tryLockExclusive(PalRWLock* lock)
+{
+    Int32 state = 0;
+    return palAtomicCompareExchange32(
+        &lock->state,
+        &state,
+        PAL_RWLOCK_WRITER,
+        PAL_MEMORY_ORDER_ACQUIRE);
+}
+
+static inline void parkReader(PalRWLock* lock)
+{
+    // the count is raised before state is read, so an unlock that changes
+    // state after our read either sees us or makes the futex wait fail
+    palAtomicFetchAdd32(&lock->readersWaiting, 1, PAL_MEMORY_ORDER_SEQ_CST);
+    Int32 state = palAtomicLoad32(&lock->state, PAL_MEMORY_ORDER_SEQ_CST);
+    if ((state & PAL_RWLOCK_WRITER) ||
+        palAtomicLoad32(&lock->writersWaiting, PAL_MEMORY_ORDER_SEQ_CST)) {
+        futexWait(&lock->state, state, nullptr);
+    }
+    palAtomicFetchAdd32(&lock->readersWaiting, -1, PAL_MEMORY_ORDER_RELAXED);
+}
+
+static inline void parkWriter(PalRWLock* lock)
+{
+    // writers sleep on their own word so releasing readers wakes one writer
+    Int32 seq = palAtomicLoad32(&lock->writerSeq, PAL_MEMORY_ORDER_SEQ_CST);
+    if (palAtomicLoad32(&lock->state, PAL_MEMORY_ORDER_SEQ_CST) != 0) {
+        futexWait(&lock->writerSeq, seq, nullptr);
+    }
+}
+
+static inline bool wakeWriter(PalRWLock* lock)
+{
+    if (!palAtomicLoad32(&lock->writersWaiting, PAL_MEMORY_ORDER_SEQ_CST)) {
+        return false;
+    }
+
+    palAtomicFetchAdd32(&lock->writerSeq, 1, PAL_MEMORY_ORDER_SEQ_CST);
+    futexWake(&lock->writerSeq, 1);
+    return true;
+}
+
+static bool readSysFile(
+    const char* path,
+    char* buffer,
+    Uint32 size)
+{
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    ssize_t len = read(fd, buffer, size - 1);
+    close(fd);
+    if (len <= 0) {
+        return false;
+    }
+
+    buffer[len] = '\0';
+    return true;
+}
+
+static Uint32 readSysValue(
+    const char* path,
+    Uint32 fallback)
+{
+    // also takes the first cpu of a sorted cpu list
+    char buffer[PAL_SYS_VALUE_SIZE];
+    if (!readSysFile(path, buffer, sizeof(buffer))) {
+        return fallback;
+    }
+
+    if (buffer[0] < '0' || buffer[0] > '9') {
+        return fallback; // -1 for unknown ids
+    }
+    return (Uint32)strtoul(buffer, nullptr, 10);
+}
+
+static bool readCpuList(
+    const char* path,
+    PalCpuSet* set)
+{
+    // lists look like 0-3,8,10-11
+    char buffer[PAL_SYS_LIST_SIZE];
+    if (!readSysFile(path, buffer, sizeof(buffer))) {
+        return false;
+    }
+
+    memset(set, 0, sizeof(PalCpuSet));
+    char* ptr = buffer;
+    while (*ptr >= '0' && *ptr <= '9') {
+        Uint32 first = (Uint32)strtoul(ptr, &ptr, 10);
+        Uint32 last = first;
+        if (*ptr == '-') {
+            last = (Uint32)strtoul(ptr + 1, &ptr, 10);
+        }
+
+        for (Uint32 i = first; i <= last && i < PAL_MAX_CPU_SET_SIZE; i++) {
+            palAddCpuToSet(set, i);
+        }
+
+        if (*ptr != ',') {
+            break;
+        }
+        ptr++;
+    }
+    return true;
+}
+
+static void readCpuCaches(
+    Uint32 cpu,
+    Uint32* outL2,
+    Uint32* outL3)
+{
+    char path[PAL_SYS_PATH_SIZE];
+    char type[PAL_SYS_VALUE_SIZE];
+    for (Uint32 i = 0; i < PAL_SYS_MAX_CACHES; i++) {
+        const char* base = "/sys/devices/system/cpu/cpu%u/cache/index%u/%s";
+        snprintf(path, sizeof(path), base, cpu, i, "type");
+        if (!readSysFile(path, type, sizeof(type))) {
+            break;
+        }
+
+        if (strncmp(type, "Instruction", 11) == 0) {
+            continue;
+        }
+
+        // the first processor sharing the cache names it
+        snprintf(path, sizeof(path), base, cpu, i, "level");
+        Uint32 level = readSysValue(path, 0);
+        snprintf(path, sizeof(path), base, cpu, i, "shared_cpu_list");
+        if (level == 2) {
+            *outL2 = readSysValue(path, *outL2);
+
+        } else if (level == 3) {
+            *outL3 = readSysValue(path, *outL3);
+        }
+    }
+}
+
+static Uint64 findStatusValue(
+    const char* status,
+    const char* key)
+{
+    // lines look like key:\tvalue
+    const char* line = strstr(status, key);
+    if (!line) {
+        return 0;
+    }
+    return strtoull(line + strlen(key), nullptr, 10);
+}
+
+static Uint32 getDenseId(
+    const Uint32* keys,
+    const Uint32* ids,
+    Int32 index,
+    Uint32* next)
+{
+    // ids count up in order of first appearance. Domains with the same
+    // grouping get the same ids, which the cache fallbacks rely on
+    for (Int32 i = 0; i < index; i++) {
+        if (keys[i * PAL_TOPOLOGY_KEYS] == keys[index * PAL_TOPOLOGY_KEYS]) {
+            return ids[i * PAL_TOPOLOGY_KEYS];
+        }
+    }
+    return (*next)++;
+}
+
+#if PAL_FIBER_ASM
+// saves the callee saved registers and the SSE and x87 control words on the
+// current stack, stores the stack pointer in fromSp and resumes toSp
+void palSwitchFiberContext(
+    void** fromSp,
+    void* toSp);
+
+// first return address of a new fiber, calls r13 with r12
+void palStartFiberContext();
+
+__asm__(
+    ".text\n"
+    ".p2align 4\n"
+    ".type palSwitchFiberContext, @function\n"
+    "palSwitchFiberContext:\n"
+    "    pushq %rbp\n"
+    "    pushq %rbx\n"
+    "    pushq %r12\n"
+    "    pushq %r13\n"
+    "    pushq %r14\n"
+    "    pushq %r15\n"
+    "    subq $8, %rsp\n"
+    "    stmxcsr (%rsp)\n"
+    "    fnstcw 4(%rsp)\n"
+    "    movq %rsp, (%rdi)\n"
+    "    movq %rsi, %rsp\n"
+    "    ldmxcsr (%rsp)\n"
+    "    fldcw 4(%rsp)\n"
+    "    addq $8, %rsp\n"
+    "    popq %r15\n"
+    "    popq %r14\n"
+    "    popq %r13\n"
+    "    popq %r12\n"
+    "    popq %rbx\n"
+    "    popq %rbp\n"
+    "    ret\n"
+    ".size palSwitchFiberContext, .-palSwitchFiberContext\n"
+    ".p2align 4\n"
+    ".type palStartFiberContext, @function\n"
+    "palStartFiberContext:\n"
+    "    movq %r12, %rdi\n"
+    "    andq $-16, %rsp\n"
+    "    call *%r13\n"
+    "    ud2\n"
+    ".size palStartFiberContext, .-palStartFiberContext\n");
+#endif // PAL_FIBER_ASM
+
+static inline void switchFiber(
+    PalFiber* from,
+    PalFiber* to)
+{
+#if PAL_FIBER_ASM
+    palSwitchFiberContext(&from->sp, to->sp);
+#else
+    swapcontext(&from->context, &to->context);
+#endif // PAL_FIBER_ASM
+}
+
+static void fiberMain(PalFiber* fiber)
+{
+    fiber->func(fiber->arg);
+
+    // nothing to return to on this stack, go back to whoever ran us last
+    fiber->finished = true;
+    PalFiber* previous = fiber->previous;
+    s_CurrentFiber = previous;
+    switchFiber(fiber, previous);
+}
+
+#if !PAL_FIBER_ASM
+static void fiberEntryToLinux()
+{
+    // makecontext() only passes ints, the switch set the current fiber
+    fiberMain(s_CurrentFiber);
+}
+#endif // PAL_FIBER_ASM
+
+// ==================================================
+// Public API
+// ==================================================
+
+// ==================================================
+// Thread
+// ==================================================
+
+PalResult PAL_CALL palCreateThread(
+    const PalThreadCreateInfo* info,
+    PalThread** outThread)
+{
+    if (!info || !outThread) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    if (info->allocator) {
+        if (!info->allocator->allocate || !info->allocator->free) {
+            return PAL_RESULT_INVALID_ALLOCATOR;
+        }
+    }
+
+    if (info->stack) {
+        if (info->stackSize < (Uint64)PTHREAD_STACK_MIN) {
+            return PAL_RESULT_INVALID_ARGUMENT;
+        }
+
+        if ((UintPtr)info->stack & 15) {
+            return PAL_RESULT_INVALID_ARGUMENT;
+        }
+    }
+
+    PalThread* thread = palAllocate(info->allocator, sizeof(PalThread), 0);
+    if (!thread) {
+        return PAL_RESULT_OUT_OF_MEMORY;
+    }
+
+    memset(thread, 0, sizeof(PalThread));
+    thread->allocator = info->allocator;
+    thread->func = info->entry;
+    thread->arg = info->arg;
+    thread->stackCommit = info->stackCommit;
+    thread->refs = 2;
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    if (info->stack) {
+        // pthread adds no guard to stacks it did not map
+        pthread_attr_setstack(&attr, info->stack, (size_t)info->stackSize);
+
+    } else {
+        if (info->stackSize) {
+            size_t stackSize = (size_t)info->stackSize;
+            if (stackSize < (size_t)PTHREAD_STACK_MIN) {
+                stackSize = (size_t)PTHREAD_STACK_MIN;
+            }
+            pthread_attr_setstacksize(&attr, stackSize);
+        }
+
+        if (info->guardSize) {
+            pthread_attr_setguardsize(&attr, (size_t)info->guardSize);
+        }
+    }
+
+    int ret = pthread_create(
+        &thread->handle,
+        &attr,
+        threadEntryToLinux,
+        thread);
+    pthread_attr_destroy(&attr);
+
+    if (ret != 0) {
+        palFree(info->allocator, thread);
+        if (ret == EAGAIN) {
+            return PAL_RESULT_OUT_OF_MEMORY;
+
+        } else if (ret == EPERM) {
+            return PAL_RESULT_ACCESS_DENIED;
+
+        } else if (ret == EINVAL) {
+            return PAL_RESULT_INVALID_ARGUMENT;
+
+        } else {
+            return PAL_RESULT_PLATFORM_FAILURE;
+        }
+    }
+
+    *outThread = thread;
+    return PAL_RESULT_SUCCESS;
+}
+
+PalResult PAL_CALL palJoinThread(
+    PalThread* thread,
+    void** outRetval)
+{
+    return palJoinThreadTimeout(thread, PAL_WAIT_INFINITE, outRetval);
+}
+
+PalResult PAL_CALL palJoinThreadTimeout(
+    PalThread* thread,
+    Uint64 milliseconds,
+    void** outRetval)
+{
+    if (!thread) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    if (thread->foreign || thread->joined) {
+        return PAL_RESULT_INVALID_THREAD;
+    }
+
+    // wait for the entry function to return, pthread_join() then only
+    // waits for the thread to unwind
+    if (milliseconds != PAL_WAIT_INFINITE) {
+        Uint64 start = palGetPerformanceCounter();
+        Uint64 frequency = palGetPerformanceFrequency();
+        while (!palAtomicLoad32(&thread->exited, PAL_MEMORY_ORDER_ACQUIRE)) {
+            Uint64 ticks = palGetPerformanceCounter() - start;
+            Uint64 elapsed = ticks * 1000 / frequency;
+            if (elapsed >= milliseconds) {
+                return PAL_RESULT_TIMEOUT;
+            }
+
+            struct timespec ts;
+            millisecondsToTimespec(milliseconds - elapsed, &ts);
+            futexWait(&thread->exited, 0, &ts);
+        }
+    }
+
+    if (pthread_join(thread->handle, nullptr) != 0) {
+        return PAL_RESULT_INVALID_THREAD;
+    }
+
+    thread->joined = true;
+    if (outRetval) {
+        *outRetval = thread->retval;
+    }
+    return PAL_RESULT_SUCCESS;
+}
+
+void PAL_CALL palDetachThread(PalThread* thread)
+{
+    if (!thread || thread->foreign) {
+        return;
+    }
+
+    if (!thread->joined) {
+        pthread_detach(thread->handle);
+    }
+    releaseThread(thread);
+}
+
+void PAL_CALL palSleep(Uint64 milliseconds)
+{
+    struct timespec ts;
+    millisecondsToTimespec(milliseconds, &ts);
+    while (nanosleep(&ts, &ts) == -1 && errno == EINTR) {
+        // sleep the remaining time if a signal woke us
+    }
+}
+
+void PAL_CALL palSleepNanoseconds(Uint64 nanoseconds)
+{
+    // an absolute deadline so signals do not stretch the sleep
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    Uint64 nsec = (Uint64)ts.tv_nsec + nanoseconds % 1000000000ull;
+    ts.tv_sec += (time_t)(nanoseconds / 1000000000ull + nsec / 1000000000ull);
+    ts.tv_nsec = (long)(nsec % 1000000000ull);
+
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) ==
+           EINTR) {
+        // sleep the remaining time if a signal woke us
+    }
+}
+
+void PAL_CALL palYield()
+{
+    sched_yield();
+}
+
+PalThread* PAL_CALL palGetCurrentThread()
+{
+    if (s_CurrentThread) {
+        return s_CurrentThread;
+    }
+
+    // threads not created by PAL get a handle in their own TLS
+    PalThread* thread = &s_ForeignThread;
+    thread->handle = pthread_self();
+    thread->tid = (Int32)syscall(SYS_gettid);
+    thread->refs = 1;
+    thread->foreign = true;
+    s_CurrentThread = thread;
+    return thread;
+}
+
+PalThreadFeatures PAL_CALL palGetThreadFeatures()
+{
+    PalThreadFeatures features = 0;
+    features |= PAL_THREAD_FEATURE_STACK_SIZE;
+    features |= PAL_THREAD_FEATURE_PRIORITY;
+    features |= PAL_THREAD_FEATURE_AFFINITY;
+    features |= PAL_THREAD_FEATURE_NAME;
+    features |= PAL_THREAD_FEATURE_CUSTOM_STACK;
+    return features;
+}
+
+PalThreadPriority PAL_CALL palGetThreadPriority(PalThread* thread)
+{
+    if (!thread || !isThreadAlive(thread)) {
+        return 0;
+    }
+
+    // threads under SCHED_OTHER are prioritized with per thread nice values
+    errno = 0;
+    int nice = getpriority(PRIO_PROCESS, (id_t)getThreadId(thread));
+    if (nice == -1 && errno != 0) {
+        return 0;
+    }
+
+    if (nice >= PAL_NICE_LOW) {
+        return PAL_THREAD_PRIORITY_LOW;
+
+    } else if (nice <= PAL_NICE_HIGH) {
+        return PAL_THREAD_PRIORITY_HIGH;
+    }
+    return PAL_THREAD_PRIORITY_NORMAL;
+}
+
+Uint64 PAL_CALL palGetThreadAffinity(PalThread* thread)
+{
+    if (!thread || !isThreadAlive(thread)) {
+        return 0;
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    pid_t tid = getThreadId(thread);
+    if (sched_getaffinity(tid, sizeof(cpu_set_t), &set) != 0) {
+        return 0;
+    }
+
+    Uint64 mask = 0;
+    for (Int32 i = 0; i < 64; i++) {
+        if (CPU_ISSET(i, &set)) {
+            mask |= 1ull << i;
+        }
+    }
+    return mask;
+}
+
+PalResult PAL_CALL palGetThreadName(
+    PalThread* thread,
+    Uint64 bufferSize,
+    Uint64* outSize,
+    char* outBuffer)
+{
+    if (!thread) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    // a name that was set is kept after the thread has finished
+    char name[PAL_THREAD_NAME_SIZE] = {0};
+    if (thread->name[0]) {
+        memcpy(name, thread->name, PAL_THREAD_NAME_SIZE);
+
+    } else if (isThreadAlive(thread)) {
+        if (pthread_getname_np(thread->handle, name, sizeof(name)) != 0) {
+            return PAL_RESULT_INVALID_THREAD;
+        }
+    }
+
+    Uint64 len = strlen(name);
+    if (outSize) {
+        *outSize = len;
+    }
+
+    // see if user provided a buffer and write to it
+    if (outBuffer && bufferSize > 0) {
+        Uint64 write = bufferSize - 1 < len ? bufferSize - 1 : len;
+        memcpy(outBuffer, name, write);
+        outBuffer[write] = '\0';
+    }
+
+    return PAL_RESULT_SUCCESS;
+}
+
+PalResult PAL_CALL palSetThreadPriority(
+    PalThread* thread,
+    PalThreadPriority priority)
+{
+    if (!thread) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    if (!isThreadAlive(thread)) {
+        return PAL_RESULT_INVALID_THREAD;
+    }
+
+    int nice = PAL_NICE_NORMAL;
+    switch (priority) {
+        case PAL_THREAD_PRIORITY_LOW:
+            nice = PAL_NICE_LOW;
+            break;
+
+        case PAL_THREAD_PRIORITY_NORMAL:
+            nice = PAL_NICE_NORMAL;
+            break;
+
+        case PAL_THREAD_PRIORITY_HIGH:
+            nice = PAL_NICE_HIGH;
+            break;
+
+        default:
+            return PAL_RESULT_INVALID_ARGUMENT;
+    }
+
+    pid_t tid = getThreadId(thread);
+    if (setpriority(PRIO_PROCESS, (id_t)tid, nice) != 0) {
+        if (errno == EACCES || errno == EPERM) {
+            return PAL_RESULT_ACCESS_DENIED;
+
+        } else if (errno == ESRCH) {
+            return PAL_RESULT_INVALID_THREAD;
+
+        } else {
+            return PAL_RESULT_PLATFORM_FAILURE;
+        }
+    }
+
+    return PAL_RESULT_SUCCESS;
+}
+
+PalResult PAL_CALL palGetThreadScheduling(
+    PalThread* thread,
+    PalThreadScheduling* outScheduling)
+{
+    if (!thread || !outScheduling) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    if (!isThreadAlive(thread)) {
+        return PAL_RESULT_INVALID_THREAD;
+    }
+
+    pid_t tid = getThreadId(thread);
+    int policy = sched_getscheduler(tid);
+    if (policy == -1) {
+        if (errno == ESRCH) {
+            return PAL_RESULT_INVALID_THREAD;
+        }
+        return PAL_RESULT_PLATFORM_FAILURE;
+    }
+
+    memset(outScheduling, 0, sizeof(PalThreadScheduling));
+    if (policy == SCHED_FIFO || policy == SCHED_RR) {
+        struct sched_param param;
+        if (sched_getparam(tid, &param) != 0) {
+            return PAL_RESULT_PLATFORM_FAILURE;
+        }
+
+        outScheduling->level = param.sched_priority;
+        if (policy == SCHED_FIFO) {
+            outScheduling->policy = PAL_SCHEDULING_POLICY_REALTIME_FIFO;
+        } else {
+            outScheduling->policy = PAL_SCHEDULING_POLICY_REALTIME_RR;
+        }
+
+    } else if (policy == SCHED_IDLE) {
+        outScheduling->policy = PAL_SCHEDULING_POLICY_IDLE;
+
+    } else {
+        // the closest level, nice values between them are not set by PAL
+        errno = 0;
+        int nice = getpriority(PRIO_PROCESS, (id_t)tid);
+        if (nice == -1 && errno != 0) {
+            return PAL_RESULT_PLATFORM_FAILURE;
+        }
+
+        Int32 level;
+        if (nice >= 0) {
+            level = -((nice + PAL_NICE_STEP / 2) / PAL_NICE_STEP);
+        } else {
+            level = (-nice + PAL_NICE_STEP / 2) / PAL_NICE_STEP;
+        }
+
+        if (level < PAL_SCHEDULING_LEVEL_MIN) {
+            level = PAL_SCHEDULING_LEVEL_MIN;
+        } else if (level > PAL_SCHEDULING_LEVEL_MAX) {
+            level = PAL_SCHEDULING_LEVEL_MAX;
+        }
+
+        outScheduling->policy = PAL_SCHEDULING_POLICY_NORMAL;
+        outScheduling->level = level;
+    }
+
+    return PAL_RESULT_SUCCESS;
+}
+
+PalResult PAL_CALL palSetThreadScheduling(
+    PalThread* thread,
+    const PalThreadScheduling* scheduling)
+{
+    if (!thread || !scheduling) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    if (!isThreadAlive(thread)) {
+        return PAL_RESULT_INVALID_THREAD;
+    }
+
+    int policy = SCHED_OTHER;
+    int nice = 0;
+    struct sched_param param = {0};
+    switch (scheduling->policy) {
+        case PAL_SCHEDULING_POLICY_IDLE:
+            policy = SCHED_IDLE;
+            break;
+
+        case PAL_SCHEDULING_POLICY_NORMAL: {
+            Int32 level = scheduling->level;
+            if (level < PAL_SCHEDULING_LEVEL_MIN ||
+                level > PAL_SCHEDULING_LEVEL_MAX) {
+                return PAL_RESULT_INVALID_ARGUMENT;
+            }
+            nice = -level * PAL_NICE_STEP;
+            break;
+        }
+
+        case PAL_SCHEDULING_POLICY_REALTIME_FIFO:
+        case PAL_SCHEDULING_POLICY_REALTIME_RR: {
+            policy = SCHED_FIFO;
+            if (scheduling->policy == PAL_SCHEDULING_POLICY_REALTIME_RR) {
+                policy = SCHED_RR;
+            }
+
+            int min = sched_get_priority_min(policy);
+            int max = sched_get_priority_max(policy);
+            param.sched_priority = scheduling->level;
+            if (param.sched_priority < min) {
+                param.sched_priority = min;
+            } else if (param.sched_priority > max) {
+                param.sched_priority = max;
+            }
+            break;
+        }
+
+        default:
+            return PAL_RESULT_INVALID_ARGUMENT;
+    }
+
+    // the nice value is kept under every policy, set it first so a thread
+    // that may not raise it keeps its old scheduling
+    pid_t tid = getThreadId(thread);
+    if (policy == SCHED_OTHER) {
+        if (setpriority(PRIO_PROCESS, (id_t)tid, nice) != 0) {
+            if (errno == EACCES || errno == EPERM) {
+                return PAL_RESULT_ACCESS_DENIED;
+            }
+            return PAL_RESULT_PLATFORM_FAILURE;
+        }
+    }
+
+    // a tid sets the policy of that thread only
+    if (sched_setscheduler(tid, policy, &param) != 0) {
+        if (errno == EPERM) {
+            return PAL_RESULT_ACCESS_DENIED;
+
+        } else if (errno == ESRCH) {
+            return PAL_RESULT_INVALID_THREAD;
+
+        } else if (errno == EINVAL) {
+            return PAL_RESULT_INVALID_ARGUMENT;
+
+        } else {
+            return PAL_RESULT_PLATFORM_FAILURE;
+        }
+    }
+
+    return PAL_RESULT_SUCCESS;
+}
+
+PalResult PAL_CALL palGetThreadStats(
+    PalThread* thread,
+    PalThreadStats* outStats)
+{
+    if (!thread || !outStats) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    if (!isThreadAlive(thread)) {
+        return PAL_RESULT_INVALID_THREAD;
+    }
+
+    pid_t tid = getThreadId(thread);
+    char path[PAL_SYS_PATH_SIZE];
+    char stat[PAL_PROC_STAT_SIZE];
+    snprintf(path, sizeof(path), "/proc/self/task/%d/stat", (int)tid);
+    if (!readSysFile(path, stat, sizeof(stat))) {
+        return PAL_RESULT_INVALID_THREAD;
+    }
+
+    // the name can contain spaces, the fields start after its parenthesis
+    char* field = strrchr(stat, ')');
+    if (!field) {
+        return PAL_RESULT_PLATFORM_FAILURE;
+    }
+
+    Uint64 values[PAL_STAT_CPU_FIELD + 1] = {0};
+    for (Int32 i = 0; i <= PAL_STAT_CPU_FIELD && field; i++) {
+        field = strchr(field + 1, ' ');
+        if (field) {
+            values[i] = strtoull(field + 1, nullptr, 10);
+        }
+    }
+
+    if (!field) {
+        return PAL_RESULT_PLATFORM_FAILURE;
+    }
+
+    memset(outStats, 0, sizeof(PalThreadStats));
+    Uint64 tick = 1000000000ull / (Uint64)sysconf(_SC_CLK_TCK);
+    outStats->userTime = values[PAL_STAT_UTIME_FIELD] * tick;
+    outStats->kernelTime = values[PAL_STAT_STIME_FIELD] * tick;
+    outStats->cpu = (Int32)values[PAL_STAT_CPU_FIELD];
+    if (thread == s_CurrentThread) {
+        outStats->cpu = sched_getcpu();
+    }
+
+    char status[PAL_PROC_STATUS_SIZE];
+    snprintf(path, sizeof(path), "/proc/self/task/%d/status", (int)tid);
+    if (!readSysFile(path, status, sizeof(status))) {
+        return PAL_RESULT_INVALID_THREAD;
+    }
+
+    outStats->voluntarySwitches = findStatusValue(
+        status,
+        "\nvoluntary_ctxt_switches:");
+
+    outStats->involuntarySwitches = findStatusValue(
+        status,
+        "\nnonvoluntary_ctxt_switches:");
+
+    outStats->contextSwitches = outStats->voluntarySwitches;
+    outStats->contextSwitches += outStats->involuntarySwitches;
+    return PAL_RESULT_SUCCESS;
+}
+
+PalResult PAL_CALL palSetThreadAffinity(
+    PalThread* thread,
+    Uint64 mask)
+{
+    if (!thread) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    if (!isThreadAlive(thread)) {
+        return PAL_RESULT_INVALID_THREAD;
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (Int32 i = 0; i < 64; i++) {
+        if (mask & (1ull << i)) {
+            CPU_SET(i, &set);
+        }
+    }
+
+    pid_t tid = getThreadId(thread);
+    if (sched_setaffinity(tid, sizeof(cpu_set_t), &set) != 0) {
+        if (errno == EINVAL) {
+            return PAL_RESULT_INVALID_ARGUMENT;
+
+        } else if (errno == ESRCH) {
+            return PAL_RESULT_INVALID_THREAD;
+
+        } else if (errno == EPERM) {
+            return PAL_RESULT_ACCESS_DENIED;
+
+        } else {
+            return PAL_RESULT_PLATFORM_FAILURE;
+        }
+    }
+
+    return PAL_RESULT_SUCCESS;
+}
+
+PalResult PAL_CALL palSetThreadName(
+    PalThread* thread,
+    const char* name)
+{
+    if (!thread || !name) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    // Linux limits names to 16 bytes including the null terminator
+    memset(thread->name, 0, PAL_THREAD_NAME_SIZE);
+    strncpy(thread->name, name, PAL_THREAD_NAME_SIZE - 1);
+
+    if (isThreadAlive(thread)) {
+        int ret = pthread_setname_np(thread->handle, thread->name);
+        if (ret == ERANGE) {
+            return PAL_RESULT_INVALID_ARGUMENT;
+        }
+        // the thread might have exited since, the name is still kept
+    }
+
+    return PAL_RESULT_SUCCESS;
+}
+
+// ==================================================
+// CPU Topology
+// ==================================================
+
+PalResult PAL_CALL palEnumerateLogicalProcessors(
+    const PalAllocator* allocator,
+    Int32* count,
+    PalLogicalProcessor* processors)
+{
+    if (!count) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    if (allocator && (!allocator->allocate || !allocator->free)) {
+        return PAL_RESULT_INVALID_ALLOCATOR;
+    }
+
+    PalCpuSet online;
+    if (!readCpuList("/sys/devices/system/cpu/online", &online)) {
+        return PAL_RESULT_PLATFORM_FAILURE;
+    }
+
+    Int32 total = 0;
+    for (Uint32 i = 0; i < PAL_MAX_CPU_SET_SIZE; i++) {
+        total += palIsCpuInSet(&online, i);
+    }
+
+    if (!processors) {
+        *count = total;
+        return PAL_RESULT_SUCCESS;
+    }
+
+    // core, L2, L3 and package keys of every processor, then their ids.
+    // Every processor is read since ids depend on the ones before
+    Uint64 size = sizeof(Uint32) * PAL_TOPOLOGY_KEYS * total * 2;
+    Uint32* keys = palAllocate(allocator, size, 0);
+    if (!keys) {
+        return PAL_RESULT_OUT_OF_MEMORY;
+    }
+    Uint32* ids = keys + PAL_TOPOLOGY_KEYS * total;
+
+    Int32 written = total < *count ? total : *count;
+    char path[PAL_SYS_PATH_SIZE];
+    Int32 index = 0;
+    for (Uint32 cpu = 0; cpu < PAL_MAX_CPU_SET_SIZE; cpu++) {
+        if (!palIsCpuInSet(&online, cpu)) {
+            continue;
+        }
+
+        const char* base = "/sys/devices/system/cpu/cpu%u/topology/%s";
+        Uint32* key = &keys[index * PAL_TOPOLOGY_KEYS];
+        snprintf(path, sizeof(path), base, cpu, "thread_siblings_list");
+        key[0] = readSysValue(path, cpu);
+        snprintf(path, sizeof(path), base, cpu, "physical_package_id");
+        key[3] = readSysValue(path, 0);
+
+        // unreported caches group like the core and package
+        key[1] = key[0];
+        key[2] = key[3] + PAL_MAX_CPU_SET_SIZE;
+        readCpuCaches(cpu, &key[1], &key[2]);
+
+        if (index < written) {
+            processors[index].index = cpu;
+        }
+        index++;
+    }
+
+    Uint32 next[PAL_TOPOLOGY_KEYS] = {0};
+    for (Int32 i = 0; i < total; i++) {
+        for (Int32 j = 0; j < PAL_TOPOLOGY_KEYS; j++) {
+            ids[i * PAL_TOPOLOGY_KEYS + j] =
+                getDenseId(keys + j, ids + j, i, &next[j]);
+        }
+    }
+
+    for (Int32 i = 0; i < written; i++) {
+        Uint32* id = &ids[i * PAL_TOPOLOGY_KEYS];
+        processors[i].core = id[0];
+        processors[i].cacheL2 = id[1];
+        processors[i].cacheL3 = id[2];
+        processors[i].package = id[3];
+        processors[i].numaNode = 0;
+    }
+    palFree(allocator, keys);
+
+    // NUMA nodes keep the kernel numbers. No node directory means no NUMA
+    PalCpuSet nodes;
+    if (!readCpuList("/sys/devices/system/node/online", &nodes)) {
+        return PAL_RESULT_SUCCESS;
+    }
+
+    for (Uint32 node = 0; node < PAL_MAX_CPU_SET_SIZE; node++) {
+        PalCpuSet cpus;
+        const char* base = "/sys/devices/system/node/node%u/cpulist";
+        snprintf(path, sizeof(path), base, node);
+        if (!palIsCpuInSet(&nodes, node) || !readCpuList(path, &cpus)) {
+            continue;
+        }
+
+        for (Int32 i = 0; i < written; i++) {
+            if (palIsCpuInSet(&cpus, processors[i].index)) {
+                processors[i].numaNode = node;
+            }
+        }
+    }
+
+    return PAL_RESULT_SUCCESS;
+}
+
+PalResult PAL_CALL palGetThreadCpuSet(
+    PalThread* thread,
+    PalCpuSet* outSet)
+{
+    if (!thread || !outSet) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    if (!isThreadAlive(thread)) {
+        return PAL_RESULT_INVALID_THREAD;
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    pid_t tid = getThreadId(thread);
+    if (sched_getaffinity(tid, sizeof(cpu_set_t), &set) != 0) {
+        if (errno == ESRCH) {
+            return PAL_RESULT_INVALID_THREAD;
+        }
+        return PAL_RESULT_PLATFORM_FAILURE;
+    }
+
+    memset(outSet, 0, sizeof(PalCpuSet));
+    for (Uint32 i = 0; i < PAL_MAX_CPU_SET_SIZE && i < CPU_SETSIZE; i++) {
+        if (CPU_ISSET(i, &set)) {
+            palAddCpuToSet(outSet, i);
+        }
+    }
+    return PAL_RESULT_SUCCESS;
+}
+
+PalResult PAL_CALL palSetThreadCpuSet(
+    PalThread* thread,
+    const PalCpuSet* set)
+{
+    if (!thread || !set) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    if (!isThreadAlive(thread)) {
+        return PAL_RESULT_INVALID_THREAD;
+    }
+
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    for (Uint32 i = 0; i < PAL_MAX_CPU_SET_SIZE && i < CPU_SETSIZE; i++) {
+        if (palIsCpuInSet(set, i)) {
+            CPU_SET(i, &cpus);
+        }
+    }
+
+    pid_t tid = getThreadId(thread);
+    if (sched_setaffinity(tid, sizeof(cpu_set_t), &cpus) != 0) {
+        if (errno == EINVAL) {
+            return PAL_RESULT_INVALID_ARGUMENT;
+
+        } else if (errno == ESRCH) {
+            return PAL_RESULT_INVALID_THREAD;
+
+        } else if (errno == EPERM) {
+            return PAL_RESULT_ACCESS_DENIED;
+
+        } else {
+            return PAL_RESULT_PLATFORM_FAILURE;
+        }
+    }
+
+    return PAL_RESULT_SUCCESS;
+}
+
+// ==================================================
+// TLS
+// ==================================================
+
+PalTLSId PAL_CALL palCreateTLS(PaTlsDestructorFn destructor)
+{
+    // keys start at 0, but 0 is reserved for failure
+    pthread_key_t key;
+    if (pthread_key_create(&key, destructor) != 0) {
+        return 0;
+    }
+    return (PalTLSId)key + 1;
+}
+
+void PAL_CALL palDestroyTLS(PalTLSId id)
+{
+    if (id) {
+        pthread_key_delete((pthread_key_t)(id - 1));
+    }
+}
+
+void* PAL_CALL palGetTLS(PalTLSId id)
+{
+    if (!id) {
+        return nullptr;
+    }
+    return pthread_getspecific((pthread_key_t)(id - 1));
+}
+
+void PAL_CALL palSetTLS(
+    PalTLSId id,
+    void* data)
+{
+    if (id) {
+        pthread_setspecific((pthread_key_t)(id - 1), data);
+    }
+}
+
+// ==================================================
+// Fiber
+// ==================================================
+
+PalResult PAL_CALL palConvertThreadToFiber(
+    const PalAllocator* allocator,
+    PalFiber** outFiber)
+{
+    if (!outFiber) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    if (allocator && (!allocator->allocate || !allocator->free)) {
+        return PAL_RESULT_INVALID_ALLOCATOR;
+    }
+
+    if (s_CurrentFiber) {
+        return PAL_RESULT_INVALID_THREAD;
+    }
+
+    // the thread keeps its own stack, the context is saved on the first
+    // switch away
+    PalFiber* fiber = palAllocate(allocator, sizeof(PalFiber), 0);
+    if (!fiber) {
+        return PAL_RESULT_OUT_OF_MEMORY;
+    }
+
+    memset(fiber, 0, sizeof(PalFiber));
+    fiber->allocator = allocator;
+    s_CurrentFiber = fiber;
+    *outFiber = fiber;
+    return PAL_RESULT_SUCCESS;
+}
+
+PalResult PAL_CALL palConvertFiberToThread()
+{
+    PalFiber* fiber = s_CurrentFiber;
+    if (!fiber || fiber->stack) {
+        return PAL_RESULT_INVALID_THREAD;
+    }
+
+    s_CurrentFiber = nullptr;
+    palFree(fiber->allocator, fiber);
+    return PAL_RESULT_SUCCESS;
+}
+
+PalResult PAL_CALL palCreateFiber(
+    const PalFiberCreateInfo* info,
+    PalFiber** outFiber)
+{
+    if (!info || !outFiber) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    if (!info->entry) {
+        return PAL_RESULT_INVALID_ARGUMENT;
+    }
+
+    if (info->allocator) {
+        if (!info->allocator->allocate || !info->allocator->free) {
+            return PAL_RESULT_INVALID_ALLOCATOR;
+        }
+    }
+
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t stackSize = PAL_DEFAULT_FIBER_STACK_SIZE;
+    if (info->stackSize) {
+        stackSize = (size_t)info->stackSize;
+        if (stackSize < (size_t)PTHREAD_STACK_MIN) {
+            stackSize = (size_t)PTHREAD_STACK_MIN;
+        }
+    }
+    stackSize = (stackSize + page - 1) & ~(page - 1);
+
+    PalFiber* fiber = palAllocate(info->allocator, sizeof(PalFiber), 0);
+    if (!fiber) {
+        return PAL_RESULT_OUT_OF_MEMORY;
+    }
+
+    // the lowest page stays inaccessible to catch overflows
+    memset(fiber, 0, sizeof(PalFiber));
+    fiber->stackSize = stackSize + page;
+    fiber->stack = mmap(
+        nullptr,
+        fiber->stackSize,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK,
+        -1,
+        0);
+
+    if (fiber->stack == MAP_FAILED) {
+        palFree(info->allocator, fiber);
+        return PAL_RESULT_OUT_OF_MEMORY;
+    }
+
+    if (mprotect(fiber->stack, page, PROT_NONE) != 0) {
+        munmap(fiber->stack, fiber->stackSize);
+        palFree(info->allocator, fiber);
+        return PAL_RESULT_PLATFORM_FAILURE;
+    }
+
+    fiber->allocator = info->allocator;
+    fiber->func = info->entry;
+    fiber->arg = info->arg;
+
+#if PAL_FIBER_ASM
+    // the first switch pops this frame and returns into the start routine
+    Uint8* top = (Uint8*)fiber->stack + fiber->stackSize;
+    void** frame = (void**)(top - 16) - PAL_FIBER_FRAME_RET;
+    memset(frame, 0, sizeof(void*) * PAL_FIBER_FRAME_SIZE);
+
+    Uint32* controlWords = (Uint32*)frame;
+    controlWords[0] = PAL_FIBER_MXCSR;
+    controlWords[1] = PAL_FIBER_FPU_CW;
+    frame[PAL_FIBER_FRAME_R13] = (void*)fiberMain;
+    frame[PAL_FIBER_FRAME_R12] = fiber;
+    frame[PAL_FIBER_FRAME_RET] = (void*)palStartFiberContext;
+    fiber->sp = frame;
+#else
+    if (getcontext(&fiber->context) != 0) {
+        munmap(fiber->stack, fiber->stackSize);
+        palFree(info->allocator, fiber);
+        return PAL_RESULT_PLATFORM_FAILURE;
+    }
+
+    fiber->context.uc_stack.ss_sp = (Uint8*)fiber->stack + page;
+    fiber->context.uc_stack.ss_size = stackSize;
+    fiber->context.uc_link = nullptr;
+    makecontext(&fiber->context, fiberEntryToLinux, 0);
+#endif // PAL_FIBER_ASM
+
+    *outFiber = fiber;
+    return PAL_RESULT_SUCCESS;
+}
+
+void PAL_CALL palDestroyFiber(PalFiber* fiber)
+{
+    if (!fiber || !fiber->stack) {
+        return;
+    }
+
+    munmap(fiber->stack, fiber->stackSize);
+    palFree(fiber->allocator, fiber);
+}
+
+void PAL_CALL palSwitchToFiber(PalFiber* fiber)
+{
+    PalFiber* current = s_CurrentFiber;
+    if (!fiber || !current || fiber == current) {
+        return;
+    }
+
+    // the fiber we switch to reads nothing thread local before running, so
+    // a fiber can be resumed on another thread
+    fiber->previous = current;
+    s_CurrentFiber = fiber;
+    switchFiber(current, fiber);
+}
+
+PalFiber* PAL_CALL palGetCurrentFiber()
+{
+    return s_CurrentFiber;
+}
+
+// ==================================================
+// Wait On Address
+// ==================================================
+
+PalResult PAL_CALL palWaitOnAddress(
+    volatile void* address,
+    const void* compareAddress,
+    Uint32 size,
+    Uint64 milliseconds)
+{
+    if (!address || !compareAddress) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    // futex words are always 32 bit
+    if (size != sizeof(Int32) || ((uintptr_t)address & 3)) {
+        return PAL_RESULT_INVALID_ARGUMENT;
+    }
+
+    struct timespec timeout;
+    const struct timespec* timeoutPtr = nullptr;
+    if (milliseconds != PAL_WAIT_INFINITE) {
+        millisecondsToTimespec(milliseconds, &timeout);
+        timeoutPtr = &timeout;
+    }
+
+    Int32 expected = *(const Int32*)compareAddress;
+    if (futexWait((volatile Int32*)address, expected, timeoutPtr) == -1) {
+        if (errno == ETIMEDOUT) {
+            return PAL_RESULT_TIMEOUT;
+        }
+        // EAGAIN: the value changed before we slept. EINTR: spurious wakeup
+    }
+    return PAL_RESULT_SUCCESS;
+}
+
+void PAL_CALL palWakeByAddressSingle(volatile void* address)
+{
+    if (address) {
+        futexWake((volatile Int32*)address, 1);
+    }
+}
+
+void PAL_CALL palWakeByAddressAll(volatile void* address)
+{
+    if (address) {
+        futexWake((volatile Int32*)address, INT_MAX);
+    }
+}
+
+// ==================================================
+// Reader-Writer Lock
+// ==================================================
+
+PalResult PAL_CALL palCreateRWLock(
+    const PalAllocator* allocator,
+    PalRWLock** outLock)
+{
+    if (!outLock) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    if (allocator) {
+        if (!allocator->allocate || !allocator->free) {
+            return PAL_RESULT_INVALID_ALLOCATOR;
+        }
+    }
+
+    PalRWLock* lock = palAllocate(allocator, sizeof(PalRWLock), 0);
+    if (!lock) {
+        return PAL_RESULT_OUT_OF_MEMORY;
+    }
+
+    lock->state = 0;
+    lock->writersWaiting = 0;
+    lock->writerSeq = 0;
+    lock->readersWaiting = 0;
+    lock->allocator = allocator;
+    *outLock = lock;
+    return PAL_RESULT_SUCCESS;
+}
+
+void PAL_CALL palDestroyRWLock(PalRWLock* lock)
+{
+    if (lock) {
+        palFree(lock->allocator, lock);
+    }
+}
+
+void PAL_CALL palLockRWLockShared(PalRWLock* lock)
+{
+    if (!lock) {
+        return;
+    }
+
+    for (Int32 i = 0; i < PAL_RWLOCK_SPIN_COUNT; i++) {
+        if (tryLockShared(lock)) {
+            return;
+        }
+        palCpuPause();
+    }
+
+    while (!tryLockShared(lock)) {
+        parkReader(lock);
+    }
+}
+
+bool PAL_CALL palTryLockRWLockShared(PalRWLock* lock)
+{
+    if (!lock) {
+        return false;
+    }
+    return tryLockShared(lock);
+}
+
+void PAL_CALL palUnlockRWLockShared(PalRWLock* lock)
+{
+    if (!lock) {
+        return;
+    }
+
+    // only the last reader can let a writer in. Parked readers are waiting
+    // on a writer, which wakes them when it releases the lock
+    Int32 prev = palAtomicFetchAdd32(
+        &lock->state,
+        -1,
+        PAL_MEMORY_ORDER_SEQ_CST);
+
+    if (prev == 1) {
+        wakeWriter(lock);
+    }
+}
+
+void PAL_CALL palLockRWLockExclusive(PalRWLock* lock)
+{
+    if (!lock) {
+        return;
+    }
+
+    for (Int32 i = 0; i < PAL_RWLOCK_SPIN_COUNT; i++) {
+        if (tryLockExclusive(lock)) {
+            return;
+        }
+        palCpuPause();
+    }
+
+    // announce the writer so new readers stop entering
+    palAtomicFetchAdd32(&lock->writersWaiting, 1, PAL_MEMORY_ORDER_SEQ_CST);
+    while (!tryLockExclusive(lock)) {
+        parkWriter(lock);
+    }
+    palAtomicFetchAdd32(&lock->writersWaiting, -1, PAL_MEMORY_ORDER_SEQ_CST);
+}
+
+bool PAL_CALL palTryLockRWLockExclusive(PalRWLock* lock)
+{
+    if (!lock) {
+        return false;
+    }
+    return tryLockExclusive(lock);
+}
+
+void PAL_CALL palUnlockRWLockExclusive(PalRWLock* lock)
+{
+    if (!lock) {
+        return;
+    }
+
+    // hand over to a waiting writer first, readers wait for the last one
+    palAtomicStore32(&lock->state, 0, PAL_MEMORY_ORDER_SEQ_CST);
+    if (!wakeWriter(lock) &&
+        palAtomicLoad32(&lock->readersWaiting, PAL_MEMORY_ORDER_SEQ_CST)) {
+        futexWake(&lock->state, INT_MAX);
+    }
+}
@@ -25,6 +25,7 @@ freely, subject to the following restrictions:
 // Includes
 // ==================================================
 
+#include "pal/pal_atomic.h"
 #include "pal/pal_thread.h"
 
 #ifndef WIN32_LEAN_AND_MEAN
@@ -40,6 +41,7 @@ freely, subject to the following restrictions:
 #define UNICODE
 #endif // UNICODE
 
+#include <string.h>
 #include <windows.h>
 
 // ==================================================
@@ -54,32 +56,344 @@ typedef HRESULT(WINAPI* GetThreadDescriptionFn)(
     HANDLE,
     PWSTR*);
 
+typedef HANDLE(WINAPI* AvSetMmThreadCharacteristicsWFn)(
+    LPCWSTR,
+    LPDWORD);
+
+typedef BOOL(WINAPI* AvRevertMmThreadCharacteristicsFn)(HANDLE);
+
+typedef LONG(WINAPI* NtQuerySystemInformationFn)(
+    ULONG,
+    PVOID,
+    ULONG,
+    PULONG);
+
+// NtQuerySystemInformation process snapshot, the layout is from ntdll
+#define PAL_SYSTEM_PROCESS_INFORMATION 5
+#define PAL_STATUS_INFO_LENGTH_MISMATCH ((LONG)0xC0000004)
+#define PAL_PROCESS_SNAPSHOT_SIZE (256 * 1024)
+
+typedef struct {
+    LARGE_INTEGER kernelTime;
+    LARGE_INTEGER userTime;
+    LARGE_INTEGER createTime;
+    ULONG waitTime;
+    PVOID startAddress;
+    HANDLE uniqueProcess;
+    HANDLE uniqueThread;
+    LONG priority;
+    LONG basePriority;
+    ULONG contextSwitches;
+    ULONG threadState;
+    ULONG waitReason;
+} SystemThreadInfo;
+
 typedef struct {
+    ULONG nextEntryOffset;
+    ULONG numberOfThreads;
+    BYTE reserved1[48];
+    USHORT imageNameLength;
+    USHORT imageNameMaximumLength;
+    PWSTR imageName;
+    LONG basePriority;
+    HANDLE uniqueProcessId;
+    HANDLE inheritedFromUniqueProcessId;
+    ULONG handleCount;
+    ULONG sessionId;
+    ULONG_PTR uniqueProcessKey;
+    SIZE_T reserved2[12];
+    LARGE_INTEGER reserved3[6];
+    SystemThreadInfo threads[1];
+} SystemProcessInfo;
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif // CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+
+// realtime levels are only remembered, the OS has one realtime priority
+#define PAL_SCHEDULING_REALTIME_MIN 1
+#define PAL_SCHEDULING_REALTIME_MAX 99
+
+#define PAL_DEFAULT_FIBER_STACK_SIZE (256 * 1024)
+
+// left uncommitted below a committed stack for the guard pages
+#define PAL_STACK_COMMIT_MARGIN (64 * 1024)
+
+struct PalThread {
+    HANDLE handle;
+    volatile Int32 refs;
+    bool foreign; // not created by PAL, lives in its own TLS
     const PalAllocator* allocator;
     PalThreadFn func;
     void* arg;
-} ThreadData;
+    void* retval; // the exit code is only 32 bits
+    HANDLE mmcss; // MMCSS task the thread joined
+    PalSchedulingPolicy realtimePolicy;
+    Int32 realtimeLevel; // 0 unless a realtime policy was set
+    Uint64 stackCommit;
+    Uint64 guardSize;
+};
 
-struct PalMutex {
+struct PalFiber {
+    LPVOID handle;
     const PalAllocator* allocator;
-    CRITICAL_SECTION sc;
+    PalFiberFn func;
+    void* arg;
+    PalFiber* previous; // fiber that last switched to this one
+    bool converted;     // the fiber of a converted thread
+    bool finished;
 };
 
-struct PalCondVar {
+struct PalRWLock {
     const PalAllocator* allocator;
-    CONDITION_VARIABLE cv;
+    SRWLOCK srw;
 };
 
+static __declspec(thread) PalThread* s_CurrentThread = nullptr;
+static __declspec(thread) PalThread s_ForeignThread;
+static __declspec(thread) PalFiber* s_CurrentFiber = nullptr;
+
+static INIT_ONCE s_SleepTimerOnce = INIT_ONCE_STATIC_INIT;
+static DWORD s_SleepTimerId = FLS_OUT_OF_INDEXES;
+
 // ==================================================
 // Internal API
 // ==================================================
 
+static void releaseThread(PalThread* thread)
+{
+    // the thread and its creator each hold a reference
+    if (palAtomicFetchAdd32(&thread->refs, -1, PAL_MEMORY_ORDER_ACQ_REL) == 1) {
+        palFree(thread->allocator, thread);
+    }
+}
+
+static void commitStack(
+    Uint64 size,
+    Uint64 guardSize)
+{
+    // the reservation starts at the allocation base of the stack. Stop above
+    // the region kept for SetThreadStackGuarantee() or touching it overflows
+    MEMORY_BASIC_INFORMATION info;
+    volatile Uint8 marker = 0;
+    if (!VirtualQuery((LPCVOID)&marker, &info, sizeof(info))) {
+        return;
+    }
+
+    UintPtr current = (UintPtr)&marker;
+    UintPtr base = (UintPtr)info.AllocationBase;
+    base += (UintPtr)guardSize + PAL_STACK_COMMIT_MARGIN;
+    if (current <= base) {
+        return;
+    }
+
+    if (size > current - base) {
+        size = current - base;
+    }
+
+    // read the pages top down, each one moves the guard page below it
+    SYSTEM_INFO system;
+    GetSystemInfo(&system);
+    UintPtr page = system.dwPageSize;
+    for (UintPtr offset = page; offset <= size; offset += page) {
+        volatile Uint8* byte = (volatile Uint8*)(current - offset);
+        (void)*byte;
+    }
+}
+
 static DWORD WINAPI threadEntryToWin32(LPVOID arg)
 {
-    ThreadData* data = arg;
-    void* ret = data->func(data->arg);
-    palFree(data->allocator, data);
-    return (DWORD)(uintptr_t)ret;
+    PalThread* thread = arg;
+    s_CurrentThread = thread;
+    if (thread->guardSize) {
+        ULONG guarantee = (ULONG)thread->guardSize;
+        SetThreadStackGuarantee(&guarantee);
+    }
+
+    if (thread->stackCommit) {
+        commitStack(thread->stackCommit, thread->guardSize);
+    }
+
+    // the handle is signaled after this returns, which publishes retval
+    thread->retval = thread->func(thread->arg);
+    releaseThread(thread);
+    return 0;
+}
+
+static void WINAPI closeSleepTimer(PVOID data)
+{
+    if (data) {
+        CloseHandle(data);
+    }
+}
+
+static BOOL CALLBACK createSleepTimerId(
+    PINIT_ONCE once,
+    PVOID param,
+    PVOID* context)
+{
+    // fiber local, the timer is closed with the fiber or thread that made it
+    s_SleepTimerId = FlsAlloc(closeSleepTimer);
+    return TRUE;
+}
+
+static HANDLE getSleepTimer()
+{
+    InitOnceExecuteOnce(
+        &s_SleepTimerOnce,
+        createSleepTimerId,
+        nullptr,
+        nullptr);
+    if (s_SleepTimerId == FLS_OUT_OF_INDEXES) {
+        return nullptr;
+    }
+
+    HANDLE timer = FlsGetValue(s_SleepTimerId);
+    if (timer) {
+        return timer;
+    }
+
+    // high resolution timers need Windows 10 1803, older versions get a
+    // regular timer that is as coarse as Sleep()
+    timer = CreateWaitableTimerExW(
+        nullptr,
+        nullptr,
+        CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+        TIMER_ALL_ACCESS);
+
+    if (!timer) {
+        timer = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+    }
+
+    if (timer) {
+        FlsSetValue(s_SleepTimerId, timer);
+    }
+    return timer;
+}
+
+static void WINAPI fiberEntryToWin32(LPVOID arg)
+{
+    PalFiber* fiber = arg;
+    fiber->func(fiber->arg);
+
+    // returning would exit the thread, go back to whoever ran us last
+    fiber->finished = true;
+    PalFiber* previous = fiber->previous;
+    s_CurrentFiber = previous;
+    SwitchToFiber(previous->handle);
+}
+
+static void setProcessorDomain(
+    PalLogicalProcessor* table,
+    const GROUP_AFFINITY* affinity,
+    PalCpuDomain domain,
+    Uint32 id)
+{
+    // processors are indexed by group * 64 + bit so sets can span groups
+    for (Uint32 bit = 0; bit < 64; bit++) {
+        if (!(affinity->Mask & ((KAFFINITY)1 << bit))) {
+            continue;
+        }
+
+        Uint32 index = affinity->Group * 64 + bit;
+        if (index >= PAL_MAX_CPU_SET_SIZE) {
+            return;
+        }
+
+        PalLogicalProcessor* processor = &table[index];
+        switch (domain) {
+            case PAL_CPU_DOMAIN_CORE:
+                processor->core = id;
+                break;
+
+            case PAL_CPU_DOMAIN_CACHE_L2:
+                processor->cacheL2 = id;
+                break;
+
+            case PAL_CPU_DOMAIN_CACHE_L3:
+                processor->cacheL3 = id;
+                break;
+
+            case PAL_CPU_DOMAIN_NUMA_NODE:
+                processor->numaNode = id;
+                break;
+
+            case PAL_CPU_DOMAIN_PACKAGE:
+                processor->package = id;
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+static Uint64 getContextSwitches(DWORD threadId)
+{
+    // the only per thread count Windows has is in the process list
+    static NtQuerySystemInformationFn querySystemInfo = nullptr;
+    if (!querySystemInfo) {
+        HMODULE ntdll = GetModuleHandleW(L"ntdll.dll");
+        if (!ntdll) {
+            return 0;
+        }
+
+        querySystemInfo = (NtQuerySystemInformationFn)GetProcAddress(
+            ntdll,
+            "NtQuerySystemInformation");
+
+        if (!querySystemInfo) {
+            return 0;
+        }
+    }
+
+    ULONG size = PAL_PROCESS_SNAPSHOT_SIZE;
+    BYTE* buffer = nullptr;
+    LONG status = PAL_STATUS_INFO_LENGTH_MISMATCH;
+    while (status == PAL_STATUS_INFO_LENGTH_MISMATCH) {
+        palFree(nullptr, buffer);
+        buffer = palAllocate(nullptr, size, 16);
+        if (!buffer) {
+            return 0;
+        }
+
+        // processes can start between the calls, ask for some more
+        ULONG needed = 0;
+        status = querySystemInfo(
+            PAL_SYSTEM_PROCESS_INFORMATION,
+            buffer,
+            size,
+            &needed);
+
+        size = needed + PAL_PROCESS_SNAPSHOT_SIZE / 4;
+    }
+
+    Uint64 switches = 0;
+    if (status >= 0) {
+        HANDLE processId = (HANDLE)(ULONG_PTR)GetCurrentProcessId();
+        HANDLE id = (HANDLE)(ULONG_PTR)threadId;
+        BYTE* entry = buffer;
+        for (;;) {
+            SystemProcessInfo* process = (SystemProcessInfo*)entry;
+            if (process->uniqueProcessId == processId) {
+                for (ULONG i = 0; i < process->numberOfThreads; i++) {
+                    if (process->threads[i].uniqueThread == id) {
+                        switches = process->threads[i].contextSwitches;
+                        break;
+                    }
+                }
+                break;
+            }
+
+            if (process->nextEntryOffset == 0) {
+                break;
+            }
+            entry += process->nextEntryOffset;
+        }
+    }
+
+    palFree(nullptr, buffer);
+    return switches;
 }
 
 // ==================================================
@@ -104,27 +418,42 @@ PalResult PAL_CALL palCreateThread(
         }
     }
 
-    // create thread
-    ThreadData* data = palAllocate(info->allocator, sizeof(ThreadData), 0);
-    if (!data) {
+    // CreateThread() always maps its own stack
+    if (info->stack) {
+        return PAL_RESULT_THREAD_FEATURE_NOT_SUPPORTED;
+    }
+
+    PalThread* thread = palAllocate(info->allocator, sizeof(PalThread), 0);
+    if (!thread) {
         return PAL_RESULT_OUT_OF_MEMORY;
     }
 
-    data->arg = info->arg;
-    data->func = info->entry;
-    data->allocator = info->allocator;
+    memset(thread, 0, sizeof(PalThread));
+    thread->allocator = info->allocator;
+    thread->func = info->entry;
+    thread->arg = info->arg;
+    thread->stackCommit = info->stackCommit;
+    thread->guardSize = info->guardSize;
+    thread->refs = 2;
+
+    // without the flag the size would be committed up front
+    DWORD flags = 0;
+    if (info->stackSize) {
+        flags = STACK_SIZE_PARAM_IS_A_RESERVATION;
+    }
 
-    HANDLE thread = CreateThread(
+    thread->handle = CreateThread(
         nullptr,
-        info->stackSize,
+        (SIZE_T)info->stackSize,
         threadEntryToWin32,
-        data,
-        0,
+        thread,
+        flags,
         nullptr);
 
-    if (!thread) {
+    if (!thread->handle) {
         // error
         DWORD error = GetLastError();
+        palFree(info->allocator, thread);
         if (error == ERROR_NOT_ENOUGH_MEMORY) {
             return PAL_RESULT_OUT_OF_MEMORY;
 
@@ -145,30 +474,58 @@ PalResult PAL_CALL palCreateThread(
 
 PalResult PAL_CALL palJoinThread(
     PalThread* thread,
-    void* retval)
+    void** outRetval)
+{
+    return palJoinThreadTimeout(thread, PAL_WAIT_INFINITE, outRetval);
+}
+
+PalResult PAL_CALL palJoinThreadTimeout(
+    PalThread* thread,
+    Uint64 milliseconds,
+    void** outRetval)
 {
     if (!thread) {
         return PAL_RESULT_NULL_POINTER;
     }
 
-    DWORD wait = WaitForSingleObject((HANDLE)thread, INFINITE);
-    if (wait == WAIT_OBJECT_0 && retval) {
-        uintptr_t ret;
-        GetExitCodeThread((HANDLE)thread, (LPDWORD)&ret);
-        retval = (void*)ret;
+    if (thread->foreign) {
+        return PAL_RESULT_INVALID_THREAD;
+    }
+
+    // INFINITE is the largest DWORD, longer finite waits go in steps
+    DWORD wait = WAIT_TIMEOUT;
+    Uint64 remaining = milliseconds;
+    while (wait == WAIT_TIMEOUT) {
+        DWORD step = INFINITE;
+        if (remaining != PAL_WAIT_INFINITE) {
+            step = remaining < INFINITE ? (DWORD)remaining : INFINITE - 1;
+            remaining -= step;
+        }
+
+        wait = WaitForSingleObject(thread->handle, step);
+        if (wait == WAIT_TIMEOUT && remaining == 0) {
+            return PAL_RESULT_TIMEOUT;
+        }
+    }
 
-    } else if (wait == WAIT_FAILED) {
+    if (wait != WAIT_OBJECT_0) {
         return PAL_RESULT_INVALID_THREAD;
     }
 
+    if (outRetval) {
+        *outRetval = thread->retval;
+    }
     return PAL_RESULT_SUCCESS;
 }
 
 void PAL_CALL palDetachThread(PalThread* thread)
 {
-    if (thread) {
-        CloseHandle((HANDLE)thread);
+    if (!thread || thread->foreign) {
+        return;
     }
+
+    CloseHandle(thread->handle);
+    releaseThread(thread);
 }
 
 void PAL_CALL palSleep(Uint64 milliseconds)
@@ -176,6 +533,23 @@ void PAL_CALL palSleep(Uint64 milliseconds)
     Sleep((DWORD)milliseconds);
 }
 
+void PAL_CALL palSleepNanoseconds(Uint64 nanoseconds)
+{
+    // the timer is created on the first sleep and reused after that
+    HANDLE timer = getSleepTimer();
+    if (!timer) {
+        Sleep((DWORD)((nanoseconds + 999999) / 1000000));
+        return;
+    }
+
+    // negative due times are relative, in 100 nanosecond units
+    LARGE_INTEGER due;
+    due.QuadPart = -(LONGLONG)((nanoseconds + 99) / 100);
+    if (SetWaitableTimer(timer, &due, 0, nullptr, nullptr, FALSE)) {
+        WaitForSingleObject(timer, INFINITE);
+    }
+}
+
 void PAL_CALL palYield()
 {
     SwitchToThread();
@@ -183,7 +557,18 @@ void PAL_CALL palYield()
 
 PalThread* PAL_CALL palGetCurrentThread()
 {
-    return (PalThread*)GetCurrentThread();
+    if (s_CurrentThread) {
+        return s_CurrentThread;
+    }
+
+    // threads not created by PAL get a handle in their own TLS. The pseudo
+    // handle only refers to the calling thread, like before
+    PalThread* thread = &s_ForeignThread;
+    thread->handle = GetCurrentThread();
+    thread->refs = 1;
+    thread->foreign = true;
+    s_CurrentThread = thread;
+    return thread;
 }
 
 PalThreadFeatures PAL_CALL palGetThreadFeatures()
@@ -215,7 +600,7 @@ PalThreadPriority PAL_CALL palGetThreadPriority(PalThread* thread)
         return 0;
     }
 
-    int priority = GetThreadPriority((HANDLE)thread);
+    int priority = GetThreadPriority(thread->handle);
     switch (priority) {
         case THREAD_PRIORITY_LOWEST:
             return PAL_THREAD_PRIORITY_LOW;
@@ -239,12 +624,12 @@ Uint64 PAL_CALL palGetThreadAffinity(PalThread* thread)
         return 0;
     }
 
-    DWORD_PTR mask = SetThreadAffinityMask((HANDLE)thread, ~0ull);
+    DWORD_PTR mask = SetThreadAffinityMask(thread->handle, ~0ull);
     if (mask == 0) {
         return 0;
     }
 
-    SetThreadAffinityMask((HANDLE)thread, mask);
+    SetThreadAffinityMask(thread->handle, mask);
     return mask;
 }
 
@@ -272,7 +657,7 @@ PalResult PAL_CALL palGetThreadName(
     }
 
     wchar_t* buffer = nullptr;
-    HRESULT hr = getThreadDescription((HANDLE)thread, &buffer);
+    HRESULT hr = getThreadDescription(thread->handle, &buffer);
 
     if (!SUCCEEDED(hr)) {
         return PAL_RESULT_INVALID_THREAD;
@@ -317,7 +702,7 @@ PalResult PAL_CALL palSetThreadPriority(
             break;
     }
 
-    if (!SetThreadPriority((HANDLE)thread, _priority)) {
+    if (!SetThreadPriority(thread->handle, _priority)) {
         DWORD error = GetLastError();
         if (error == ERROR_INVALID_HANDLE) {
             return PAL_RESULT_INVALID_THREAD;
@@ -333,6 +718,203 @@ PalResult PAL_CALL palSetThreadPriority(
     return PAL_RESULT_SUCCESS;
 }
 
+PalResult PAL_CALL palGetThreadScheduling(
+    PalThread* thread,
+    PalThreadScheduling* outScheduling)
+{
+    if (!thread || !outScheduling) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    int priority = GetThreadPriority(thread->handle);
+    if (priority == THREAD_PRIORITY_ERROR_RETURN) {
+        return PAL_RESULT_INVALID_THREAD;
+    }
+
+    memset(outScheduling, 0, sizeof(PalThreadScheduling));
+    if (priority == THREAD_PRIORITY_IDLE) {
+        outScheduling->policy = PAL_SCHEDULING_POLICY_IDLE;
+
+    } else if (priority == THREAD_PRIORITY_TIME_CRITICAL) {
+        // both realtime policies look the same, report the one that was set
+        outScheduling->policy = PAL_SCHEDULING_POLICY_REALTIME_FIFO;
+        outScheduling->level = PAL_SCHEDULING_REALTIME_MAX;
+        if (thread->realtimeLevel) {
+            outScheduling->policy = thread->realtimePolicy;
+            outScheduling->level = thread->realtimeLevel;
+        }
+
+    } else {
+        if (priority < THREAD_PRIORITY_LOWEST) {
+            priority = THREAD_PRIORITY_LOWEST;
+        } else if (priority > THREAD_PRIORITY_HIGHEST) {
+            priority = THREAD_PRIORITY_HIGHEST;
+        }
+
+        // THREAD_PRIORITY_LOWEST to THREAD_PRIORITY_HIGHEST are -2 to 2
+        outScheduling->policy = PAL_SCHEDULING_POLICY_NORMAL;
+        outScheduling->level = priority;
+    }
+
+    return PAL_RESULT_SUCCESS;
+}
+
+PalResult PAL_CALL palSetThreadScheduling(
+    PalThread* thread,
+    const PalThreadScheduling* scheduling)
+{
+    if (!thread || !scheduling) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    int priority = THREAD_PRIORITY_NORMAL;
+    bool realtime = false;
+    switch (scheduling->policy) {
+        case PAL_SCHEDULING_POLICY_IDLE:
+            priority = THREAD_PRIORITY_IDLE;
+            break;
+
+        case PAL_SCHEDULING_POLICY_NORMAL:
+            if (scheduling->level < THREAD_PRIORITY_LOWEST ||
+                scheduling->level > THREAD_PRIORITY_HIGHEST) {
+                return PAL_RESULT_INVALID_ARGUMENT;
+            }
+            priority = scheduling->level;
+            break;
+
+        case PAL_SCHEDULING_POLICY_REALTIME_FIFO:
+        case PAL_SCHEDULING_POLICY_REALTIME_RR:
+            priority = THREAD_PRIORITY_TIME_CRITICAL;
+            realtime = true;
+            break;
+
+        default:
+            return PAL_RESULT_INVALID_ARGUMENT;
+    }
+
+    // MMCSS registers and unregisters the calling thread only
+    bool joinTask = realtime && scheduling->mmcssTask;
+    if ((joinTask || thread->mmcss) && thread != palGetCurrentThread()) {
+        return PAL_RESULT_INVALID_ARGUMENT;
+    }
+
+    // avrt.dll stays loaded while a thread is in a task
+    AvSetMmThreadCharacteristicsWFn joinMmcss = nullptr;
+    AvRevertMmThreadCharacteristicsFn leaveMmcss = nullptr;
+    HMODULE avrt = nullptr;
+    if (joinTask || thread->mmcss) {
+        avrt = GetModuleHandleW(L"avrt.dll");
+        if (!avrt) {
+            avrt = LoadLibraryW(L"avrt.dll");
+        }
+    }
+
+    if (avrt) {
+        joinMmcss = (AvSetMmThreadCharacteristicsWFn)GetProcAddress(
+            avrt,
+            "AvSetMmThreadCharacteristicsW");
+
+        leaveMmcss = (AvRevertMmThreadCharacteristicsFn)GetProcAddress(
+            avrt,
+            "AvRevertMmThreadCharacteristics");
+    }
+
+    if (joinTask && !joinMmcss) {
+        // not supported
+        return PAL_RESULT_THREAD_FEATURE_NOT_SUPPORTED;
+    }
+
+    if (!SetThreadPriority(thread->handle, priority)) {
+        DWORD error = GetLastError();
+        if (error == ERROR_INVALID_HANDLE) {
+            return PAL_RESULT_INVALID_THREAD;
+
+        } else if (error == ERROR_ACCESS_DENIED) {
+            return PAL_RESULT_ACCESS_DENIED;
+
+        } else {
+            return PAL_RESULT_PLATFORM_FAILURE;
+        }
+    }
+
+    // leave the old task first, a thread is in at most one
+    if (thread->mmcss && leaveMmcss) {
+        leaveMmcss(thread->mmcss);
+    }
+    thread->mmcss = nullptr;
+
+    if (joinTask) {
+        wchar_t buffer[128] = {0};
+        MultiByteToWideChar(CP_UTF8, 0, scheduling->mmcssTask, -1, buffer, 128);
+
+        DWORD taskIndex = 0;
+        thread->mmcss = joinMmcss(buffer, &taskIndex);
+        if (!thread->mmcss) {
+            DWORD error = GetLastError();
+            if (error == ERROR_INVALID_TASK_NAME) {
+                return PAL_RESULT_INVALID_ARGUMENT;
+
+            } else if (error == ERROR_PRIVILEGE_NOT_HELD) {
+                return PAL_RESULT_ACCESS_DENIED;
+
+            } else {
+                return PAL_RESULT_PLATFORM_FAILURE;
+            }
+        }
+    }
+
+    thread->realtimeLevel = 0;
+    if (realtime) {
+        thread->realtimePolicy = scheduling->policy;
+        thread->realtimeLevel = scheduling->level;
+        if (thread->realtimeLevel < PAL_SCHEDULING_REALTIME_MIN) {
+            thread->realtimeLevel = PAL_SCHEDULING_REALTIME_MIN;
+        } else if (thread->realtimeLevel > PAL_SCHEDULING_REALTIME_MAX) {
+            thread->realtimeLevel = PAL_SCHEDULING_REALTIME_MAX;
+        }
+    }
+
+    return PAL_RESULT_SUCCESS;
+}
+
+PalResult PAL_CALL palGetThreadStats(
+    PalThread* thread,
+    PalThreadStats* outStats)
+{
+    if (!thread || !outStats) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    FILETIME creation, exit, kernel, user;
+    if (!GetThreadTimes(thread->handle, &creation, &exit, &kernel, &user)) {
+        return PAL_RESULT_INVALID_THREAD;
+    }
+
+    // FILETIME counts 100 nanosecond intervals
+    memset(outStats, 0, sizeof(PalThreadStats));
+    ULARGE_INTEGER time;
+    time.LowPart = user.dwLowDateTime;
+    time.HighPart = user.dwHighDateTime;
+    outStats->userTime = time.QuadPart * 100;
+
+    time.LowPart = kernel.dwLowDateTime;
+    time.HighPart = kernel.dwHighDateTime;
+    outStats->kernelTime = time.QuadPart * 100;
+
+    // voluntary and involuntary switches are not told apart
+    DWORD id = GetThreadId(thread->handle);
+    outStats->contextSwitches = getContextSwitches(id);
+
+    outStats->cpu = -1;
+    if (id == GetCurrentThreadId()) {
+        PROCESSOR_NUMBER number;
+        GetCurrentProcessorNumberEx(&number);
+        outStats->cpu = (Int32)number.Group * 64 + number.Number;
+    }
+
+    return PAL_RESULT_SUCCESS;
+}
+
 PalResult PAL_CALL palSetThreadAffinity(
     PalThread* thread,
     Uint64 mask)
@@ -341,7 +923,7 @@ PalResult PAL_CALL palSetThreadAffinity(
         return PAL_RESULT_NULL_POINTER;
     }
 
-    if (!SetThreadAffinityMask((HANDLE)thread, mask)) {
+    if (!SetThreadAffinityMask(thread->handle, mask)) {
         DWORD error = GetLastError();
         if (error == ERROR_INVALID_HANDLE) {
             return PAL_RESULT_INVALID_THREAD;
@@ -380,7 +962,7 @@ PalResult PAL_CALL palSetThreadName(
 
     wchar_t buffer[128] = {0};
     MultiByteToWideChar(CP_UTF8, 0, name, -1, buffer, 128);
-    HRESULT hr = setThreadDescription((HANDLE)thread, buffer);
+    HRESULT hr = setThreadDescription(thread->handle, buffer);
 
     if (SUCCEEDED(hr)) {
         return PAL_RESULT_SUCCESS;
@@ -401,6 +983,355 @@ PalResult PAL_CALL palSetThreadName(
     }
 }
 
+// ==================================================
+// CPU Topology
+// ==================================================
+
+PalResult PAL_CALL palEnumerateLogicalProcessors(
+    const PalAllocator* allocator,
+    Int32* count,
+    PalLogicalProcessor* processors)
+{
+    if (!count) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    if (allocator && (!allocator->allocate || !allocator->free)) {
+        return PAL_RESULT_INVALID_ALLOCATOR;
+    }
+
+    DWORD len = 0;
+    GetLogicalProcessorInformationEx(RelationAll, nullptr, &len);
+
+    SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX* buffer = nullptr;
+    buffer = palAllocate(allocator, len, 16);
+    if (!buffer) {
+        return PAL_RESULT_OUT_OF_MEMORY;
+    }
+
+    if (!GetLogicalProcessorInformationEx(RelationAll, buffer, &len)) {
+        palFree(allocator, buffer);
+        return PAL_RESULT_PLATFORM_FAILURE;
+    }
+
+    Uint64 size = sizeof(PalLogicalProcessor) * PAL_MAX_CPU_SET_SIZE;
+    PalLogicalProcessor* table = palAllocate(allocator, size, 0);
+    if (!table) {
+        palFree(allocator, buffer);
+        return PAL_RESULT_OUT_OF_MEMORY;
+    }
+
+    // caches that are not reported fall back to the core and package
+    for (Uint32 i = 0; i < PAL_MAX_CPU_SET_SIZE; i++) {
+        table[i].index = i;
+        table[i].core = 0;
+        table[i].cacheL2 = UINT32_MAX;
+        table[i].cacheL3 = UINT32_MAX;
+        table[i].numaNode = 0;
+        table[i].package = 0;
+    }
+
+    // every record type counts its own ids
+    PalCpuSet found = {0};
+    Uint32 cores = 0;
+    Uint32 packages = 0;
+    Uint32 cachesL2 = 0;
+    Uint32 cachesL3 = 0;
+    char* ptr = (char*)buffer;
+    while (ptr < (char*)buffer + len) {
+        SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX* tmp = (void*)ptr;
+        if (tmp->Relationship == RelationProcessorCore) {
+            PROCESSOR_RELATIONSHIP* core = &tmp->Processor;
+            for (WORD i = 0; i < core->GroupCount; i++) {
+                GROUP_AFFINITY* affinity = &core->GroupMask[i];
+                setProcessorDomain(table, affinity, PAL_CPU_DOMAIN_CORE, cores);
+                for (Uint32 bit = 0; bit < 64; bit++) {
+                    Uint32 index = affinity->Group * 64 + bit;
+                    if ((affinity->Mask & ((KAFFINITY)1 << bit)) &&
+                        index < PAL_MAX_CPU_SET_SIZE) {
+                        palAddCpuToSet(&found, index);
+                    }
+                }
+            }
+            cores++;
+
+        } else if (tmp->Relationship == RelationProcessorPackage) {
+            PROCESSOR_RELATIONSHIP* package = &tmp->Processor;
+            for (WORD i = 0; i < package->GroupCount; i++) {
+                setProcessorDomain(
+                    table,
+                    &package->GroupMask[i],
+                    PAL_CPU_DOMAIN_PACKAGE,
+                    packages);
+            }
+            packages++;
+
+        } else if (tmp->Relationship == RelationCache) {
+            CACHE_RELATIONSHIP* cache = &tmp->Cache;
+            if (cache->Type != CacheInstruction) {
+                if (cache->Level == 2) {
+                    setProcessorDomain(
+                        table,
+                        &cache->GroupMask,
+                        PAL_CPU_DOMAIN_CACHE_L2,
+                        cachesL2++);
+
+                } else if (cache->Level == 3) {
+                    setProcessorDomain(
+                        table,
+                        &cache->GroupMask,
+                        PAL_CPU_DOMAIN_CACHE_L3,
+                        cachesL3++);
+                }
+            }
+
+        } else if (tmp->Relationship == RelationNumaNode) {
+            NUMA_NODE_RELATIONSHIP* node = &tmp->NumaNode;
+            setProcessorDomain(
+                table,
+                &node->GroupMask,
+                PAL_CPU_DOMAIN_NUMA_NODE,
+                node->NodeNumber);
+        }
+        ptr += tmp->Size;
+    }
+    palFree(allocator, buffer);
+
+    Int32 total = 0;
+    for (Uint32 i = 0; i < PAL_MAX_CPU_SET_SIZE; i++) {
+        if (!palIsCpuInSet(&found, i)) {
+            continue;
+        }
+
+        if (processors && total < *count) {
+            PalLogicalProcessor* processor = &processors[total];
+            *processor = table[i];
+            if (processor->cacheL2 == UINT32_MAX) {
+                processor->cacheL2 = processor->core;
+            }
+
+            if (processor->cacheL3 == UINT32_MAX) {
+                processor->cacheL3 = processor->package;
+            }
+        }
+        total++;
+    }
+
+    palFree(allocator, table);
+    if (!processors) {
+        *count = total;
+    }
+    return PAL_RESULT_SUCCESS;
+}
+
+PalResult PAL_CALL palGetThreadCpuSet(
+    PalThread* thread,
+    PalCpuSet* outSet)
+{
+    if (!thread || !outSet) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    GROUP_AFFINITY affinity = {0};
+    if (!GetThreadGroupAffinity(thread->handle, &affinity)) {
+        DWORD error = GetLastError();
+        if (error == ERROR_INVALID_HANDLE) {
+            return PAL_RESULT_INVALID_THREAD;
+        }
+        return PAL_RESULT_PLATFORM_FAILURE;
+    }
+
+    // a thread runs in a single group, one word of the set
+    memset(outSet, 0, sizeof(PalCpuSet));
+    if (affinity.Group < PAL_MAX_CPU_SET_SIZE / 64) {
+        outSet->bits[affinity.Group] = (Uint64)affinity.Mask;
+    }
+    return PAL_RESULT_SUCCESS;
+}
+
+PalResult PAL_CALL palSetThreadCpuSet(
+    PalThread* thread,
+    const PalCpuSet* set)
+{
+    if (!thread || !set) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    // processor indices put every group in its own word of the set
+    GROUP_AFFINITY affinity = {0};
+    Uint32 groups = 0;
+    for (Uint32 i = 0; i < PAL_MAX_CPU_SET_SIZE / 64; i++) {
+        if (set->bits[i]) {
+            affinity.Group = (WORD)i;
+            affinity.Mask = (KAFFINITY)set->bits[i];
+            groups++;
+        }
+    }
+
+    if (groups != 1) {
+        return PAL_RESULT_INVALID_ARGUMENT;
+    }
+
+    if (!SetThreadGroupAffinity(thread->handle, &affinity, nullptr)) {
+        DWORD error = GetLastError();
+        if (error == ERROR_INVALID_HANDLE) {
+            return PAL_RESULT_INVALID_THREAD;
+
+        } else if (error == ERROR_INVALID_PARAMETER) {
+            return PAL_RESULT_INVALID_ARGUMENT;
+
+        } else if (error == ERROR_ACCESS_DENIED) {
+            return PAL_RESULT_ACCESS_DENIED;
+
+        } else {
+            return PAL_RESULT_PLATFORM_FAILURE;
+        }
+    }
+
+    return PAL_RESULT_SUCCESS;
+}
+
+// ==================================================
+// Fiber
+// ==================================================
+
+PalResult PAL_CALL palConvertThreadToFiber(
+    const PalAllocator* allocator,
+    PalFiber** outFiber)
+{
+    if (!outFiber) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    if (allocator && (!allocator->allocate || !allocator->free)) {
+        return PAL_RESULT_INVALID_ALLOCATOR;
+    }
+
+    if (s_CurrentFiber) {
+        return PAL_RESULT_INVALID_THREAD;
+    }
+
+    PalFiber* fiber = palAllocate(allocator, sizeof(PalFiber), 0);
+    if (!fiber) {
+        return PAL_RESULT_OUT_OF_MEMORY;
+    }
+
+    memset(fiber, 0, sizeof(PalFiber));
+    fiber->handle = ConvertThreadToFiberEx(fiber, FIBER_FLAG_FLOAT_SWITCH);
+    if (!fiber->handle) {
+        DWORD error = GetLastError();
+        palFree(allocator, fiber);
+        if (error == ERROR_ALREADY_FIBER) {
+            return PAL_RESULT_INVALID_THREAD;
+        }
+        return PAL_RESULT_PLATFORM_FAILURE;
+    }
+
+    fiber->allocator = allocator;
+    fiber->converted = true;
+    s_CurrentFiber = fiber;
+    *outFiber = fiber;
+    return PAL_RESULT_SUCCESS;
+}
+
+PalResult PAL_CALL palConvertFiberToThread()
+{
+    PalFiber* fiber = s_CurrentFiber;
+    if (!fiber || !fiber->converted) {
+        return PAL_RESULT_INVALID_THREAD;
+    }
+
+    if (!ConvertFiberToThread()) {
+        return PAL_RESULT_PLATFORM_FAILURE;
+    }
+
+    s_CurrentFiber = nullptr;
+    palFree(fiber->allocator, fiber);
+    return PAL_RESULT_SUCCESS;
+}
+
+PalResult PAL_CALL palCreateFiber(
+    const PalFiberCreateInfo* info,
+    PalFiber** outFiber)
+{
+    if (!info || !outFiber) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    if (!info->entry) {
+        return PAL_RESULT_INVALID_ARGUMENT;
+    }
+
+    if (info->allocator) {
+        if (!info->allocator->allocate || !info->allocator->free) {
+            return PAL_RESULT_INVALID_ALLOCATOR;
+        }
+    }
+
+    SIZE_T stackSize = PAL_DEFAULT_FIBER_STACK_SIZE;
+    if (info->stackSize) {
+        stackSize = (SIZE_T)info->stackSize;
+    }
+
+    PalFiber* fiber = palAllocate(info->allocator, sizeof(PalFiber), 0);
+    if (!fiber) {
+        return PAL_RESULT_OUT_OF_MEMORY;
+    }
+
+    // the stack size is the reservation, pages are committed as it grows
+    memset(fiber, 0, sizeof(PalFiber));
+    fiber->handle = CreateFiberEx(
+        0,
+        stackSize,
+        FIBER_FLAG_FLOAT_SWITCH,
+        fiberEntryToWin32,
+        fiber);
+
+    if (!fiber->handle) {
+        palFree(info->allocator, fiber);
+        if (GetLastError() == ERROR_NOT_ENOUGH_MEMORY) {
+            return PAL_RESULT_OUT_OF_MEMORY;
+        }
+        return PAL_RESULT_PLATFORM_FAILURE;
+    }
+
+    fiber->allocator = info->allocator;
+    fiber->func = info->entry;
+    fiber->arg = info->arg;
+    *outFiber = fiber;
+    return PAL_RESULT_SUCCESS;
+}
+
+void PAL_CALL palDestroyFiber(PalFiber* fiber)
+{
+    // deleting the fiber of a converted thread would exit the thread
+    if (!fiber || fiber->converted) {
+        return;
+    }
+
+    DeleteFiber(fiber->handle);
+    palFree(fiber->allocator, fiber);
+}
+
+void PAL_CALL palSwitchToFiber(PalFiber* fiber)
+{
+    PalFiber* current = s_CurrentFiber;
+    if (!fiber || !current || fiber == current) {
+        return;
+    }
+
+    // the fiber we switch to reads nothing thread local before running, so
+    // a fiber can be resumed on another thread
+    fiber->previous = current;
+    s_CurrentFiber = fiber;
+    SwitchToFiber(fiber->handle);
+}
+
+PalFiber* PAL_CALL palGetCurrentFiber()
+{
+    return s_CurrentFiber;
+}
+
 // ==================================================
 // TLS
 // ==================================================
@@ -432,149 +1363,135 @@ void PAL_CALL palSetTLS(
 }
 
 // ==================================================
-// Mutex
+// Wait On Address
 // ==================================================
 
-PalResult PAL_CALL palCreateMutex(
-    const PalAllocator* allocator,
-    PalMutex** outMutex)
+PalResult PAL_CALL palWaitOnAddress(
+    volatile void* address,
+    const void* compareAddress,
+    Uint32 size,
+    Uint64 milliseconds)
 {
-    if (!outMutex) {
+    if (!address || !compareAddress) {
         return PAL_RESULT_NULL_POINTER;
     }
 
-    if (allocator) {
-        if (!allocator->allocate && !allocator->free) {
-            return PAL_RESULT_INVALID_ALLOCATOR;
-        }
+    // WaitOnAddress takes other sizes, but the Linux futex does not
+    if (size != sizeof(Int32) || ((uintptr_t)address & 3)) {
+        return PAL_RESULT_INVALID_ARGUMENT;
     }
 
-    PalMutex* mutex = palAllocate(allocator, sizeof(PalMutex), 0);
-    if (!mutex) {
-        return PAL_RESULT_OUT_OF_MEMORY;
+    DWORD timeout = INFINITE;
+    if (milliseconds < INFINITE) {
+        timeout = (DWORD)milliseconds;
+    } else if (milliseconds != PAL_WAIT_INFINITE) {
+        timeout = INFINITE - 1;
     }
 
-    InitializeCriticalSection(&mutex->sc);
-    mutex->allocator = allocator;
-    *outMutex = mutex;
-    return PAL_RESULT_SUCCESS;
-}
+    // clang-format off
+    BOOL ret = WaitOnAddress(
+        address, 
+        (PVOID)compareAddress, 
+        size, 
+        timeout);
+    // clang-format on
 
-void PAL_CALL palDestroyMutex(PalMutex* mutex)
-{
-    if (mutex) {
-        DeleteCriticalSection(&mutex->sc);
-        palFree(mutex->allocator, mutex);
+    if (!ret && GetLastError() == ERROR_TIMEOUT) {
+        return PAL_RESULT_TIMEOUT;
     }
+    return PAL_RESULT_SUCCESS;
 }
 
-void PAL_CALL palLockMutex(PalMutex* mutex)
+void PAL_CALL palWakeByAddressSingle(volatile void* address)
 {
-    if (mutex) {
-        EnterCriticalSection(&mutex->sc);
+    if (address) {
+        WakeByAddressSingle((PVOID)address);
     }
 }
 
-void PAL_CALL palUnlockMutex(PalMutex* mutex)
+void PAL_CALL palWakeByAddressAll(volatile void* address)
 {
-    if (mutex) {
-        LeaveCriticalSection(&mutex->sc);
+    if (address) {
+        WakeByAddressAll((PVOID)address);
     }
 }
 
 // ==================================================
-// Condition Variable
+// Reader-Writer Lock
 // ==================================================
 
-PalResult PAL_CALL palCreateCondVar(
+PalResult PAL_CALL palCreateRWLock(
     const PalAllocator* allocator,
-    PalCondVar** outCondVar)
+    PalRWLock** outLock)
 {
-    if (!outCondVar) {
+    if (!outLock) {
         return PAL_RESULT_NULL_POINTER;
     }
 
     if (allocator) {
-        if (!allocator->allocate && !allocator->free) {
+        if (!allocator->allocate || !allocator->free) {
             return PAL_RESULT_INVALID_ALLOCATOR;
         }
     }
 
-    PalCondVar* condVar = palAllocate(allocator, sizeof(PalCondVar), 0);
-    if (!condVar) {
+    PalRWLock* lock = palAllocate(allocator, sizeof(PalRWLock), 0);
+    if (!lock) {
         return PAL_RESULT_OUT_OF_MEMORY;
     }
 
-    InitializeConditionVariable(&condVar->cv);
-    condVar->allocator = allocator;
-    *outCondVar = condVar;
+    InitializeSRWLock(&lock->srw);
+    lock->allocator = allocator;
+    *outLock = lock;
     return PAL_RESULT_SUCCESS;
 }
 
-void PAL_CALL palDestroyCondVar(PalCondVar* condVar)
+void PAL_CALL palDestroyRWLock(PalRWLock* lock)
 {
-    if (condVar) {
-        palFree(condVar->allocator, condVar);
+    if (lock) {
+        palFree(lock->allocator, lock);
     }
 }
 
-PalResult PAL_CALL palWaitCondVar(
-    PalCondVar* condVar,
-    PalMutex* mutex)
+void PAL_CALL palLockRWLockShared(PalRWLock* lock)
 {
-    if (!condVar || !mutex) {
-        return PAL_RESULT_NULL_POINTER;
+    if (lock) {
+        AcquireSRWLockShared(&lock->srw);
     }
+}
 
-    BOOL ret = SleepConditionVariableCS(&condVar->cv, &mutex->sc, INFINITE);
-    if (!ret) {
-        DWORD error = GetLastError();
-        if (error == ERROR_TIMEOUT) {
-            return PAL_RESULT_TIMEOUT;
-        } else {
-            return PAL_RESULT_PLATFORM_FAILURE;
-        }
+bool PAL_CALL palTryLockRWLockShared(PalRWLock* lock)
+{
+    if (!lock) {
+        return false;
     }
-    return PAL_RESULT_SUCCESS;
+    return TryAcquireSRWLockShared(&lock->srw) != 0;
 }
 
-PalResult PAL_CALL palWaitCondVarTimeout(
-    PalCondVar* condVar,
-    PalMutex* mutex,
-    Uint64 milliseconds)
+void PAL_CALL palUnlockRWLockShared(PalRWLock* lock)
 {
-    if (!condVar || !mutex) {
-        return PAL_RESULT_NULL_POINTER;
+    if (lock) {
+        ReleaseSRWLockShared(&lock->srw);
     }
+}
 
-    // clang-format off
-    BOOL ret = SleepConditionVariableCS(
-        &condVar->cv, 
-        &mutex->sc, 
-        (DWORD)milliseconds);
-    // clang-format on
-
-    if (!ret) {
-        DWORD error = GetLastError();
-        if (error == ERROR_TIMEOUT) {
-            return PAL_RESULT_TIMEOUT;
-        } else {
-            return PAL_RESULT_PLATFORM_FAILURE;
-        }
+void PAL_CALL palLockRWLockExclusive(PalRWLock* lock)
+{
+    if (lock) {
+        AcquireSRWLockExclusive(&lock->srw);
     }
-    return PAL_RESULT_SUCCESS;
 }
 
-void PAL_CALL palSignalCondVar(PalCondVar* condVar)
+bool PAL_CALL palTryLockRWLockExclusive(PalRWLock* lock)
 {
-    if (condVar) {
-        WakeConditionVariable(&condVar->cv);
+    if (!lock) {
+        return false;
     }
+    return TryAcquireSRWLockExclusive(&lock->srw) != 0;
 }
 
-void PAL_CALL palBroadcastCondVar(PalCondVar* condVar)
+void PAL_CALL palUnlockRWLockExclusive(PalRWLock* lock)
 {
-    if (condVar) {
-        WakeAllConditionVariable(&condVar->cv);
+    if (lock) {
+        ReleaseSRWLockExclusive(&lock->srw);
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,251 @@
+
+/**
+
+Copyright (C) 2025 Nicholas Agbo
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+
+ */
+
+// ==================================================
+// Includes
+// ==================================================
+
+#include "pal/pal_atomic.h"
+#include "pal/pal_thread.h"
+
+#include <string.h>
+
+// ==================================================
+// Typedefs, enums and structs
+// ==================================================
+
+// only a pointer lives in thread local storage, so on ELF it fits the
+// static TLS reserved for dlopen and skips __tls_get_addr on every access
+#if defined(_MSC_VER) && !defined(__clang__)
+#define PAL_THREAD_LOCAL __declspec(thread)
+#elif defined(_WIN32)
+#define PAL_THREAD_LOCAL __thread
+#else
+#define PAL_THREAD_LOCAL __thread __attribute__((tls_model("initial-exec")))
+#endif // _MSC_VER
+
+// destructors may set values again, like pthread keys we give up after this
+#define PAL_TLS_DESTRUCTOR_PASSES 4
+
+typedef struct {
+    void* value;
+    Int32 generation; // generation of the slot the value was set for
+} TLSEntry;
+
+typedef struct {
+    TLSEntry entries[PAL_MAX_TLS_SLOTS];
+} TLSBlock;
+
+typedef struct {
+    PaTlsDestructorFn destructor;
+    volatile Int32 generation; // 0 when the slot is free
+} TLSSlotInfo;
+
+static PAL_THREAD_LOCAL TLSBlock* s_Block = nullptr;
+static TLSSlotInfo s_Slots[PAL_MAX_TLS_SLOTS];
+static Int32 s_Generation = 0;
+static volatile Int32 s_Lock = 0;
+static PalTLSId s_ExitHook = 0;
+
+// ==================================================
+// Internal API
+// ==================================================
+
+static void lockSlots()
+{
+    // only creating and destroying slots take this
+    Int32 expected = 0;
+    while (!palAtomicCompareExchange32(
+        &s_Lock,
+        &expected,
+        1,
+        PAL_MEMORY_ORDER_ACQUIRE)) {
+        expected = 0;
+        palYield();
+    }
+}
+
+static void unlockSlots()
+{
+    palAtomicStore32(&s_Lock, 0, PAL_MEMORY_ORDER_RELEASE);
+}
+
+static TLSEntry* getLiveEntry(
+    TLSBlock* block,
+    Int32 index)
+{
+    // values set for a destroyed slot are stale once the slot is reused
+    TLSEntry* entry = &block->entries[index];
+    Int32 generation = palAtomicLoad32(
+        &s_Slots[index].generation,
+        PAL_MEMORY_ORDER_ACQUIRE);
+
+    if (generation == 0 || entry->generation != generation) {
+        return nullptr;
+    }
+    return entry;
+}
+
+static void runSlotDestructors(void* userData)
+{
+    TLSBlock* block = userData;
+
+    Int32 budget = PAL_MAX_TLS_SLOTS * PAL_TLS_DESTRUCTOR_PASSES;
+    while (budget-- > 0) {
+        // the newest slot with a value goes first
+        TLSEntry* newest = nullptr;
+        Int32 newestIndex = 0;
+        for (Int32 i = 0; i < PAL_MAX_TLS_SLOTS; i++) {
+            TLSEntry* entry = getLiveEntry(block, i);
+            if (!entry || !entry->value) {
+                continue;
+            }
+
+            if (!newest || entry->generation > newest->generation) {
+                newest = entry;
+                newestIndex = i;
+            }
+        }
+
+        if (!newest) {
+            break;
+        }
+
+        void* value = newest->value;
+        newest->value = nullptr;
+        PaTlsDestructorFn destructor = s_Slots[newestIndex].destructor;
+        if (destructor) {
+            destructor(value);
+        }
+    }
+
+    // a later destructor setting a slot gets a new block and hook
+    if (s_Block == block) {
+        s_Block = nullptr;
+    }
+    palFree(nullptr, block);
+}
+
+// ==================================================
+// Public API
+// ==================================================
+
+PalTLSSlot PAL_CALL palCreateTLSSlot(PaTlsDestructorFn destructor)
+{
+    PalTLSSlot slot = 0;
+    lockSlots();
+
+    // one TLS runs every slot destructor when a thread exits
+    if (!s_ExitHook) {
+        s_ExitHook = palCreateTLS(runSlotDestructors);
+    }
+
+    if (s_ExitHook) {
+        for (Int32 i = 0; i < PAL_MAX_TLS_SLOTS; i++) {
+            if (s_Slots[i].generation == 0) {
+                s_Slots[i].destructor = destructor;
+                palAtomicStore32(
+                    &s_Slots[i].generation,
+                    ++s_Generation,
+                    PAL_MEMORY_ORDER_RELEASE);
+
+                slot = (PalTLSSlot)i + 1;
+                break;
+            }
+        }
+    }
+
+    unlockSlots();
+    return slot;
+}
+
+void PAL_CALL palDestroyTLSSlot(PalTLSSlot slot)
+{
+    if (slot == 0 || slot > PAL_MAX_TLS_SLOTS) {
+        return;
+    }
+
+    lockSlots();
+    palAtomicStore32(
+        &s_Slots[slot - 1].generation,
+        0,
+        PAL_MEMORY_ORDER_RELEASE);
+
+    unlockSlots();
+}
+
+void* PAL_CALL palGetTLSSlot(PalTLSSlot slot)
+{
+    if (slot == 0 || slot > PAL_MAX_TLS_SLOTS) {
+        return nullptr;
+    }
+
+    TLSBlock* block = s_Block;
+    if (!block) {
+        return nullptr;
+    }
+
+    TLSEntry* entry = getLiveEntry(block, (Int32)slot - 1);
+    if (!entry) {
+        return nullptr;
+    }
+    return entry->value;
+}
+
+void PAL_CALL palSetTLSSlot(
+    PalTLSSlot slot,
+    void* data)
+{
+    if (slot == 0 || slot > PAL_MAX_TLS_SLOTS) {
+        return;
+    }
+
+    Int32 index = (Int32)slot - 1;
+    Int32 generation = palAtomicLoad32(
+        &s_Slots[index].generation,
+        PAL_MEMORY_ORDER_ACQUIRE);
+
+    if (generation == 0) {
+        return;
+    }
+
+    TLSBlock* block = s_Block;
+    if (!block) {
+        // threads get a block the first time they store a value
+        if (!data) {
+            return;
+        }
+
+        block = palAllocate(nullptr, sizeof(TLSBlock), 0);
+        if (!block) {
+            return;
+        }
+
+        memset(block, 0, sizeof(TLSBlock));
+        palSetTLS(s_ExitHook, block);
+        s_Block = block;
+    }
+
+    block->entries[index].value = data;
+    block->entries[index].generation = generation;
+}
@@ -0,0 +1,130 @@
+
+/**
+
+Copyright (C) 2025 Nicholas Agbo
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+
+ */
+
+// ==================================================
+// Includes
+// ==================================================
+
+#include "pal/pal_thread.h"
+
+#include <string.h>
+
+// ==================================================
+// Internal API
+// ==================================================
+
+static Uint32 getDomainId(
+    const PalLogicalProcessor* processor,
+    PalCpuDomain domain)
+{
+    switch (domain) {
+        case PAL_CPU_DOMAIN_PROCESSOR:
+            return processor->index;
+
+        case PAL_CPU_DOMAIN_CORE:
+            return processor->core;
+
+        case PAL_CPU_DOMAIN_CACHE_L2:
+            return processor->cacheL2;
+
+        case PAL_CPU_DOMAIN_CACHE_L3:
+            return processor->cacheL3;
+
+        case PAL_CPU_DOMAIN_NUMA_NODE:
+            return processor->numaNode;
+
+        case PAL_CPU_DOMAIN_PACKAGE:
+            return processor->package;
+    }
+    return 0;
+}
+
+// ==================================================
+// Public API
+// ==================================================
+
+PalResult PAL_CALL palEnumerateCpuDomains(
+    const PalAllocator* allocator,
+    PalCpuDomain domain,
+    Int32* count,
+    PalCpuSet* sets)
+{
+    if (!count) {
+        return PAL_RESULT_NULL_POINTER;
+    }
+
+    if (domain > PAL_CPU_DOMAIN_PACKAGE) {
+        return PAL_RESULT_INVALID_ARGUMENT;
+    }
+
+    Int32 processorCount = 0;
+    PalResult result;
+    result = palEnumerateLogicalProcessors(allocator, &processorCount, nullptr);
+    if (result != PAL_RESULT_SUCCESS) {
+        return result;
+    }
+
+    Uint64 size = sizeof(PalLogicalProcessor) * processorCount;
+    PalLogicalProcessor* processors = palAllocate(allocator, size, 0);
+    if (!processors) {
+        return PAL_RESULT_OUT_OF_MEMORY;
+    }
+
+    result = palEnumerateLogicalProcessors(
+        allocator,
+        &processorCount,
+        processors);
+
+    if (result != PAL_RESULT_SUCCESS) {
+        palFree(allocator, processors);
+        return result;
+    }
+
+    // ids are dense except processor indices and NUMA node numbers, so the
+    // highest id decides the count and some sets can be empty
+    Int32 domainCount = 0;
+    for (Int32 i = 0; i < processorCount; i++) {
+        Int32 id = (Int32)getDomainId(&processors[i], domain);
+        if (id + 1 > domainCount) {
+            domainCount = id + 1;
+        }
+    }
+
+    if (!sets) {
+        *count = domainCount;
+        palFree(allocator, processors);
+        return PAL_RESULT_SUCCESS;
+    }
+
+    Int32 maxSets = *count < domainCount ? *count : domainCount;
+    memset(sets, 0, sizeof(PalCpuSet) * (maxSets > 0 ? maxSets : 0));
+    for (Int32 i = 0; i < processorCount; i++) {
+        Int32 id = (Int32)getDomainId(&processors[i], domain);
+        if (id < maxSets) {
+            palAddCpuToSet(&sets[id], processors[i].index);
+        }
+    }
+
+    palFree(allocator, processors);
+    return PAL_RESULT_SUCCESS;
+}
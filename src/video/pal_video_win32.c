@@ -43,6 +43,8 @@ freely, subject to the following restrictions:
 #include <windows.h>
 #include <windowsx.h>
 
+#include "pal_profiler_internal.h"
+
 // ==================================================
 // Typedefs, enums and structs
 // ==================================================
@@ -1277,6 +1279,7 @@ void PAL_CALL palUpdateVideo()
         return;
     }
 
+    PAL_ZONE_BEGIN("palUpdateVideo");
     s_Mouse.dx = 0;
     s_Mouse.dy = 0;
 
@@ -1309,6 +1312,8 @@ void PAL_CALL palUpdateVideo()
         palPushEvent(s_Video.eventDriver, &event);
         s_Event.pendingMove = false;
     }
+
+    PAL_ZONE_END();
 }
 
 PalVideoFeatures PAL_CALL palGetVideoFeatures()
@@ -0,0 +1,114 @@
+#include "pal/pal_atomic.h"
+#include "pal/pal_thread.h"
+#include "tests.h"
+
+#define ITERATIONS 100000
+#define THREAD_COUNT 4
+
+typedef struct {
+    volatile Int32 counter32;
+    volatile Int64 counter64;
+    volatile Int32 casCounter;
+    volatile Int32 spinLock;
+    Int32 lockedCounter; // only changed while spinLock is held
+} SharedData;
+
+static void* PAL_CALL worker(void* arg)
+{
+    SharedData* data = arg;
+    for (Int32 i = 0; i < ITERATIONS; i++) {
+        // plain counters do not need ordering with other memory
+        palAtomicFetchAdd32(&data->counter32, 1, PAL_MEMORY_ORDER_RELAXED);
+        palAtomicFetchAdd64(&data->counter64, 2, PAL_MEMORY_ORDER_RELAXED);
+
+        // a compare exchange loop, the usual way to build lock-free updates
+        Int32 value = palAtomicLoad32(
+            &data->casCounter,
+            PAL_MEMORY_ORDER_RELAXED);
+
+        while (!palAtomicCompareExchange32(
+            &data->casCounter,
+            &value,
+            value + 1,
+            PAL_MEMORY_ORDER_RELAXED)) {
+            palCpuPause();
+        }
+
+        // a spin lock. Acquire on lock and release on unlock order the
+        // plain counter
+        while (palAtomicExchange32(
+            &data->spinLock,
+            1,
+            PAL_MEMORY_ORDER_ACQUIRE)) {
+            palCpuPause();
+        }
+
+        data->lockedCounter++;
+        palAtomicStore32(&data->spinLock, 0, PAL_MEMORY_ORDER_RELEASE);
+    }
+    return nullptr;
+}
+
+bool atomicTest()
+{
+    palLog(nullptr, "");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "Atomic Test");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "");
+
+    PalResult result;
+    PalThread* threads[THREAD_COUNT];
+    SharedData data = {0};
+
+    PalThreadCreateInfo createInfo = {0};
+    createInfo.entry = worker;
+    createInfo.arg = &data;
+    createInfo.stackSize = 0;       // default
+    createInfo.allocator = nullptr; // default
+    for (Int32 i = 0; i < THREAD_COUNT; i++) {
+        result = palCreateThread(&createInfo, &threads[i]);
+        if (result != PAL_RESULT_SUCCESS) {
+            const char* error = palFormatResult(result);
+            palLog(nullptr, "Failed to create thread: %s", error);
+            return false;
+        }
+    }
+
+    for (Int32 i = 0; i < THREAD_COUNT; i++) {
+        palJoinThread(threads[i], nullptr);
+        palDetachThread(threads[i]);
+    }
+
+    // pointers are swapped the same way
+    static Int32 first = 1;
+    static Int32 second = 2;
+    void* volatile ptr = &first;
+    void* expected = &first;
+    palAtomicCompareExchangePtr(
+        &ptr,
+        &expected,
+        &second,
+        PAL_MEMORY_ORDER_SEQ_CST);
+
+    Int32* current = palAtomicLoadPtr(&ptr, PAL_MEMORY_ORDER_ACQUIRE);
+    palAtomicThreadFence(PAL_MEMORY_ORDER_SEQ_CST);
+
+    Int32 expected32 = ITERATIONS * THREAD_COUNT;
+    palLog(nullptr, "Expected Counter: %d", expected32);
+    palLog(nullptr, "Fetch Add 32: %d", data.counter32);
+    palLog(nullptr, "Fetch Add 64: %lld", data.counter64 / 2);
+    palLog(nullptr, "Compare Exchange: %d", data.casCounter);
+    palLog(nullptr, "Spin Lock: %d", data.lockedCounter);
+    palLog(nullptr, "Pointer: %d", *current);
+
+    if (data.counter32 != expected32 || data.counter64 != expected32 * 2ll) {
+        return false;
+    }
+
+    if (data.casCounter != expected32 || data.lockedCounter != expected32) {
+        return false;
+    }
+
+    return *current == second;
+}
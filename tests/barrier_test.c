@@ -0,0 +1,198 @@
+#include "pal/pal_atomic.h"
+#include "pal/pal_thread.h"
+#include "tests.h"
+
+#include <string.h> // for memset
+
+#define ROUNDS 1000
+#define MAX_THREADS 64
+
+typedef struct {
+    PalBarrier* barrier;
+    Int32 count;
+    volatile Int32 serial;
+    volatile Int32 errors;
+    volatile Int32 phases[MAX_THREADS];
+
+    // the hand rolled barrier being replaced
+    PalMutex* mutex;
+    PalCondVar* condVar;
+    Int32 arrived;
+    Int32 generation;
+} SharedData;
+
+typedef struct {
+    SharedData* data;
+    Int32 index;
+} WorkerData;
+
+static void checkPhases(
+    SharedData* data,
+    Int32 round)
+{
+    // every thread must have finished this round before any leaves it
+    for (Int32 i = 0; i < data->count; i++) {
+        Int32 phase = palAtomicLoad32(
+            &data->phases[i],
+            PAL_MEMORY_ORDER_RELAXED);
+
+        if (phase < round) {
+            palAtomicFetchAdd32(&data->errors, 1, PAL_MEMORY_ORDER_RELAXED);
+        }
+    }
+}
+
+static void* PAL_CALL barrierWorker(void* arg)
+{
+    WorkerData* worker = arg;
+    SharedData* data = worker->data;
+    for (Int32 i = 1; i <= ROUNDS; i++) {
+        palAtomicStore32(
+            &data->phases[worker->index],
+            i,
+            PAL_MEMORY_ORDER_RELAXED);
+
+        if (palWaitBarrier(data->barrier)) {
+            palAtomicFetchAdd32(&data->serial, 1, PAL_MEMORY_ORDER_RELAXED);
+        }
+        checkPhases(data, i);
+    }
+    return nullptr;
+}
+
+static void* PAL_CALL condVarWorker(void* arg)
+{
+    WorkerData* worker = arg;
+    SharedData* data = worker->data;
+    for (Int32 i = 1; i <= ROUNDS; i++) {
+        palAtomicStore32(
+            &data->phases[worker->index],
+            i,
+            PAL_MEMORY_ORDER_RELAXED);
+
+        palLockMutex(data->mutex);
+        Int32 generation = data->generation;
+        if (++data->arrived == data->count) {
+            data->arrived = 0;
+            data->generation++;
+            palBroadcastCondVar(data->condVar);
+        } else {
+            while (generation == data->generation) {
+                palWaitCondVar(data->condVar, data->mutex);
+            }
+        }
+        palUnlockMutex(data->mutex);
+        checkPhases(data, i);
+    }
+    return nullptr;
+}
+
+static bool runWorkers(
+    SharedData* data,
+    PalThreadFn entry,
+    double* outTime)
+{
+    PalThread* threads[MAX_THREADS];
+    WorkerData workers[MAX_THREADS];
+
+    PalThreadCreateInfo createInfo = {0};
+    createInfo.entry = entry;
+    createInfo.stackSize = 0;       // default
+    createInfo.allocator = nullptr; // default
+
+    memset((void*)data->phases, 0, sizeof(data->phases));
+    Uint64 start = palGetPerformanceCounter();
+    for (Int32 i = 0; i < data->count; i++) {
+        workers[i].data = data;
+        workers[i].index = i;
+        createInfo.arg = &workers[i];
+
+        PalResult result = palCreateThread(&createInfo, &threads[i]);
+        if (result != PAL_RESULT_SUCCESS) {
+            const char* error = palFormatResult(result);
+            palLog(nullptr, "Failed to create thread: %s", error);
+            return false;
+        }
+    }
+
+    for (Int32 i = 0; i < data->count; i++) {
+        palJoinThread(threads[i], nullptr);
+        palDetachThread(threads[i]);
+    }
+
+    Uint64 end = palGetPerformanceCounter();
+    *outTime = (double)(end - start) / palGetPerformanceFrequency();
+    return true;
+}
+
+bool barrierTest()
+{
+    palLog(nullptr, "");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "Barrier Test");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "");
+
+    PalResult result;
+    SharedData* data = palAllocate(nullptr, sizeof(SharedData), 0);
+    if (!data) {
+        palLog(nullptr, "Failed to allocate memory");
+        return false;
+    }
+    memset(data, 0, sizeof(SharedData));
+
+    result = palCreateMutex(nullptr, &data->mutex);
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to create mutex: %s", error);
+        return false;
+    }
+
+    result = palCreateCondVar(nullptr, &data->condVar);
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to create condition variable: %s", error);
+        return false;
+    }
+
+    // round trip latency is the time for all threads to pass one phase
+    Int32 expectedSerial = 0;
+    for (Int32 count = 2; count <= MAX_THREADS; count *= 2) {
+        result = palCreateBarrier(nullptr, count, &data->barrier);
+        if (result != PAL_RESULT_SUCCESS) {
+            const char* error = palFormatResult(result);
+            palLog(nullptr, "Failed to create barrier: %s", error);
+            return false;
+        }
+
+        double condVarTime = 0.0;
+        double barrierTime = 0.0;
+        data->count = count;
+        if (!runWorkers(data, condVarWorker, &condVarTime)) {
+            return false;
+        }
+
+        if (!runWorkers(data, barrierWorker, &barrierTime)) {
+            return false;
+        }
+
+        palDestroyBarrier(data->barrier);
+        expectedSerial += ROUNDS;
+        palLog(
+            nullptr,
+            "Threads %d: condvar %f us, barrier %f us per round",
+            count,
+            condVarTime * 1000000.0 / ROUNDS,
+            barrierTime * 1000000.0 / ROUNDS);
+    }
+
+    palLog(nullptr, "Expected Serial Threads: %d", expectedSerial);
+    palLog(nullptr, "Serial Threads: %d", data->serial);
+    palLog(nullptr, "Phase Errors: %d", data->errors);
+    bool success = data->serial == expectedSerial && data->errors == 0;
+
+    palDestroyCondVar(data->condVar);
+    palDestroyMutex(data->mutex);
+    palFree(nullptr, data);
+    return success;
+}
@@ -0,0 +1,188 @@
+
+#include "pal/pal_thread.h"
+#include "tests.h"
+
+static const char* s_DomainNames[] = {
+    "Processor",
+    "Core",
+    "L2 Cache",
+    "L3 Cache",
+    "NUMA Node",
+    "Package"};
+
+static Int32 countCpus(const PalCpuSet* set)
+{
+    Int32 count = 0;
+    for (Uint32 i = 0; i < PAL_MAX_CPU_SET_SIZE; i++) {
+        count += palIsCpuInSet(set, i);
+    }
+    return count;
+}
+
+static bool checkDomain(
+    PalCpuDomain domain,
+    const PalLogicalProcessor* processors,
+    Int32 processorCount)
+{
+    Int32 count = 0;
+    PalResult result = palEnumerateCpuDomains(nullptr, domain, &count, nullptr);
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to enumerate cpu domains: %s", error);
+        return false;
+    }
+
+    PalCpuSet* sets = palAllocate(nullptr, sizeof(PalCpuSet) * count, 0);
+    if (!sets) {
+        palLog(nullptr, "Failed to allocate cpu sets");
+        return false;
+    }
+
+    result = palEnumerateCpuDomains(nullptr, domain, &count, sets);
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to enumerate cpu domains: %s", error);
+        palFree(nullptr, sets);
+        return false;
+    }
+
+    // every processor is in exactly one set of a domain
+    Int32 total = 0;
+    for (Int32 i = 0; i < count; i++) {
+        total += countCpus(&sets[i]);
+    }
+
+    for (Int32 i = 0; i < processorCount; i++) {
+        Int32 found = 0;
+        for (Int32 j = 0; j < count; j++) {
+            found += palIsCpuInSet(&sets[j], processors[i].index);
+        }
+
+        if (found != 1) {
+            Uint32 index = processors[i].index;
+            palLog(nullptr, "Processor %u is in %d sets", index, found);
+            palFree(nullptr, sets);
+            return false;
+        }
+    }
+
+    palLog(
+        nullptr,
+        "%s: %d sets, %d processors",
+        s_DomainNames[domain],
+        count,
+        total);
+
+    palFree(nullptr, sets);
+    return total == processorCount;
+}
+
+static void* PAL_CALL pinnedWorker(void* arg)
+{
+    palSleep(50);
+    return nullptr;
+}
+
+bool cpuTopologyTest()
+{
+    palLog(nullptr, "");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "CPU Topology Test");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "");
+
+    Int32 count = 0;
+    PalResult result = palEnumerateLogicalProcessors(nullptr, &count, nullptr);
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to enumerate processors: %s", error);
+        return false;
+    }
+
+    Uint64 size = sizeof(PalLogicalProcessor) * count;
+    PalLogicalProcessor* processors = palAllocate(nullptr, size, 0);
+    if (!processors) {
+        palLog(nullptr, "Failed to allocate processors");
+        return false;
+    }
+
+    result = palEnumerateLogicalProcessors(nullptr, &count, processors);
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to enumerate processors: %s", error);
+        palFree(nullptr, processors);
+        return false;
+    }
+
+    palLog(nullptr, "Logical processors: %d", count);
+    for (Int32 i = 0; i < count; i++) {
+        PalLogicalProcessor* processor = &processors[i];
+        palLog(
+            nullptr,
+            "  CPU %u: core %u, L2 %u, L3 %u, node %u, package %u",
+            processor->index,
+            processor->core,
+            processor->cacheL2,
+            processor->cacheL3,
+            processor->numaNode,
+            processor->package);
+    }
+    palLog(nullptr, "");
+
+    for (Int32 i = PAL_CPU_DOMAIN_PROCESSOR; i <= PAL_CPU_DOMAIN_PACKAGE; i++) {
+        if (!checkDomain((PalCpuDomain)i, processors, count)) {
+            palFree(nullptr, processors);
+            return false;
+        }
+    }
+
+    // pin a thread to the first core and read it back
+    if (!(palGetThreadFeatures() & PAL_THREAD_FEATURE_AFFINITY)) {
+        palFree(nullptr, processors);
+        return true;
+    }
+
+    PalCpuSet core = {0};
+    for (Int32 i = 0; i < count; i++) {
+        if (processors[i].core == 0) {
+            palAddCpuToSet(&core, processors[i].index);
+        }
+    }
+    palFree(nullptr, processors);
+
+    PalThreadCreateInfo createInfo = {0};
+    createInfo.entry = pinnedWorker;
+    PalThread* thread = nullptr;
+    result = palCreateThread(&createInfo, &thread);
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to create thread: %s", error);
+        return false;
+    }
+
+    PalCpuSet set = {0};
+    result = palSetThreadCpuSet(thread, &core);
+    if (result == PAL_RESULT_SUCCESS) {
+        result = palGetThreadCpuSet(thread, &set);
+    }
+
+    palJoinThread(thread, nullptr);
+    palDetachThread(thread);
+
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to pin thread: %s", error);
+        return false;
+    }
+
+    for (Uint32 i = 0; i < PAL_MAX_CPU_SET_SIZE / 64; i++) {
+        if (set.bits[i] != core.bits[i]) {
+            palLog(nullptr, "Thread cpu set does not match");
+            return false;
+        }
+    }
+
+    Int32 pinned = countCpus(&set);
+    palLog(nullptr, "Pinned a thread to core 0 (%d processors)", pinned);
+    return true;
+}
@@ -0,0 +1,134 @@
+
+#include "pal/pal_thread.h"
+#include "tests.h"
+
+#define GENERATOR_COUNT 10
+#define SWITCH_COUNT 1000000
+
+typedef struct {
+    PalFiber* caller;
+    Int32 value;
+    bool running;
+} Generator;
+
+static void PAL_CALL generate(void* arg)
+{
+    // hand the caller one value per switch
+    Generator* generator = arg;
+    for (Int32 i = 0; i < GENERATOR_COUNT; i++) {
+        generator->value = i;
+        palSwitchToFiber(generator->caller);
+    }
+
+    // returning goes back to the caller
+    generator->running = false;
+}
+
+static void PAL_CALL pingPong(void* arg)
+{
+    PalFiber* caller = arg;
+    for (;;) {
+        palSwitchToFiber(caller);
+    }
+}
+
+bool fiberTest()
+{
+    palLog(nullptr, "");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "Fiber Test");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "");
+
+    PalFiber* mainFiber = nullptr;
+    PalResult result = palConvertThreadToFiber(nullptr, &mainFiber);
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to convert thread to fiber: %s", error);
+        return false;
+    }
+
+    Generator generator = {mainFiber, -1, true};
+    PalFiberCreateInfo createInfo = {0};
+    createInfo.entry = generate;
+    createInfo.arg = &generator;
+    createInfo.stackSize = 64 * 1024;
+
+    PalFiber* fiber = nullptr;
+    result = palCreateFiber(&createInfo, &fiber);
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to create fiber: %s", error);
+        palConvertFiberToThread();
+        return false;
+    }
+
+    // every switch must resume the generator where it left off
+    bool success = true;
+    Int32 expected = 0;
+    while (generator.running) {
+        palSwitchToFiber(fiber);
+        if (palGetCurrentFiber() != mainFiber) {
+            palLog(nullptr, "Wrong current fiber after a switch");
+            success = false;
+            break;
+        }
+
+        if (generator.running && generator.value != expected++) {
+            palLog(nullptr, "Generator returned %d", generator.value);
+            success = false;
+            break;
+        }
+    }
+    palDestroyFiber(fiber);
+
+    if (success && expected != GENERATOR_COUNT) {
+        palLog(nullptr, "Generator stopped after %d values", expected);
+        success = false;
+    }
+
+    if (success) {
+        palLog(nullptr, "Generator produced %d values", expected);
+    }
+
+    // round trips between the thread and a fiber
+    createInfo.entry = pingPong;
+    createInfo.arg = mainFiber;
+    createInfo.stackSize = 0;
+    result = palCreateFiber(&createInfo, &fiber);
+    if (success && result == PAL_RESULT_SUCCESS) {
+        Uint64 start = palGetPerformanceCounter();
+        for (Int32 i = 0; i < SWITCH_COUNT; i++) {
+            palSwitchToFiber(fiber);
+        }
+
+        Uint64 ticks = palGetPerformanceCounter() - start;
+        double ns = (double)ticks * 1000000000.0;
+        ns /= (double)palGetPerformanceFrequency();
+        palLog(
+            nullptr,
+            "Fiber switch: %.1f ns (%d round trips)",
+            ns / (SWITCH_COUNT * 2.0),
+            SWITCH_COUNT);
+
+        palDestroyFiber(fiber);
+
+    } else if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to create fiber: %s", error);
+        success = false;
+    }
+
+    result = palConvertFiberToThread();
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to convert fiber to thread: %s", error);
+        return false;
+    }
+
+    if (palGetCurrentFiber() != nullptr) {
+        palLog(nullptr, "Thread is still a fiber");
+        return false;
+    }
+    return success;
+}
@@ -0,0 +1,163 @@
+#include "pal/pal_atomic.h"
+#include "pal/pal_jobs.h"
+#include "tests.h"
+
+#include <string.h> // for memset
+
+#define GROUP_COUNT 256
+#define LEAF_COUNT 64
+#define WORK_COUNT 20000
+#define MAX_JOBS 32768 // enough for a whole tree on one worker
+
+static Uint64 s_Results[GROUP_COUNT * LEAF_COUNT];
+static volatile Int32 s_CreateFailures;
+
+static inline Uint64 work(Uint64 index)
+{
+    Uint64 seed = index + 1;
+    for (Int32 i = 0; i < WORK_COUNT; i++) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+    }
+    return seed;
+}
+
+static void PAL_CALL leafJob(
+    PalJobSystem* system,
+    PalJob* job,
+    void* userData)
+{
+    Uint64 index = (Uint64)(IntPtr)userData;
+    s_Results[index] = work(index);
+}
+
+static void PAL_CALL groupJob(
+    PalJobSystem* system,
+    PalJob* job,
+    void* userData)
+{
+    // fork the leaves as children. The group finishes when they finish
+    Uint64 group = (Uint64)(IntPtr)userData;
+    for (Uint64 i = 0; i < LEAF_COUNT; i++) {
+        void* index = (void*)(IntPtr)(group * LEAF_COUNT + i);
+        PalJob* leaf = palCreateJob(system, job, leafJob, index);
+        if (!leaf) {
+            palAtomicFetchAdd32(
+                &s_CreateFailures,
+                1,
+                PAL_MEMORY_ORDER_RELAXED);
+            continue;
+        }
+        palRunJob(system, leaf);
+    }
+}
+
+static void PAL_CALL rootJob(
+    PalJobSystem* system,
+    PalJob* job,
+    void* userData)
+{
+    for (Uint64 i = 0; i < GROUP_COUNT; i++) {
+        PalJob* group;
+        group = palCreateJob(system, job, groupJob, (void*)(IntPtr)i);
+        if (!group) {
+            palAtomicFetchAdd32(
+                &s_CreateFailures,
+                1,
+                PAL_MEMORY_ORDER_RELAXED);
+            continue;
+        }
+        palRunJob(system, group);
+    }
+}
+
+static Uint64 sumResults()
+{
+    Uint64 sum = 0;
+    for (Int32 i = 0; i < GROUP_COUNT * LEAF_COUNT; i++) {
+        sum += s_Results[i];
+    }
+    return sum;
+}
+
+bool jobsTest()
+{
+    palLog(nullptr, "");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "Jobs Test");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "");
+
+    Int32 processors = 0;
+    PalResult result;
+    result = palEnumerateLogicalProcessors(nullptr, &processors, nullptr);
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to enumerate processors: %s", error);
+        return false;
+    }
+
+    // the expected sum does not go through the job system
+    Uint64 expected = 0;
+    for (Uint64 i = 0; i < GROUP_COUNT * LEAF_COUNT; i++) {
+        expected += work(i);
+    }
+
+    // run the same job tree with 1 to all logical processors
+    double baseTime = 0.0;
+    for (Uint32 workers = 1; workers <= (Uint32)processors; workers++) {
+        PalJobSystemCreateInfo createInfo = {0};
+        createInfo.allocator = nullptr; // default
+        createInfo.workerCount = workers;
+        createInfo.maxJobsPerWorker = MAX_JOBS;
+        createInfo.stackSize = 0;     // default
+        createInfo.pinWorkers = true; // if supported
+
+        PalJobSystem* system = nullptr;
+        result = palCreateJobSystem(&createInfo, &system);
+        if (result != PAL_RESULT_SUCCESS) {
+            const char* error = palFormatResult(result);
+            palLog(nullptr, "Failed to create job system: %s", error);
+            return false;
+        }
+
+        memset(s_Results, 0, sizeof(s_Results));
+        s_CreateFailures = 0;
+
+        Uint64 start = palGetPerformanceCounter();
+        PalJob* root = palCreateJob(system, nullptr, rootJob, nullptr);
+        if (!root) {
+            palLog(nullptr, "Failed to create root job");
+            palDestroyJobSystem(system);
+            return false;
+        }
+        palRunJob(system, root);
+        palJobWait(system, root); // runs jobs while waiting
+        Uint64 end = palGetPerformanceCounter();
+
+        palDestroyJobSystem(system);
+
+        if (s_CreateFailures != 0) {
+            palLog(nullptr, "Failed to create %d jobs", s_CreateFailures);
+            return false;
+        }
+
+        if (sumResults() != expected) {
+            palLog(nullptr, "Job results do not match");
+            return false;
+        }
+
+        double time = (double)(end - start) / palGetPerformanceFrequency();
+        if (workers == 1) {
+            baseTime = time;
+        }
+
+        palLog(
+            nullptr,
+            "Workers %u: %f ms (%.2fx)",
+            workers,
+            time * 1000.0,
+            baseTime / time);
+    }
+
+    return true;
+}
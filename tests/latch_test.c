@@ -0,0 +1,82 @@
+#include "pal/pal_atomic.h"
+#include "pal/pal_thread.h"
+#include "tests.h"
+
+#define THREAD_COUNT 8
+
+typedef struct {
+    PalLatch* ready;
+    PalLatch* start;
+    volatile Int32 started;
+} SharedData;
+
+static void* PAL_CALL worker(void* arg)
+{
+    SharedData* data = arg;
+
+    // report ready, then wait for the main thread to start everyone
+    palCountDownLatch(data->ready, 1);
+    palWaitLatch(data->start);
+    palAtomicFetchAdd32(&data->started, 1, PAL_MEMORY_ORDER_RELAXED);
+    return nullptr;
+}
+
+bool latchTest()
+{
+    palLog(nullptr, "");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "Latch Test");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "");
+
+    PalResult result;
+    PalThread* threads[THREAD_COUNT];
+    SharedData data = {0};
+
+    result = palCreateLatch(nullptr, THREAD_COUNT, &data.ready);
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to create latch: %s", error);
+        return false;
+    }
+
+    result = palCreateLatch(nullptr, 1, &data.start);
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to create latch: %s", error);
+        return false;
+    }
+
+    PalThreadCreateInfo createInfo = {0};
+    createInfo.entry = worker;
+    createInfo.arg = &data;
+    createInfo.stackSize = 0;       // default
+    createInfo.allocator = nullptr; // default
+    for (Int32 i = 0; i < THREAD_COUNT; i++) {
+        result = palCreateThread(&createInfo, &threads[i]);
+        if (result != PAL_RESULT_SUCCESS) {
+            const char* error = palFormatResult(result);
+            palLog(nullptr, "Failed to create thread: %s", error);
+            return false;
+        }
+    }
+
+    palWaitLatch(data.ready);
+    Int32 early = palAtomicLoad32(&data.started, PAL_MEMORY_ORDER_RELAXED);
+    bool closed = !palTryWaitLatch(data.start);
+    palLog(nullptr, "Ready: %d threads, %d started early", THREAD_COUNT, early);
+
+    palCountDownLatch(data.start, 1);
+    for (Int32 i = 0; i < THREAD_COUNT; i++) {
+        palJoinThread(threads[i], nullptr);
+        palDetachThread(threads[i]);
+    }
+
+    // an open latch stays open
+    bool open = palTryWaitLatch(data.start);
+    palLog(nullptr, "Started: %d threads", data.started);
+
+    palDestroyLatch(data.ready);
+    palDestroyLatch(data.start);
+    return early == 0 && closed && open && data.started == THREAD_COUNT;
+}
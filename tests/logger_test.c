@@ -1,6 +1,8 @@
 
 #include "tests.h"
 
+#include <string.h> // for strstr
+
 #define LOGGER_COUNT 4
 
 // clang-format off
@@ -11,6 +13,9 @@ static const char* g_LoggerNames[LOGGER_COUNT] = {
     "Logger4"};
 // clang-format on
 
+static Int32 s_Delivered = 0;
+static Int32 s_Discarded = 0; // delivered messages that should be filtered
+
 static void PAL_CALL onLogger(
     void* userData,
     const char* msg)
@@ -21,6 +26,11 @@ static void PAL_CALL onLogger(
     // recursive call and pal will discard the log. palLog(myLogger, "%s - %s",
     // "Logger1 -", msg);
 
+    s_Delivered++;
+    if (strstr(msg, "discarded")) {
+        s_Discarded++;
+    }
+
     char* name = (char*)userData;
     palLog(nullptr, "%s: %s", name, msg);
 }
@@ -37,6 +47,8 @@ bool loggerTest()
     for (Int32 i = 0; i < LOGGER_COUNT; i++) {
         loggers[i].callback = onLogger;
         loggers[i].userData = (void*)g_LoggerNames[i];
+        loggers[i].level = PAL_LOG_LEVEL_TRACE; // accept all levels
+        loggers[i].categories = 0;              // accept all categories
     }
 
     for (Int32 i = 0; i < LOGGER_COUNT; i++) {
@@ -44,5 +56,46 @@ bool loggerTest()
         palLog(&loggers[i], "This is directed to a logger");
     }
 
+    // the last logger only accepts warnings and thread messages. Filtered
+    // messages are discarded before they are formatted
+    PalLogger* filtered = &loggers[LOGGER_COUNT - 1];
+    filtered->level = PAL_LOG_LEVEL_WARN;
+    filtered->categories = PAL_LOG_CATEGORY_THREAD;
+    s_Delivered = 0;
+
+    palLogEx(filtered, PAL_LOG_LEVEL_INFO, 0, "This will be discarded");
+    palLogEx(filtered, PAL_LOG_LEVEL_WARN, 0, "This is an uncategorized warn");
+    palLogEx(
+        filtered,
+        PAL_LOG_LEVEL_ERROR,
+        PAL_LOG_CATEGORY_VIDEO,
+        "This will be discarded");
+
+    palLogEx(
+        filtered,
+        PAL_LOG_LEVEL_ERROR,
+        PAL_LOG_CATEGORY_THREAD,
+        "This is a thread error");
+
+    if (s_Delivered != 2 || s_Discarded != 0) {
+        palLog(nullptr, "Filtered logger got %d messages", s_Delivered);
+        return false;
+    }
+
+    // the macros are compiled out below PAL_LOG_LEVEL from pal_config.h
+    PAL_LOG_DEBUG(&loggers[0], PAL_LOG_CATEGORY_USER, "Debug %d", 1);
+    PAL_LOG_WARN(&loggers[0], PAL_LOG_CATEGORY_USER, "Warn %d", 2);
+
+#if PAL_LOG_LEVEL <= 3
+    // the logger argument is evaluated once
+    Int32 index = 0;
+    s_Delivered = 0;
+    PAL_LOG_WARN(&loggers[index++], PAL_LOG_CATEGORY_USER, "Warn %d", 3);
+    if (index != 1 || s_Delivered != 1) {
+        palLog(nullptr, "Log macro evaluated the logger %d times", index);
+        return false;
+    }
+#endif // PAL_LOG_LEVEL
+
     return true;
 }
\ No newline at end of file
@@ -0,0 +1,130 @@
+#include "pal/pal_thread.h"
+#include "tests.h"
+
+#define ITERATIONS 100000
+#define THREAD_COUNT 4
+
+typedef struct {
+    PalMutex* mutex;
+    Int32 counter;
+} SharedData;
+
+static void* PAL_CALL worker(void* arg)
+{
+    SharedData* data = arg;
+    for (Int32 i = 0; i < ITERATIONS; i++) {
+        palLockMutex(data->mutex);
+        data->counter++;
+        palUnlockMutex(data->mutex);
+    }
+    return nullptr;
+}
+
+static bool runMutex(
+    const char* name,
+    const PalMutexCreateInfo* info)
+{
+    PalResult result;
+    PalThread* threads[THREAD_COUNT];
+    SharedData data = {0};
+
+    result = palCreateMutexEx(info, &data.mutex);
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to create mutex: %s", error);
+        return false;
+    }
+
+    PalThreadCreateInfo createInfo = {0};
+    createInfo.entry = worker;
+    createInfo.arg = &data;
+    createInfo.stackSize = 0;       // default
+    createInfo.allocator = nullptr; // default
+
+    Uint64 frequency = palGetPerformanceFrequency();
+    Uint64 start = palGetPerformanceCounter();
+    for (Int32 i = 0; i < THREAD_COUNT; i++) {
+        result = palCreateThread(&createInfo, &threads[i]);
+        if (result != PAL_RESULT_SUCCESS) {
+            const char* error = palFormatResult(result);
+            palLog(nullptr, "Failed to create thread: %s", error);
+            return false;
+        }
+    }
+
+    for (Int32 i = 0; i < THREAD_COUNT; i++) {
+        palJoinThread(threads[i], nullptr);
+        palDetachThread(threads[i]);
+    }
+
+    Uint64 end = palGetPerformanceCounter();
+    double ms = (double)(end - start) * 1000.0 / (double)frequency;
+    palLog(nullptr, "%s: %.3f ms", name, ms);
+
+    bool success = data.counter == ITERATIONS * THREAD_COUNT;
+    if (info->enableStats) {
+        PalMutexStats stats;
+        result = palGetMutexStats(data.mutex, &stats);
+        if (result != PAL_RESULT_SUCCESS) {
+            const char* error = palFormatResult(result);
+            palLog(nullptr, "Failed to get mutex stats: %s", error);
+            palDestroyMutex(data.mutex);
+            return false;
+        }
+
+        double waitMs = (double)stats.waitTicks * 1000.0 / (double)frequency;
+        palLog(nullptr, "  Acquisitions: %llu", stats.acquisitions);
+        palLog(nullptr, "  Contentions: %llu", stats.contentions);
+        palLog(nullptr, "  Wait Time: %.3f ms", waitMs);
+
+        if (stats.acquisitions != (Uint64)data.counter) {
+            success = false;
+        }
+
+        if (stats.contentions > stats.acquisitions) {
+            success = false;
+        }
+    }
+
+    palDestroyMutex(data.mutex);
+    return success;
+}
+
+bool mutexStatsTest()
+{
+    palLog(nullptr, "");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "Mutex Stats Test");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "");
+
+    PalMutexCreateInfo info = {0};
+    info.allocator = nullptr; // default
+    info.spinCount = 0;       // default
+
+    if (!runMutex("Default", &info)) {
+        return false;
+    }
+
+    info.adaptive = true;
+    if (!runMutex("Adaptive", &info)) {
+        return false;
+    }
+
+    info.enableStats = true;
+    if (!runMutex("Adaptive With Stats", &info)) {
+        return false;
+    }
+
+    // stats are only available when enabled
+    PalMutex* mutex = nullptr;
+    PalMutexStats stats;
+    info.enableStats = false;
+    if (palCreateMutexEx(&info, &mutex) != PAL_RESULT_SUCCESS) {
+        return false;
+    }
+
+    PalResult result = palGetMutexStats(mutex, &stats);
+    palDestroyMutex(mutex);
+    return result == PAL_RESULT_INVALID_ARGUMENT;
+}
@@ -0,0 +1,119 @@
+#include "pal/pal_thread.h"
+#include "tests.h"
+
+#define BUCKET_COUNT 16
+#define ITERATIONS 100000
+#define THREAD_COUNT 4
+
+// the lock sits next to the data it guards, no allocation per bucket
+typedef struct {
+    PalMutexStorage storage;
+    PalMutex* mutex;
+    Int32 counter;
+} Bucket;
+
+typedef struct {
+    Bucket buckets[BUCKET_COUNT];
+    PalMutexStorage readyStorage;
+    PalCondVarStorage condVarStorage;
+    PalMutex* readyMutex;
+    PalCondVar* condVar;
+    bool ready;
+} SharedData;
+
+static void* PAL_CALL worker(void* arg)
+{
+    SharedData* data = arg;
+
+    // wait on an in place condition variable for the start signal
+    palLockMutex(data->readyMutex);
+    while (!data->ready) {
+        palWaitCondVar(data->condVar, data->readyMutex);
+    }
+    palUnlockMutex(data->readyMutex);
+
+    for (Int32 i = 0; i < ITERATIONS; i++) {
+        Bucket* bucket = &data->buckets[i % BUCKET_COUNT];
+        palLockMutex(bucket->mutex);
+        bucket->counter++;
+        palUnlockMutex(bucket->mutex);
+    }
+    return nullptr;
+}
+
+bool mutexStorageTest()
+{
+    palLog(nullptr, "");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "Mutex Storage Test");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "");
+
+    PalResult result;
+    PalThread* threads[THREAD_COUNT];
+    SharedData* data = palAllocate(nullptr, sizeof(SharedData), 0);
+    if (!data) {
+        palLog(nullptr, "Failed to allocate memory");
+        return false;
+    }
+
+    for (Int32 i = 0; i < BUCKET_COUNT; i++) {
+        Bucket* bucket = &data->buckets[i];
+        result = palInitMutex(&bucket->storage, nullptr, &bucket->mutex);
+        if (result != PAL_RESULT_SUCCESS) {
+            const char* error = palFormatResult(result);
+            palLog(nullptr, "Failed to init mutex: %s", error);
+            return false;
+        }
+        bucket->counter = 0;
+    }
+
+    palInitMutex(&data->readyStorage, nullptr, &data->readyMutex);
+    palInitCondVar(&data->condVarStorage, &data->condVar);
+    data->ready = false;
+
+    PalThreadCreateInfo createInfo = {0};
+    createInfo.entry = worker;
+    createInfo.arg = data;
+    createInfo.stackSize = 0;       // default
+    createInfo.allocator = nullptr; // default
+    for (Int32 i = 0; i < THREAD_COUNT; i++) {
+        result = palCreateThread(&createInfo, &threads[i]);
+        if (result != PAL_RESULT_SUCCESS) {
+            const char* error = palFormatResult(result);
+            palLog(nullptr, "Failed to create thread: %s", error);
+            return false;
+        }
+    }
+
+    Uint64 start = palGetPerformanceCounter();
+    palLockMutex(data->readyMutex);
+    data->ready = true;
+    palBroadcastCondVar(data->condVar);
+    palUnlockMutex(data->readyMutex);
+
+    for (Int32 i = 0; i < THREAD_COUNT; i++) {
+        palJoinThread(threads[i], nullptr);
+        palDetachThread(threads[i]);
+    }
+
+    Uint64 end = palGetPerformanceCounter();
+    double ms = (double)(end - start) * 1000.0 / palGetPerformanceFrequency();
+    palLog(nullptr, "Bucket Updates: %.3f ms", ms);
+
+    bool success = true;
+    Int32 expected = ITERATIONS / BUCKET_COUNT * THREAD_COUNT;
+    for (Int32 i = 0; i < BUCKET_COUNT; i++) {
+        if (data->buckets[i].counter != expected) {
+            palLog(nullptr, "Bucket %d: %d", i, data->buckets[i].counter);
+            success = false;
+        }
+        palDeinitMutex(data->buckets[i].mutex);
+    }
+
+    palLog(nullptr, "Expected Per Bucket: %d", expected);
+    palDeinitCondVar(data->condVar);
+    palDeinitMutex(data->readyMutex);
+    palFree(nullptr, data);
+    return success;
+}
@@ -0,0 +1,172 @@
+#include "pal/pal_atomic.h"
+#include "pal/pal_thread.h"
+#include "tests.h"
+
+#define HOLD_TIME 100
+#define SHORT_TIMEOUT 20
+#define LONG_TIMEOUT 2000
+#define ITERATIONS 10000
+#define THREAD_COUNT 4
+
+typedef struct {
+    PalMutex* mutex;
+    volatile Int32 locked;
+    volatile Int64 releaseTime;
+} HolderData;
+
+typedef struct {
+    PalMutex* mutex;
+    Int32 counter;
+    volatile Int32 timeouts;
+} SharedData;
+
+static void* PAL_CALL holder(void* arg)
+{
+    HolderData* data = arg;
+    palLockMutex(data->mutex);
+    palAtomicStore32(&data->locked, 1, PAL_MEMORY_ORDER_RELEASE);
+    palSleep(HOLD_TIME);
+
+    Int64 now = (Int64)palGetPerformanceCounter();
+    palAtomicStore64(&data->releaseTime, now, PAL_MEMORY_ORDER_RELAXED);
+    palUnlockMutex(data->mutex);
+    return nullptr;
+}
+
+static void* PAL_CALL worker(void* arg)
+{
+    SharedData* data = arg;
+    for (Int32 i = 0; i < ITERATIONS; i++) {
+        // optional work is skipped rather than waited for
+        if (palLockMutexTimeout(data->mutex, 1) != PAL_RESULT_SUCCESS) {
+            palAtomicFetchAdd32(&data->timeouts, 1, PAL_MEMORY_ORDER_RELAXED);
+            continue;
+        }
+
+        data->counter++;
+        palUnlockMutex(data->mutex);
+    }
+    return nullptr;
+}
+
+static double toMilliseconds(Uint64 ticks)
+{
+    return (double)ticks * 1000.0 / (double)palGetPerformanceFrequency();
+}
+
+bool mutexTimeoutTest()
+{
+    palLog(nullptr, "");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "Mutex Timeout Test");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "");
+
+    PalResult result;
+    PalThread* thread = nullptr;
+    HolderData holderData = {0};
+
+    result = palCreateMutex(nullptr, &holderData.mutex);
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to create mutex: %s", error);
+        return false;
+    }
+
+    // an unlocked mutex is taken without waiting
+    if (!palTryLockMutex(holderData.mutex)) {
+        palLog(nullptr, "Failed to try lock an unlocked mutex");
+        return false;
+    }
+    palUnlockMutex(holderData.mutex);
+
+    PalThreadCreateInfo createInfo = {0};
+    createInfo.entry = holder;
+    createInfo.arg = &holderData;
+    createInfo.stackSize = 0;       // default
+    createInfo.allocator = nullptr; // default
+    result = palCreateThread(&createInfo, &thread);
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to create thread: %s", error);
+        return false;
+    }
+
+    while (!palAtomicLoad32(&holderData.locked, PAL_MEMORY_ORDER_ACQUIRE)) {
+        palYield();
+    }
+
+    // the holder keeps the mutex for HOLD_TIME
+    bool tryLocked = palTryLockMutex(holderData.mutex);
+    palLog(nullptr, "Try Lock While Held: %s", tryLocked ? "true" : "false");
+
+    Uint64 start = palGetPerformanceCounter();
+    PalResult shortResult = palLockMutexTimeout(
+        holderData.mutex,
+        SHORT_TIMEOUT);
+
+    double waited = toMilliseconds(palGetPerformanceCounter() - start);
+    palLog(nullptr, "Short Timeout: %s", palFormatResult(shortResult));
+    palLog(nullptr, "  Waited: %.3f ms (timeout %d ms)", waited, SHORT_TIMEOUT);
+
+    PalResult longResult = palLockMutexTimeout(holderData.mutex, LONG_TIMEOUT);
+    Uint64 acquired = palGetPerformanceCounter();
+    Uint64 released = (Uint64)palAtomicLoad64(
+        &holderData.releaseTime,
+        PAL_MEMORY_ORDER_RELAXED);
+
+    palLog(nullptr, "Long Timeout: %s", palFormatResult(longResult));
+    if (longResult == PAL_RESULT_SUCCESS) {
+        double latency = toMilliseconds(acquired - released);
+        palLog(nullptr, "  Handoff Latency: %.3f ms", latency);
+        palUnlockMutex(holderData.mutex);
+    }
+
+    palJoinThread(thread, nullptr);
+    palDetachThread(thread);
+    palDestroyMutex(holderData.mutex);
+
+    if (tryLocked || shortResult != PAL_RESULT_TIMEOUT) {
+        return false;
+    }
+
+    if (waited < SHORT_TIMEOUT || longResult != PAL_RESULT_SUCCESS) {
+        return false;
+    }
+
+    // contended timed locks must still exclude each other
+    PalThread* threads[THREAD_COUNT];
+    SharedData data = {0};
+    result = palCreateMutex(nullptr, &data.mutex);
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to create mutex: %s", error);
+        return false;
+    }
+
+    createInfo.entry = worker;
+    createInfo.arg = &data;
+    start = palGetPerformanceCounter();
+    for (Int32 i = 0; i < THREAD_COUNT; i++) {
+        result = palCreateThread(&createInfo, &threads[i]);
+        if (result != PAL_RESULT_SUCCESS) {
+            const char* error = palFormatResult(result);
+            palLog(nullptr, "Failed to create thread: %s", error);
+            return false;
+        }
+    }
+
+    for (Int32 i = 0; i < THREAD_COUNT; i++) {
+        palJoinThread(threads[i], nullptr);
+        palDetachThread(threads[i]);
+    }
+
+    double elapsed = toMilliseconds(palGetPerformanceCounter() - start);
+    palDestroyMutex(data.mutex);
+
+    Int32 total = ITERATIONS * THREAD_COUNT;
+    palLog(nullptr, "Contended Timed Locks: %.3f ms", elapsed);
+    palLog(nullptr, "  Acquired: %d", data.counter);
+    palLog(nullptr, "  Timed Out: %d", data.timeouts);
+    return data.counter + data.timeouts == total;
+}
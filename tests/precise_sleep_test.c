@@ -0,0 +1,121 @@
+
+#include "pal/pal_thread.h"
+#include "tests.h"
+
+#define FRAME_COUNT 200
+#define FRAME_TIME_NS 4000000ull // 250 frames per second
+#define SHORT_SLEEP_NS 100000ull
+
+typedef enum {
+    SLEEP_MILLISECONDS,
+    SLEEP_NANOSECONDS,
+    SLEEP_PRECISE
+} SleepMethod;
+
+static const char* s_MethodNames[] = {
+    "palSleep",
+    "palSleepNanoseconds",
+    "palPreciseSleepUntil"};
+
+static bool runFrames(SleepMethod method)
+{
+    // pace frames against absolute deadlines like a frame limiter would
+    Uint64 frequency = palGetPerformanceFrequency();
+    Uint64 period = FRAME_TIME_NS * frequency / 1000000000ull;
+    Uint64 deadline = palGetPerformanceCounter();
+
+    double total = 0.0;
+    double worst = 0.0;
+    Int32 early = 0;
+    for (Int32 i = 0; i < FRAME_COUNT; i++) {
+        deadline += period;
+        Uint64 now = palGetPerformanceCounter();
+        Uint64 wait = deadline > now ? deadline - now : 0;
+        Uint64 waitNs = wait * 1000000000ull / frequency;
+
+        switch (method) {
+            case SLEEP_MILLISECONDS:
+                palSleep(waitNs / 1000000ull);
+                break;
+
+            case SLEEP_NANOSECONDS:
+                palSleepNanoseconds(waitNs);
+                break;
+
+            case SLEEP_PRECISE:
+                palPreciseSleepUntil(deadline);
+                break;
+        }
+
+        now = palGetPerformanceCounter();
+        if (now < deadline) {
+            early++;
+            continue;
+        }
+
+        // jitter is how late the frame started, in microseconds
+        double late = (double)(now - deadline) * 1000000.0 / frequency;
+        total += late;
+        if (late > worst) {
+            worst = late;
+        }
+
+        // a late frame does not make the next one early
+        if (now - deadline > period) {
+            deadline = now;
+        }
+    }
+
+    palLog(
+        nullptr,
+        "%s: mean %.1f us, worst %.1f us, %d early",
+        s_MethodNames[method],
+        total / FRAME_COUNT,
+        worst,
+        early);
+
+    // the millisecond sleep truncates, only the others must not be early
+    return method == SLEEP_MILLISECONDS || early == 0;
+}
+
+bool preciseSleepTest()
+{
+    palLog(nullptr, "");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "Precise Sleep Test");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "");
+
+    // a short sleep must last at least as long as asked
+    Uint64 frequency = palGetPerformanceFrequency();
+    Uint64 start = palGetPerformanceCounter();
+    palSleepNanoseconds(SHORT_SLEEP_NS);
+    Uint64 ticks = palGetPerformanceCounter() - start;
+    Uint64 slept = ticks * 1000000000ull / frequency;
+
+    palLog(
+        nullptr,
+        "Sleep %llu us: took %.1f us",
+        SHORT_SLEEP_NS / 1000,
+        (double)slept / 1000.0);
+
+    if (slept < SHORT_SLEEP_NS) {
+        palLog(nullptr, "Sleep returned early");
+        return false;
+    }
+
+    palLog(
+        nullptr,
+        "Frame pacing, %d frames of %.1f ms:",
+        FRAME_COUNT,
+        FRAME_TIME_NS / 1000000.0);
+
+    for (Int32 i = SLEEP_MILLISECONDS; i <= SLEEP_PRECISE; i++) {
+        if (!runFrames((SleepMethod)i)) {
+            palLog(nullptr, "Frames started before their deadline");
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,411 @@
+
+#include "pal/pal_profiler.h"
+#include "tests.h"
+
+#if PAL_HAS_THREAD
+#include "pal/pal_thread.h"
+#endif // PAL_HAS_THREAD
+
+#include <stdio.h>
+#include <stdlib.h> // for getenv and strtoul
+#include <string.h> // for memcmp, memcpy and strstr
+
+#define FRAME_COUNT 10
+#define WORK_COUNT 100000
+#define THREAD_COUNT 4
+#define EVENTS_PER_FRAME 6 // a frame zone around two work zones
+#define MAX_THREADS 16
+
+// a simple writer that counts the exported bytes and writes them to a file
+typedef struct {
+    FILE* file;
+    Uint64 size;
+} ExportData;
+
+// begin and end events of one thread
+typedef struct {
+    Uint32 threadId;
+    Int32 depth;
+} ThreadEvents;
+
+typedef struct {
+    ThreadEvents threads[MAX_THREADS];
+    Uint32 threadCount;
+    Uint32 eventCount;
+    bool balanced;
+} TraceCheck;
+
+static void PAL_CALL onWrite(
+    void* userData,
+    const void* data,
+    Uint64 size)
+{
+    ExportData* exportData = userData;
+    exportData->size += size;
+    if (exportData->file) {
+        fwrite(data, 1, (size_t)size, exportData->file);
+    }
+}
+
+static Uint64 doWork(Uint64 seed)
+{
+    palProfileBegin("doWork");
+    for (Int32 i = 0; i < WORK_COUNT; i++) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+    }
+    palProfileEnd();
+    return seed;
+}
+
+static Uint64 recordFrames(Uint64 seed)
+{
+    // record nested zones. Names must outlive the export
+    for (Int32 i = 0; i < FRAME_COUNT; i++) {
+        palProfileBegin("frame");
+        seed = doWork(seed);
+        seed = doWork(seed);
+        palProfileEnd();
+    }
+    return seed;
+}
+
+#if PAL_HAS_THREAD
+static void* PAL_CALL recordWorker(void* arg)
+{
+    UintPtr seed = (UintPtr)arg;
+    seed = (UintPtr)recordFrames(seed);
+    return (void*)seed;
+}
+#endif // PAL_HAS_THREAD
+
+static void addEvent(
+    TraceCheck* check,
+    Uint32 threadId,
+    bool begin)
+{
+    ThreadEvents* thread = nullptr;
+    for (Uint32 i = 0; i < check->threadCount; i++) {
+        if (check->threads[i].threadId == threadId) {
+            thread = &check->threads[i];
+            break;
+        }
+    }
+
+    if (!thread) {
+        if (check->threadCount == MAX_THREADS) {
+            check->balanced = false;
+            return;
+        }
+
+        thread = &check->threads[check->threadCount++];
+        thread->threadId = threadId;
+        thread->depth = 0;
+    }
+
+    thread->depth += begin ? 1 : -1;
+    if (thread->depth < 0) {
+        // an end without a begin
+        check->balanced = false;
+    }
+    check->eventCount++;
+}
+
+static bool isBalanced(TraceCheck* check)
+{
+    for (Uint32 i = 0; i < check->threadCount; i++) {
+        if (check->threads[i].depth != 0) {
+            return false;
+        }
+    }
+    return check->balanced;
+}
+
+static char* readFile(
+    const char* path,
+    Uint64* outSize)
+{
+    // null terminated so JSON can be searched as a string
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        return nullptr;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (size < 0) {
+        fclose(file);
+        return nullptr;
+    }
+
+    char* data = palAllocate(nullptr, (Uint64)size + 1, 0);
+    if (data) {
+        size_t read = fread(data, 1, (size_t)size, file);
+        data[read] = '\0';
+        *outSize = read;
+    }
+
+    fclose(file);
+    return data;
+}
+
+static bool checkJson(
+    const char* data,
+    TraceCheck* check)
+{
+    // every event has a phase followed by its thread id
+    const char* event = strstr(data, "\"ph\":\"");
+    while (event) {
+        bool begin = event[6] == 'B';
+        if (!begin && event[6] != 'E') {
+            return false;
+        }
+
+        const char* tid = strstr(event, "\"tid\":");
+        if (!tid) {
+            return false;
+        }
+
+        Uint32 threadId = (Uint32)strtoul(tid + 6, nullptr, 10);
+        addEvent(check, threadId, begin);
+        event = strstr(tid, "\"ph\":\"");
+    }
+    return true;
+}
+
+static bool readBytes(
+    const char* data,
+    Uint64 size,
+    Uint64* offset,
+    void* out,
+    Uint64 count)
+{
+    if (*offset + count > size) {
+        return false;
+    }
+
+    memcpy(out, data + *offset, count);
+    *offset += count;
+    return true;
+}
+
+static bool checkBinary(
+    const char* data,
+    Uint64 size,
+    TraceCheck* check)
+{
+    // see PalProfileFormat for the layout
+    Uint64 offset = 4;
+    Uint32 version = 0;
+    Uint64 frequency = 0;
+    Uint32 nameCount = 0;
+    Uint32 threadCount = 0;
+    if (size < 4 || memcmp(data, "PALP", 4) != 0) {
+        return false;
+    }
+
+    if (!readBytes(data, size, &offset, &version, sizeof(Uint32)) ||
+        !readBytes(data, size, &offset, &frequency, sizeof(Uint64)) ||
+        !readBytes(data, size, &offset, &nameCount, sizeof(Uint32)) ||
+        !readBytes(data, size, &offset, &threadCount, sizeof(Uint32))) {
+        return false;
+    }
+
+    for (Uint32 i = 0; i < nameCount; i++) {
+        Uint16 nameSize = 0;
+        if (!readBytes(data, size, &offset, &nameSize, sizeof(Uint16))) {
+            return false;
+        }
+        offset += nameSize;
+    }
+
+    for (Uint32 i = 0; i < threadCount; i++) {
+        Uint32 header[2]; // thread id and event count
+        if (!readBytes(data, size, &offset, header, sizeof(header))) {
+            return false;
+        }
+
+        for (Uint32 j = 0; j < header[1]; j++) {
+            Uint32 record[2]; // name index and type
+            Uint64 time;
+            if (!readBytes(data, size, &offset, record, sizeof(record)) ||
+                !readBytes(data, size, &offset, &time, sizeof(Uint64))) {
+                return false;
+            }
+
+            bool begin = record[1] == 0;
+            if (begin && record[0] >= nameCount) {
+                return false;
+            }
+            addEvent(check, header[0], begin);
+        }
+    }
+
+    // every exported thread has a buffer
+    return offset == size && threadCount == check->threadCount;
+}
+
+static bool exportAndCheck(
+    PalProfileFormat format,
+    const char* path,
+    Uint32 expectedThreads,
+    Uint32 expectedEvents)
+{
+    ExportData exportData = {0};
+    exportData.file = fopen(path, "wb");
+    if (!exportData.file) {
+        palLog(nullptr, "Failed to open %s", path);
+        return false;
+    }
+
+    PalResult result = palExportProfile(format, onWrite, &exportData);
+    fclose(exportData.file);
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to export profile: %s", error);
+        return false;
+    }
+
+    Uint64 size = 0;
+    char* data = readFile(path, &size);
+    if (!data) {
+        palLog(nullptr, "Failed to read %s", path);
+        return false;
+    }
+
+    TraceCheck check = {0};
+    check.balanced = true;
+    bool parsed;
+    if (format == PAL_PROFILE_FORMAT_CHROME_JSON) {
+        parsed = checkJson(data, &check);
+        palLog(nullptr, "Chrome trace size: %llu bytes", size);
+
+    } else {
+        parsed = checkBinary(data, size, &check);
+        palLog(nullptr, "Binary trace size: %llu bytes", size);
+    }
+    palFree(nullptr, data);
+
+    if (!parsed) {
+        palLog(nullptr, "Failed to parse the exported profile");
+        return false;
+    }
+
+    if (check.threadCount != expectedThreads) {
+        palLog(nullptr, "Exported %u threads", check.threadCount);
+        return false;
+    }
+
+    if (check.eventCount != expectedEvents) {
+        palLog(nullptr, "Exported %u events", check.eventCount);
+        return false;
+    }
+
+    if (!isBalanced(&check)) {
+        palLog(nullptr, "Begin and end events do not match");
+        return false;
+    }
+    return true;
+}
+
+bool profilerTest()
+{
+    palLog(nullptr, "");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "Profiler Test");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "");
+
+    // default allocator and default events per thread
+    PalResult result = palInitProfiler(nullptr, 0);
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to initialize profiler: %s", error);
+        return false;
+    }
+
+    // the main thread records too
+    Uint64 seed = recordFrames(1);
+    Uint32 threadCount = 1;
+
+#if PAL_HAS_THREAD
+    // other threads record into their own buffers while this one exports
+    PalThread* threads[THREAD_COUNT];
+    for (Int32 i = 0; i < THREAD_COUNT; i++) {
+        PalThreadCreateInfo createInfo = {0};
+        createInfo.entry = recordWorker;
+        createInfo.arg = (void*)(UintPtr)(i + 2);
+
+        result = palCreateThread(&createInfo, &threads[i]);
+        if (result != PAL_RESULT_SUCCESS) {
+            const char* error = palFormatResult(result);
+            palLog(nullptr, "Failed to create thread: %s", error);
+            return false;
+        }
+    }
+
+    // open zones make a concurrent export unbalanced, only check it works
+    for (Int32 i = 0; i < FRAME_COUNT; i++) {
+        ExportData exportData = {0};
+        result = palExportProfile(
+            PAL_PROFILE_FORMAT_BINARY,
+            onWrite,
+            &exportData);
+
+        if (result != PAL_RESULT_SUCCESS) {
+            const char* error = palFormatResult(result);
+            palLog(nullptr, "Failed to export profile: %s", error);
+            return false;
+        }
+    }
+
+    for (Int32 i = 0; i < THREAD_COUNT; i++) {
+        void* value = nullptr;
+        palJoinThread(threads[i], &value);
+        palDetachThread(threads[i]);
+        seed += (UintPtr)value;
+    }
+    threadCount += THREAD_COUNT;
+#endif // PAL_HAS_THREAD
+
+    // export to the temp directory and read the trace back
+    const char* dir = getenv("TMPDIR");
+    if (!dir) {
+        dir = getenv("TEMP");
+    }
+
+    char path[512];
+    snprintf(path, sizeof(path), "%s/pal_profile", dir ? dir : "/tmp");
+
+    // Chrome trace event JSON can be opened in chrome://tracing
+    Uint32 eventCount = threadCount * FRAME_COUNT * EVENTS_PER_FRAME;
+    bool success = exportAndCheck(
+        PAL_PROFILE_FORMAT_CHROME_JSON,
+        path,
+        threadCount,
+        eventCount);
+
+    // the binary format is more compact
+    if (success) {
+        success = exportAndCheck(
+            PAL_PROFILE_FORMAT_BINARY,
+            path,
+            threadCount,
+            eventCount);
+    }
+    remove(path);
+
+    // measure the cost of an empty zone
+    Uint64 start = palGetPerformanceCounter();
+    for (Int32 i = 0; i < 10000; i++) {
+        palProfileBegin("empty");
+        palProfileEnd();
+    }
+    Uint64 end = palGetPerformanceCounter();
+    double seconds = (double)(end - start) / palGetPerformanceFrequency();
+    palLog(nullptr, "Empty zone cost: %f ns", seconds * 1e9 / 10000);
+
+    palShutdownProfiler();
+    palLog(nullptr, "Seed: %llu", seed); // keep the work alive
+    return success;
+}
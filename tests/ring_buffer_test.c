@@ -0,0 +1,209 @@
+
+#include "pal/pal_atomic.h"
+#include "pal/pal_thread.h"
+#include "tests.h"
+
+#define ITEM_COUNT 200000 // per producer
+#define CAPACITY 1024
+#define MAX_THREADS 8
+#define EMPTY_TIMEOUT 20
+
+// larger than a pointer to exercise arbitrary element sizes
+typedef struct {
+    Uint32 producer;
+    Uint32 index;
+    Uint64 payload[2];
+} Item;
+
+typedef struct {
+    PalRingBuffer* ringBuffer;
+    Uint32 producer;
+    Int32 itemCount;
+    bool blocking;
+    bool ordered; // items must arrive in the order they were pushed
+    volatile Int32* popped;
+    volatile Int32* failed;
+} Worker;
+
+static void* PAL_CALL producer(void* arg)
+{
+    Worker* worker = arg;
+    for (Int32 i = 0; i < worker->itemCount; i++) {
+        Item item = {worker->producer, (Uint32)i, {(Uint64)i, 0}};
+        if (worker->blocking) {
+            palPushRingBuffer(worker->ringBuffer, &item, PAL_WAIT_INFINITE);
+            continue;
+        }
+
+        while (!palTryPushRingBuffer(worker->ringBuffer, &item)) {
+            palYield();
+        }
+    }
+    return nullptr;
+}
+
+static void* PAL_CALL consumer(void* arg)
+{
+    // stop once every pushed item has been popped by some consumer
+    Worker* worker = arg;
+    Uint32 next = 0;
+    Item item;
+    while (palAtomicLoad32(worker->popped, PAL_MEMORY_ORDER_RELAXED) <
+           worker->itemCount) {
+        if (worker->blocking) {
+            PalResult result;
+            result = palPopRingBuffer(worker->ringBuffer, &item, 1);
+            if (result != PAL_RESULT_SUCCESS) {
+                continue;
+            }
+
+        } else if (!palTryPopRingBuffer(worker->ringBuffer, &item)) {
+            palYield();
+            continue;
+        }
+
+        bool valid = item.payload[0] == item.index;
+        if (worker->ordered && item.index != next++) {
+            valid = false;
+        }
+
+        if (!valid) {
+            palAtomicStore32(worker->failed, 1, PAL_MEMORY_ORDER_RELAXED);
+        }
+        palAtomicFetchAdd32(worker->popped, 1, PAL_MEMORY_ORDER_RELAXED);
+    }
+    return nullptr;
+}
+
+static bool runBenchmark(
+    PalRingBufferType type,
+    Int32 producers,
+    Int32 consumers,
+    bool blocking)
+{
+    PalRingBufferCreateInfo createInfo = {0};
+    createInfo.type = type;
+    createInfo.capacity = CAPACITY;
+    createInfo.elementSize = sizeof(Item);
+    createInfo.blocking = blocking;
+
+    PalRingBuffer* ringBuffer = nullptr;
+    PalResult result = palCreateRingBuffer(&createInfo, &ringBuffer);
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to create ring buffer: %s", error);
+        return false;
+    }
+
+    volatile Int32 popped = 0;
+    volatile Int32 failed = 0;
+    Worker workers[MAX_THREADS];
+    PalThread* threads[MAX_THREADS];
+    Int32 threadCount = producers + consumers;
+
+    Uint64 start = palGetPerformanceCounter();
+    for (Int32 i = 0; i < threadCount; i++) {
+        Worker* worker = &workers[i];
+        worker->ringBuffer = ringBuffer;
+        worker->producer = (Uint32)i;
+        worker->itemCount = ITEM_COUNT;
+        worker->blocking = blocking;
+        worker->ordered = type == PAL_RING_BUFFER_SPSC;
+        worker->popped = &popped;
+        worker->failed = &failed;
+
+        // consumers wait for the items of every producer
+        PalThreadCreateInfo info = {0};
+        info.arg = worker;
+        info.entry = producer;
+        if (i >= producers) {
+            worker->itemCount = ITEM_COUNT * producers;
+            info.entry = consumer;
+        }
+
+        result = palCreateThread(&info, &threads[i]);
+        if (result != PAL_RESULT_SUCCESS) {
+            const char* error = palFormatResult(result);
+            palLog(nullptr, "Failed to create thread: %s", error);
+            return false;
+        }
+    }
+
+    for (Int32 i = 0; i < threadCount; i++) {
+        palJoinThread(threads[i], nullptr);
+        palDetachThread(threads[i]);
+    }
+
+    Uint64 ticks = palGetPerformanceCounter() - start;
+    double seconds = (double)ticks / palGetPerformanceFrequency();
+    double rate = (double)ITEM_COUNT * producers / seconds / 1000000.0;
+
+    palLog(
+        nullptr,
+        "%s %dP/%dC%s: %.2f M items/s",
+        type == PAL_RING_BUFFER_SPSC ? "SPSC" : "MPMC",
+        producers,
+        consumers,
+        blocking ? " blocking" : "",
+        rate);
+
+    palDestroyRingBuffer(ringBuffer);
+    if (failed || popped != ITEM_COUNT * producers) {
+        palLog(nullptr, "Items were lost, duplicated or reordered");
+        return false;
+    }
+    return true;
+}
+
+bool ringBufferTest()
+{
+    palLog(nullptr, "");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "Ring Buffer Test");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "");
+
+    // a blocking pop on an empty buffer must give up on time
+    PalRingBufferCreateInfo createInfo = {0};
+    createInfo.type = PAL_RING_BUFFER_MPMC;
+    createInfo.capacity = 3; // rounded up to 4
+    createInfo.elementSize = sizeof(Item);
+    createInfo.blocking = true;
+
+    PalRingBuffer* ringBuffer = nullptr;
+    PalResult result = palCreateRingBuffer(&createInfo, &ringBuffer);
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to create ring buffer: %s", error);
+        return false;
+    }
+
+    Item item = {0};
+    result = palPopRingBuffer(ringBuffer, &item, EMPTY_TIMEOUT);
+    if (result != PAL_RESULT_TIMEOUT) {
+        palLog(nullptr, "Pop on an empty buffer did not time out");
+        palDestroyRingBuffer(ringBuffer);
+        return false;
+    }
+
+    Int32 pushed = 0;
+    while (palTryPushRingBuffer(ringBuffer, &item)) {
+        pushed++;
+    }
+
+    palDestroyRingBuffer(ringBuffer);
+    if (pushed != 4) {
+        palLog(nullptr, "Expected a capacity of 4, pushed %d", pushed);
+        return false;
+    }
+
+    palLog(nullptr, "Throughput of %d items per producer:", ITEM_COUNT);
+    bool success = true;
+    success &= runBenchmark(PAL_RING_BUFFER_SPSC, 1, 1, false);
+    success &= runBenchmark(PAL_RING_BUFFER_SPSC, 1, 1, true);
+    success &= runBenchmark(PAL_RING_BUFFER_MPMC, 1, 1, false);
+    success &= runBenchmark(PAL_RING_BUFFER_MPMC, 2, 2, false);
+    success &= runBenchmark(PAL_RING_BUFFER_MPMC, 4, 4, false);
+    success &= runBenchmark(PAL_RING_BUFFER_MPMC, 4, 4, true);
+    return success;
+}
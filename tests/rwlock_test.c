@@ -0,0 +1,191 @@
+#include "pal/pal_thread.h"
+#include "tests.h"
+
+#include <string.h> // for memset
+
+#define ITERATIONS 20000
+#define WRITE_INTERVAL 100 // one write for this many reads
+#define TABLE_SIZE 16
+#define MAX_THREADS 64
+
+typedef struct {
+    PalMutex* mutex;
+    PalRWLock* lock;
+    Uint64 table[TABLE_SIZE];
+    Uint64 sums[MAX_THREADS];
+} SharedData;
+
+typedef struct {
+    SharedData* data;
+    Int32 index;
+} WorkerData;
+
+static inline Uint64 readTable(SharedData* data)
+{
+    Uint64 sum = 0;
+    for (Int32 i = 0; i < TABLE_SIZE; i++) {
+        sum += data->table[i];
+    }
+    return sum;
+}
+
+static void* PAL_CALL rwLockWorker(void* arg)
+{
+    WorkerData* worker = arg;
+    SharedData* data = worker->data;
+    Uint64 sum = 0;
+
+    for (Int32 i = 0; i < ITERATIONS; i++) {
+        if (i % WRITE_INTERVAL == 0) {
+            palLockRWLockExclusive(data->lock);
+            data->table[i % TABLE_SIZE]++;
+            palUnlockRWLockExclusive(data->lock);
+
+        } else {
+            palLockRWLockShared(data->lock);
+            sum += readTable(data);
+            palUnlockRWLockShared(data->lock);
+        }
+    }
+
+    data->sums[worker->index] = sum;
+    return nullptr;
+}
+
+static void* PAL_CALL mutexWorker(void* arg)
+{
+    WorkerData* worker = arg;
+    SharedData* data = worker->data;
+    Uint64 sum = 0;
+
+    for (Int32 i = 0; i < ITERATIONS; i++) {
+        palLockMutex(data->mutex);
+        if (i % WRITE_INTERVAL == 0) {
+            data->table[i % TABLE_SIZE]++;
+        } else {
+            sum += readTable(data);
+        }
+        palUnlockMutex(data->mutex);
+    }
+
+    data->sums[worker->index] = sum;
+    return nullptr;
+}
+
+static bool runWorkers(
+    SharedData* data,
+    PalThreadFn entry,
+    Int32 count,
+    double* outTime)
+{
+    PalThread* threads[MAX_THREADS];
+    WorkerData workers[MAX_THREADS];
+
+    PalThreadCreateInfo createInfo = {0};
+    createInfo.entry = entry;
+    createInfo.stackSize = 0;       // default
+    createInfo.allocator = nullptr; // default
+
+    Uint64 start = palGetPerformanceCounter();
+    for (Int32 i = 0; i < count; i++) {
+        workers[i].data = data;
+        workers[i].index = i;
+        createInfo.arg = &workers[i];
+
+        PalResult result = palCreateThread(&createInfo, &threads[i]);
+        if (result != PAL_RESULT_SUCCESS) {
+            const char* error = palFormatResult(result);
+            palLog(nullptr, "Failed to create thread: %s", error);
+            return false;
+        }
+    }
+
+    for (Int32 i = 0; i < count; i++) {
+        palJoinThread(threads[i], nullptr);
+        palDetachThread(threads[i]);
+    }
+
+    Uint64 end = palGetPerformanceCounter();
+    *outTime = (double)(end - start) / palGetPerformanceFrequency();
+    return true;
+}
+
+bool rwlockTest()
+{
+    palLog(nullptr, "");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "RWLock Test");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "");
+
+    PalResult result;
+    SharedData* data = palAllocate(nullptr, sizeof(SharedData), 0);
+    if (!data) {
+        palLog(nullptr, "Failed to allocate memory");
+        return false;
+    }
+    memset(data, 0, sizeof(SharedData));
+
+    result = palCreateMutex(nullptr, &data->mutex);
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to create mutex: %s", error);
+        return false;
+    }
+
+    result = palCreateRWLock(nullptr, &data->lock);
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to create rwlock: %s", error);
+        return false;
+    }
+
+    // try locks should fail while the lock is held exclusive
+    palLockRWLockExclusive(data->lock);
+    bool acquired = palTryLockRWLockShared(data->lock);
+    palUnlockRWLockExclusive(data->lock);
+    if (acquired) {
+        palLog(nullptr, "Shared try lock succeeded while held exclusive");
+        return false;
+    }
+
+    // compare read heavy throughput as readers are added
+    Uint64 expectedWrites = 0;
+    for (Int32 count = 1; count <= MAX_THREADS; count *= 2) {
+        double mutexTime = 0.0;
+        double rwLockTime = 0.0;
+        if (!runWorkers(data, mutexWorker, count, &mutexTime)) {
+            return false;
+        }
+
+        if (!runWorkers(data, rwLockWorker, count, &rwLockTime)) {
+            return false;
+        }
+
+        // both runs write ITERATIONS / WRITE_INTERVAL times per worker
+        expectedWrites += 2 * count * (ITERATIONS / WRITE_INTERVAL);
+        palLog(
+            nullptr,
+            "Threads %d: mutex %f ms, rwlock %f ms",
+            count,
+            mutexTime * 1000.0,
+            rwLockTime * 1000.0);
+    }
+
+    // lost writes mean the exclusive lock let another thread in
+    Uint64 writes = 0;
+    for (Int32 i = 0; i < TABLE_SIZE; i++) {
+        writes += data->table[i];
+    }
+
+    palLog(nullptr, "Expected Writes: %llu", expectedWrites);
+    palLog(nullptr, "Total Writes: %llu", writes);
+    if (writes != expectedWrites) {
+        return false;
+    }
+
+    palDestroyRWLock(data->lock);
+    palDestroyMutex(data->mutex);
+    palFree(nullptr, data);
+    return true;
+}
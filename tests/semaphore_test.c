@@ -0,0 +1,115 @@
+#include "pal/pal_thread.h"
+#include "tests.h"
+
+#define QUEUE_SIZE 16
+#define ITEM_COUNT 100000
+#define TIMEOUT 20
+
+typedef struct {
+    PalSemaphore* freeSlots;
+    PalSemaphore* usedSlots;
+    Int32 items[QUEUE_SIZE];
+    Int64 sum;
+} SharedData;
+
+static void* PAL_CALL producer(void* arg)
+{
+    SharedData* data = arg;
+    for (Int32 i = 0; i < ITEM_COUNT; i++) {
+        // blocks while the consumer is QUEUE_SIZE items behind
+        palWaitSemaphore(data->freeSlots);
+        data->items[i % QUEUE_SIZE] = i;
+        palPostSemaphore(data->usedSlots, 1);
+    }
+    return nullptr;
+}
+
+static void* PAL_CALL consumer(void* arg)
+{
+    SharedData* data = arg;
+    for (Int32 i = 0; i < ITEM_COUNT; i++) {
+        palWaitSemaphore(data->usedSlots);
+        data->sum += data->items[i % QUEUE_SIZE];
+        palPostSemaphore(data->freeSlots, 1);
+    }
+    return nullptr;
+}
+
+bool semaphoreTest()
+{
+    palLog(nullptr, "");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "Semaphore Test");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "");
+
+    PalResult result;
+    PalThread* threads[2];
+    SharedData data = {0};
+
+    result = palCreateSemaphore(nullptr, QUEUE_SIZE, &data.freeSlots);
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to create semaphore: %s", error);
+        return false;
+    }
+
+    result = palCreateSemaphore(nullptr, 0, &data.usedSlots);
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to create semaphore: %s", error);
+        return false;
+    }
+
+    // nothing was posted, so this must time out
+    Uint64 frequency = palGetPerformanceFrequency();
+    Uint64 start = palGetPerformanceCounter();
+    result = palWaitSemaphoreTimeout(data.usedSlots, TIMEOUT);
+    Uint64 end = palGetPerformanceCounter();
+    double waited = (double)(end - start) * 1000.0 / (double)frequency;
+    palLog(nullptr, "Empty Wait: %s", palFormatResult(result));
+    palLog(nullptr, "  Waited: %.3f ms (timeout %d ms)", waited, TIMEOUT);
+    if (result != PAL_RESULT_TIMEOUT) {
+        return false;
+    }
+
+    PalThreadCreateInfo createInfo = {0};
+    createInfo.arg = &data;
+    createInfo.stackSize = 0;       // default
+    createInfo.allocator = nullptr; // default
+
+    start = palGetPerformanceCounter();
+    for (Int32 i = 0; i < 2; i++) {
+        createInfo.entry = i == 0 ? producer : consumer;
+        result = palCreateThread(&createInfo, &threads[i]);
+        if (result != PAL_RESULT_SUCCESS) {
+            const char* error = palFormatResult(result);
+            palLog(nullptr, "Failed to create thread: %s", error);
+            return false;
+        }
+    }
+
+    for (Int32 i = 0; i < 2; i++) {
+        palJoinThread(threads[i], nullptr);
+        palDetachThread(threads[i]);
+    }
+
+    end = palGetPerformanceCounter();
+    double ms = (double)(end - start) * 1000.0 / (double)frequency;
+    Int64 expected = (Int64)ITEM_COUNT * (ITEM_COUNT - 1) / 2;
+    palLog(nullptr, "Bounded Queue: %d items in %.3f ms", ITEM_COUNT, ms);
+    palLog(nullptr, "  Expected Sum: %lld", expected);
+    palLog(nullptr, "  Sum: %lld", data.sum);
+
+    // a post with a count releases that many waits
+    palPostSemaphore(data.usedSlots, 3);
+    Int32 taken = 0;
+    while (palWaitSemaphoreTimeout(data.usedSlots, 0) == PAL_RESULT_SUCCESS) {
+        taken++;
+    }
+    palLog(nullptr, "Post Count 3: %d taken", taken);
+
+    palDestroySemaphore(data.freeSlots);
+    palDestroySemaphore(data.usedSlots);
+    return data.sum == expected && taken == 3;
+}
@@ -0,0 +1,145 @@
+#include "pal/pal_atomic.h"
+#include "pal/pal_thread.h"
+#include "tests.h"
+
+#define THREAD_COUNT 4
+#define TIMEOUT 20
+
+typedef struct {
+    PalSyncEvent* event;
+    volatile Int32 woken;
+} SharedData;
+
+static void* PAL_CALL waiter(void* arg)
+{
+    SharedData* data = arg;
+    palWaitSyncEvent(data->event);
+    palAtomicFetchAdd32(&data->woken, 1, PAL_MEMORY_ORDER_RELAXED);
+    return nullptr;
+}
+
+static bool runWaiters(
+    SharedData* data,
+    PalThread** threads)
+{
+    PalThreadCreateInfo createInfo = {0};
+    createInfo.entry = waiter;
+    createInfo.arg = data;
+    createInfo.stackSize = 0;       // default
+    createInfo.allocator = nullptr; // default
+    for (Int32 i = 0; i < THREAD_COUNT; i++) {
+        PalResult result = palCreateThread(&createInfo, &threads[i]);
+        if (result != PAL_RESULT_SUCCESS) {
+            const char* error = palFormatResult(result);
+            palLog(nullptr, "Failed to create thread: %s", error);
+            return false;
+        }
+    }
+
+    // give the waiters time to block
+    palSleep(TIMEOUT);
+    return true;
+}
+
+static Int32 waitForWoken(
+    SharedData* data,
+    Int32 count)
+{
+    // wait a little for woken threads to run, without hanging the test
+    for (Int32 i = 0; i < 100; i++) {
+        Int32 woken = palAtomicLoad32(&data->woken, PAL_MEMORY_ORDER_RELAXED);
+        if (woken >= count) {
+            break;
+        }
+        palSleep(1);
+    }
+    return palAtomicLoad32(&data->woken, PAL_MEMORY_ORDER_RELAXED);
+}
+
+static void joinWaiters(PalThread** threads)
+{
+    for (Int32 i = 0; i < THREAD_COUNT; i++) {
+        palJoinThread(threads[i], nullptr);
+        palDetachThread(threads[i]);
+    }
+}
+
+bool syncEventTest()
+{
+    palLog(nullptr, "");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "Sync Event Test");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "");
+
+    PalResult result;
+    PalThread* threads[THREAD_COUNT];
+    SharedData data = {0};
+
+    // a manual reset event releases every waiter
+    result = palCreateSyncEvent(nullptr, true, false, &data.event);
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to create event: %s", error);
+        return false;
+    }
+
+    result = palWaitSyncEventTimeout(data.event, TIMEOUT);
+    palLog(nullptr, "Unsignaled Wait: %s", palFormatResult(result));
+    if (result != PAL_RESULT_TIMEOUT) {
+        return false;
+    }
+
+    if (!runWaiters(&data, threads)) {
+        return false;
+    }
+
+    palSetSyncEvent(data.event);
+    Int32 woken = waitForWoken(&data, THREAD_COUNT);
+    palLog(nullptr, "Manual Reset: %d of %d woken", woken, THREAD_COUNT);
+    joinWaiters(threads);
+
+    // it stays signaled until reset
+    PalResult signaled = palWaitSyncEventTimeout(data.event, 0);
+    palResetSyncEvent(data.event);
+    PalResult reset = palWaitSyncEventTimeout(data.event, 0);
+    palDestroySyncEvent(data.event);
+
+    if (woken != THREAD_COUNT || signaled != PAL_RESULT_SUCCESS) {
+        return false;
+    }
+
+    if (reset != PAL_RESULT_TIMEOUT) {
+        return false;
+    }
+
+    // an auto reset event releases one waiter per set
+    data.woken = 0;
+    result = palCreateSyncEvent(nullptr, false, false, &data.event);
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to create event: %s", error);
+        return false;
+    }
+
+    if (!runWaiters(&data, threads)) {
+        return false;
+    }
+
+    bool success = true;
+    for (Int32 i = 1; i <= THREAD_COUNT; i++) {
+        palSetSyncEvent(data.event);
+        woken = waitForWoken(&data, i);
+        palLog(nullptr, "Auto Reset Set %d: %d woken", i, woken);
+
+        // let a wrongly released waiter show up before the next set
+        palSleep(5);
+        if (palAtomicLoad32(&data.woken, PAL_MEMORY_ORDER_RELAXED) != i) {
+            success = false;
+        }
+    }
+
+    joinWaiters(threads);
+    palDestroySyncEvent(data.event);
+    return success;
+}
@@ -18,6 +18,9 @@ bool timeTest();
 bool userEventTest();
 bool eventTest();
 
+// profiler tests
+bool profilerTest();
+
 // system tests
 bool systemTest();
 
@@ -26,6 +29,29 @@ bool threadTest();
 bool tlsTest();
 bool mutexTest();
 bool condvarTest();
+bool rwlockTest();
+bool atomicTest();
+bool mutexStatsTest();
+bool mutexTimeoutTest();
+bool semaphoreTest();
+bool syncEventTest();
+bool barrierTest();
+bool latchTest();
+bool waitAddressTest();
+bool mutexStorageTest();
+bool cpuTopologyTest();
+bool threadJoinTest();
+bool threadSchedulingTest();
+bool preciseSleepTest();
+bool tlsSlotTest();
+bool threadStatsTest();
+bool ringBufferTest();
+bool fiberTest();
+bool threadStackTest();
+
+// jobs tests
+bool jobsTest();
+bool threadPoolTest();
 
 // video test
 bool videoTest();
@@ -15,22 +15,54 @@ project "tests"
         "event_test.c"
     }
 
-    if (PAL_BUILD_SYSTEM) then
+    if (PAL_HAS_PROFILER) then
+        files { 
+            "profiler_test.c"
+        }
+    end
+
+    if (PAL_HAS_SYSTEM) then
         files { 
             "system_test.c"
         }
     end
 
-    if (PAL_BUILD_THREAD) then
+    if (PAL_HAS_THREAD) then
         files { 
             "thread_test.c",
             "tls_test.c",
             "mutex_test.c",
-            "condvar_test.c"
+            "condvar_test.c",
+            "rwlock_test.c",
+            "atomic_test.c",
+            "mutex_stats_test.c",
+            "mutex_timeout_test.c",
+            "semaphore_test.c",
+            "sync_event_test.c",
+            "barrier_test.c",
+            "latch_test.c",
+            "wait_address_test.c",
+            "mutex_storage_test.c",
+            "cpu_topology_test.c",
+            "thread_join_test.c",
+            "thread_scheduling_test.c",
+            "precise_sleep_test.c",
+            "tls_slot_test.c",
+            "thread_stats_test.c",
+            "ring_buffer_test.c",
+            "fiber_test.c",
+            "thread_stack_test.c"
+        }
+    end
+
+    if (PAL_HAS_JOBS) then
+        files { 
+            "jobs_test.c",
+            "thread_pool_test.c"
         }
     end
 
-    if (PAL_BUILD_VIDEO) then
+    if (PAL_HAS_VIDEO) then
         files { 
             "video_test.c",
             "monitor_test.c",
@@ -42,13 +74,13 @@ project "tests"
         }
     end
 
-    if (PAL_BUILD_OPENGL) then
+    if (PAL_HAS_OPENGL) then
         files { 
             "opengl_test.c"
         }
     end
 
-    if (PAL_BUILD_OPENGL and PAL_BUILD_VIDEO) then
+    if (PAL_HAS_OPENGL and PAL_HAS_VIDEO) then
         files { 
             "opengl_fbconfig_test.c",
             "opengl_context_test.c",
@@ -57,4 +89,13 @@ project "tests"
     end
 
     includedirs { "%{wks.location}/include" }
-    links { "PAL" }
\ No newline at end of file
+    links { "PAL" }
+
+    filter {"system:linux", "configurations:*"}
+        links { "pthread" }
+    filter {}
+
+    -- WaitOnAddress used by the thread module
+    filter {"system:windows", "configurations:*"}
+        links { "Synchronization" }
+    filter {}
\ No newline at end of file
@@ -14,6 +14,10 @@ int main(int argc, char** argv)
     registerTest("User Event Test", userEventTest);
     registerTest("Event Test", eventTest);
 
+#if PAL_HAS_PROFILER
+    registerTest("Profiler Test", profilerTest);
+#endif // PAL_HAS_PROFILER
+
 #if PAL_HAS_SYSTEM
     registerTest("System Test", systemTest);
 #endif // PAL_HAS_SYSTEM
@@ -23,8 +27,33 @@ int main(int argc, char** argv)
     registerTest("TLS Test", tlsTest);
     registerTest("Mutex Test", mutexTest);
     registerTest("Condvar Test", condvarTest);
+    registerTest("RWLock Test", rwlockTest);
+    registerTest("Atomic Test", atomicTest);
+    registerTest("Mutex Stats Test", mutexStatsTest);
+    registerTest("Mutex Timeout Test", mutexTimeoutTest);
+    registerTest("Semaphore Test", semaphoreTest);
+    registerTest("Sync Event Test", syncEventTest);
+    registerTest("Barrier Test", barrierTest);
+    registerTest("Latch Test", latchTest);
+    registerTest("Wait On Address Test", waitAddressTest);
+    registerTest("Mutex Storage Test", mutexStorageTest);
+    registerTest("CPU Topology Test", cpuTopologyTest);
+    registerTest("Thread Join Test", threadJoinTest);
+    registerTest("Thread Scheduling Test", threadSchedulingTest);
+    registerTest("Precise Sleep Test", preciseSleepTest);
+    registerTest("TLS Slot Test", tlsSlotTest);
+    registerTest("Thread Stats Test", threadStatsTest);
+    registerTest("Ring Buffer Test", ringBufferTest);
+    registerTest("Fiber Test", fiberTest);
+    registerTest("Thread Stack Test", threadStackTest);
 #endif // PAL_HAS_THREAD
 
+    // the benchmark scales up to the logical processor count
+#if PAL_HAS_JOBS
+    registerTest("Jobs Test", jobsTest);
+    registerTest("Thread Pool Test", threadPoolTest);
+#endif // PAL_HAS_JOBS
+
 #if PAL_HAS_VIDEO
     registerTest("Video Test", videoTest);
     registerTest("Monitor Test", monitorTest);
@@ -0,0 +1,110 @@
+
+#include "pal/pal_thread.h"
+#include "tests.h"
+
+#define SLEEP_TIME 300
+#define SHORT_TIMEOUT 20
+
+static Uint64 s_Value;
+
+static void* PAL_CALL slowWorker(void* arg)
+{
+    palSleep(SLEEP_TIME);
+
+    // a full pointer, a 32 bit exit code would truncate it on 64 bit
+    return (void*)((UintPtr)&s_Value | (UintPtr)arg);
+}
+
+static double toMilliseconds(Uint64 ticks)
+{
+    return (double)ticks * 1000.0 / (double)palGetPerformanceFrequency();
+}
+
+bool threadJoinTest()
+{
+    palLog(nullptr, "");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "Thread Join Test");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "");
+
+    PalThreadCreateInfo createInfo = {0};
+    createInfo.entry = slowWorker;
+    createInfo.arg = nullptr;
+
+    PalThread* thread = nullptr;
+    PalResult result = palCreateThread(&createInfo, &thread);
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to create thread: %s", error);
+        return false;
+    }
+
+    // the thread is still sleeping, the join must give up on time
+    void* retval = nullptr;
+    Uint64 start = palGetPerformanceCounter();
+    result = palJoinThreadTimeout(thread, SHORT_TIMEOUT, &retval);
+    double waited = toMilliseconds(palGetPerformanceCounter() - start);
+
+    if (result != PAL_RESULT_TIMEOUT) {
+        palLog(nullptr, "Join did not time out: %s", palFormatResult(result));
+        palJoinThread(thread, nullptr);
+        palDetachThread(thread);
+        return false;
+    }
+
+    palLog(
+        nullptr,
+        "Timed out after %.2f ms (timeout %d ms)",
+        waited,
+        SHORT_TIMEOUT);
+
+    if (waited + 1.0 < SHORT_TIMEOUT) {
+        palLog(nullptr, "Join returned before the timeout");
+        palJoinThread(thread, nullptr);
+        palDetachThread(thread);
+        return false;
+    }
+
+    // the thread can still be joined after a timeout
+    result = palJoinThreadTimeout(thread, SLEEP_TIME * 10, &retval);
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to join thread: %s", error);
+        palDetachThread(thread);
+        return false;
+    }
+    palDetachThread(thread);
+
+    if (retval != (void*)&s_Value) {
+        palLog(nullptr, "Return value was truncated: %p", retval);
+        return false;
+    }
+    palLog(nullptr, "Return value: %p", retval);
+
+    // joining a finished thread does not wait
+    createInfo.arg = (void*)(UintPtr)1;
+    result = palCreateThread(&createInfo, &thread);
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to create thread: %s", error);
+        return false;
+    }
+
+    palSleep(SLEEP_TIME * 2);
+    result = palJoinThreadTimeout(thread, 0, &retval);
+    palDetachThread(thread);
+
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to join finished thread: %s", error);
+        return false;
+    }
+
+    if (retval != (void*)((UintPtr)&s_Value | 1)) {
+        palLog(nullptr, "Return value was truncated: %p", retval);
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,229 @@
+
+#include "pal/pal_atomic.h"
+#include "pal/pal_jobs.h"
+#include "tests.h"
+
+#include <string.h> // for memset
+
+#define SMALL_TASK_COUNT 100000
+#define THREAD_TASK_COUNT 1000 // creating threads is slow, sample fewer
+#define ITEM_COUNT (1 << 20)
+#define WORK_COUNT 64
+#define NESTED_COUNT 16
+
+static volatile Int32 s_Counter;
+static Uint64 s_Items[ITEM_COUNT];
+
+static void PAL_CALL smallTask(void* userData)
+{
+    palAtomicFetchAdd32(&s_Counter, 1, PAL_MEMORY_ORDER_RELAXED);
+}
+
+static void* smallThread(void* arg)
+{
+    smallTask(arg);
+    return nullptr;
+}
+
+static inline Uint64 work(Uint64 index)
+{
+    Uint64 seed = index + 1;
+    for (Int32 i = 0; i < WORK_COUNT; i++) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+    }
+    return seed;
+}
+
+static void PAL_CALL workChunk(
+    Uint64 begin,
+    Uint64 end,
+    void* userData)
+{
+    for (Uint64 i = begin; i < end; i++) {
+        s_Items[i] = work(i);
+    }
+}
+
+static void PAL_CALL countChunk(
+    Uint64 begin,
+    Uint64 end,
+    void* userData)
+{
+    Int32 count = (Int32)(end - begin);
+    palAtomicFetchAdd32(&s_Counter, count, PAL_MEMORY_ORDER_RELAXED);
+}
+
+static void PAL_CALL nestedTask(void* userData)
+{
+    // every worker can be inside this, the caller must not wait idle
+    PalThreadPool* pool = userData;
+    palParallelFor(pool, 100, 1, countChunk, nullptr);
+}
+
+static Uint64 sumItems()
+{
+    Uint64 sum = 0;
+    for (Int32 i = 0; i < ITEM_COUNT; i++) {
+        sum += s_Items[i];
+    }
+    return sum;
+}
+
+static double getSeconds(
+    Uint64 start,
+    Uint64 end)
+{
+    return (double)(end - start) / palGetPerformanceFrequency();
+}
+
+bool threadPoolTest()
+{
+    palLog(nullptr, "");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "Thread Pool Test");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "");
+
+    Int32 processors = 0;
+    PalResult result;
+    result = palEnumerateLogicalProcessors(nullptr, &processors, nullptr);
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to enumerate processors: %s", error);
+        return false;
+    }
+
+    // the calling thread takes part in parallel-for
+    Uint32 workers = (Uint32)processors - 1;
+    if (workers == 0) {
+        workers = 1;
+    }
+
+    PalThreadPoolCreateInfo createInfo = {0};
+    createInfo.allocator = nullptr; // default
+    createInfo.workerCount = workers;
+    createInfo.queueCapacity = 0; // default
+    createInfo.stackSize = 0;     // default
+
+    PalThreadPool* pool = nullptr;
+    result = palCreateThreadPool(&createInfo, &pool);
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to create thread pool: %s", error);
+        return false;
+    }
+
+    // small tasks, the cost is all scheduling
+    s_Counter = 0;
+    Uint64 start = palGetPerformanceCounter();
+    for (Int32 i = 0; i < SMALL_TASK_COUNT; i++) {
+        palSubmitTask(pool, smallTask, nullptr);
+    }
+    palWaitThreadPool(pool);
+    Uint64 end = palGetPerformanceCounter();
+
+    if (s_Counter != SMALL_TASK_COUNT) {
+        palLog(nullptr, "Lost tasks: %d of %d", s_Counter, SMALL_TASK_COUNT);
+        palDestroyThreadPool(pool);
+        return false;
+    }
+    double poolTime = getSeconds(start, end) / SMALL_TASK_COUNT;
+
+    // the same task on a thread of its own
+    PalThreadCreateInfo threadInfo = {0};
+    threadInfo.entry = smallThread;
+    start = palGetPerformanceCounter();
+    for (Int32 i = 0; i < THREAD_TASK_COUNT; i++) {
+        PalThread* thread = nullptr;
+        result = palCreateThread(&threadInfo, &thread);
+        if (result != PAL_RESULT_SUCCESS) {
+            const char* error = palFormatResult(result);
+            palLog(nullptr, "Failed to create thread: %s", error);
+            palDestroyThreadPool(pool);
+            return false;
+        }
+
+        palJoinThread(thread, nullptr);
+        palDetachThread(thread);
+    }
+    end = palGetPerformanceCounter();
+    double threadTime = getSeconds(start, end) / THREAD_TASK_COUNT;
+
+    palLog(nullptr, "Small task overhead (%u workers):", workers);
+    palLog(nullptr, "  Thread pool: %.0f ns per task", poolTime * 1e9);
+    palLog(
+        nullptr,
+        "  Thread per task: %.0f ns per task (%.1fx)",
+        threadTime * 1e9,
+        threadTime / poolTime);
+
+    // large data-parallel loop against a plain loop
+    start = palGetPerformanceCounter();
+    workChunk(0, ITEM_COUNT, nullptr);
+    end = palGetPerformanceCounter();
+    double serialTime = getSeconds(start, end);
+    Uint64 expected = sumItems();
+
+    palLog(nullptr, "");
+    palLog(nullptr, "Parallel for over %d items:", ITEM_COUNT);
+    palLog(nullptr, "  Serial: %f ms", serialTime * 1000.0);
+
+    Uint64 grains[] = {0, 64, 4096};
+    for (Int32 i = 0; i < 3; i++) {
+        memset(s_Items, 0, sizeof(s_Items));
+        start = palGetPerformanceCounter();
+        palParallelFor(pool, ITEM_COUNT, grains[i], workChunk, nullptr);
+        end = palGetPerformanceCounter();
+        double time = getSeconds(start, end);
+
+        if (sumItems() != expected) {
+            palLog(nullptr, "Parallel for results do not match");
+            palDestroyThreadPool(pool);
+            return false;
+        }
+
+        palLog(
+            nullptr,
+            "  Grain %llu%s: %f ms (%.2fx)",
+            grains[i],
+            grains[i] == 0 ? " (auto)" : "",
+            time * 1000.0,
+            serialTime / time);
+    }
+
+    // parallel-for from every worker at once
+    s_Counter = 0;
+    for (Int32 i = 0; i < NESTED_COUNT; i++) {
+        palSubmitTask(pool, nestedTask, pool);
+    }
+    palWaitThreadPool(pool);
+    palDestroyThreadPool(pool);
+
+    if (s_Counter != NESTED_COUNT * 100) {
+        palLog(nullptr, "Nested parallel for lost chunks");
+        return false;
+    }
+
+    // a full queue runs tasks on the submitting thread
+    createInfo.workerCount = 1;
+    createInfo.queueCapacity = 2;
+    result = palCreateThreadPool(&createInfo, &pool);
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to create thread pool: %s", error);
+        return false;
+    }
+
+    s_Counter = 0;
+    for (Int32 i = 0; i < 1000; i++) {
+        palSubmitTask(pool, smallTask, nullptr);
+    }
+    palDestroyThreadPool(pool); // waits for queued tasks
+
+    if (s_Counter != 1000) {
+        palLog(nullptr, "Lost tasks with a full queue: %d of 1000", s_Counter);
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,128 @@
+
+#include "pal/pal_atomic.h"
+#include "pal/pal_thread.h"
+#include "tests.h"
+
+static volatile Int32 s_Running;
+
+static const char* s_PolicyNames[] = {
+    "Idle",
+    "Normal",
+    "Realtime FIFO",
+    "Realtime RR"};
+
+static void* PAL_CALL worker(void* arg)
+{
+    while (palAtomicLoad32(&s_Running, PAL_MEMORY_ORDER_ACQUIRE)) {
+        palSleep(1);
+    }
+    return nullptr;
+}
+
+static bool trySchedule(
+    PalThread* thread,
+    PalSchedulingPolicy policy,
+    Int32 level)
+{
+    PalThreadScheduling scheduling = {0};
+    scheduling.policy = policy;
+    scheduling.level = level;
+    scheduling.mmcssTask = nullptr;
+
+    // raising priority needs privileges the test might not have
+    PalResult result = palSetThreadScheduling(thread, &scheduling);
+    if (result == PAL_RESULT_ACCESS_DENIED) {
+        palLog(
+            nullptr,
+            "%s %d: access denied, no privilege",
+            s_PolicyNames[policy],
+            level);
+        return true;
+    }
+
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to set thread scheduling: %s", error);
+        return false;
+    }
+
+    PalThreadScheduling current = {0};
+    result = palGetThreadScheduling(thread, &current);
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to get thread scheduling: %s", error);
+        return false;
+    }
+
+    palLog(
+        nullptr,
+        "%s %d: set, reads back %s %d",
+        s_PolicyNames[policy],
+        level,
+        s_PolicyNames[current.policy],
+        current.level);
+
+    if (current.policy != policy) {
+        palLog(nullptr, "Thread scheduling policy does not match");
+        return false;
+    }
+
+    if (policy != PAL_SCHEDULING_POLICY_IDLE && current.level != level) {
+        palLog(nullptr, "Thread scheduling level does not match");
+        return false;
+    }
+    return true;
+}
+
+bool threadSchedulingTest()
+{
+    palLog(nullptr, "");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "Thread Scheduling Test");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "");
+
+    if (!(palGetThreadFeatures() & PAL_THREAD_FEATURE_PRIORITY)) {
+        palLog(nullptr, "Thread priority feature not supported");
+        return true;
+    }
+
+    PalThreadCreateInfo createInfo = {0};
+    createInfo.entry = worker;
+    s_Running = 1;
+
+    PalThread* thread = nullptr;
+    PalResult result = palCreateThread(&createInfo, &thread);
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to create thread: %s", error);
+        return false;
+    }
+
+    // background work, then up to realtime and back to the default
+    bool success = true;
+    success = success && trySchedule(thread, PAL_SCHEDULING_POLICY_IDLE, 0);
+    success = success && trySchedule(thread, PAL_SCHEDULING_POLICY_NORMAL, -2);
+    success = success && trySchedule(thread, PAL_SCHEDULING_POLICY_NORMAL, 2);
+    success = success &&
+              trySchedule(thread, PAL_SCHEDULING_POLICY_REALTIME_FIFO, 10);
+    success = success &&
+              trySchedule(thread, PAL_SCHEDULING_POLICY_REALTIME_RR, 20);
+    success = success && trySchedule(thread, PAL_SCHEDULING_POLICY_NORMAL, 0);
+
+    if (success) {
+        PalThreadScheduling scheduling = {0};
+        scheduling.policy = PAL_SCHEDULING_POLICY_NORMAL;
+        scheduling.level = 5;
+        result = palSetThreadScheduling(thread, &scheduling);
+        if (result != PAL_RESULT_INVALID_ARGUMENT) {
+            palLog(nullptr, "Out of range level was not rejected");
+            success = false;
+        }
+    }
+
+    palAtomicStore32(&s_Running, 0, PAL_MEMORY_ORDER_RELEASE);
+    palJoinThread(thread, nullptr);
+    palDetachThread(thread);
+    return success;
+}
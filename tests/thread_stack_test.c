@@ -0,0 +1,226 @@
+
+#ifndef _WIN32
+// pthread_getattr_np
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif // _GNU_SOURCE
+#endif // _WIN32
+
+#include "pal/pal_thread.h"
+#include "tests.h"
+
+#include <string.h> // for memset
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif // WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif // _WIN32
+
+#define STACK_SIZE (256 * 1024)
+#define STACK_COMMIT (128 * 1024)
+#define GUARD_SIZE (64 * 1024)
+#define BUFFER_SIZE (64 * 1024)
+#define POOL_SIZE 4
+#define THREAD_COUNT 200
+#define COMMIT_SLACK (16 * 1024) // frames above the worker on Windows
+
+static UintPtr s_StackAddress; // written by one thread at a time
+static bool s_Committed;
+static Uint64 s_GuardSize;
+
+static void* PAL_CALL commitWorker(void* arg)
+{
+    // check the stack from inside without touching it
+#ifdef _WIN32
+    // the committed pages are contiguous, the lowest one is enough
+    volatile Uint8 marker = 0;
+    UintPtr lowest = (UintPtr)&marker - (STACK_COMMIT - COMMIT_SLACK);
+    MEMORY_BASIC_INFORMATION info;
+    s_Committed = VirtualQuery((LPCVOID)lowest, &info, sizeof(info)) &&
+                  info.State == MEM_COMMIT;
+
+    // a zero size queries the current guarantee
+    ULONG guarantee = 0;
+    SetThreadStackGuarantee(&guarantee);
+    s_GuardSize = guarantee;
+
+#else
+    pthread_attr_t attr;
+    if (pthread_getattr_np(pthread_self(), &attr) != 0) {
+        return nullptr;
+    }
+
+    void* base = nullptr;
+    size_t size = 0;
+    size_t guardSize = 0;
+    pthread_attr_getstack(&attr, &base, &size);
+    pthread_attr_getguardsize(&attr, &guardSize);
+    pthread_attr_destroy(&attr);
+    s_GuardSize = guardSize;
+
+    // every page in the top STACK_COMMIT bytes must be resident
+    UintPtr page = (UintPtr)sysconf(_SC_PAGESIZE);
+    UintPtr top = ((UintPtr)base + size) & ~(page - 1);
+    UintPtr bottom = top - STACK_COMMIT;
+    unsigned char pages[STACK_COMMIT / 4096];
+    s_Committed = mincore((void*)bottom, top - bottom, pages) == 0;
+    for (UintPtr i = 0; s_Committed && i < (top - bottom) / page; i++) {
+        s_Committed = pages[i] & 1;
+    }
+#endif // _WIN32
+
+    return nullptr;
+}
+
+static void* PAL_CALL stackWorker(void* arg)
+{
+    // use a good part of the stack and report where it lives
+    volatile Uint8 buffer[BUFFER_SIZE];
+    memset((void*)buffer, 1, sizeof(buffer));
+    s_StackAddress = (UintPtr)buffer;
+    return nullptr;
+}
+
+static double createThreads(
+    void** stacks,
+    bool* onStack)
+{
+    // microseconds to create and join one thread
+    PalThreadCreateInfo createInfo = {0};
+    createInfo.entry = stackWorker;
+    createInfo.stackSize = STACK_SIZE;
+
+    *onStack = true;
+    Uint64 start = palGetPerformanceCounter();
+    for (Int32 i = 0; i < THREAD_COUNT; i++) {
+        if (stacks) {
+            createInfo.stack = stacks[i % POOL_SIZE];
+        }
+
+        PalThread* thread = nullptr;
+        PalResult result = palCreateThread(&createInfo, &thread);
+        if (result != PAL_RESULT_SUCCESS) {
+            const char* error = palFormatResult(result);
+            palLog(nullptr, "Failed to create thread: %s", error);
+            return -1.0;
+        }
+
+        // joining publishes the address
+        palJoinThread(thread, nullptr);
+        palDetachThread(thread);
+
+        UintPtr stack = (UintPtr)createInfo.stack;
+        UintPtr address = s_StackAddress;
+        if (stack && (address < stack || address >= stack + STACK_SIZE)) {
+            *onStack = false;
+        }
+    }
+
+    Uint64 ticks = palGetPerformanceCounter() - start;
+    double us = (double)ticks * 1000000.0 / palGetPerformanceFrequency();
+    return us / THREAD_COUNT;
+}
+
+bool threadStackTest()
+{
+    palLog(nullptr, "");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "Thread Stack Test");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "");
+
+    // reserve, commit and guard sizes
+    PalThreadCreateInfo createInfo = {0};
+    createInfo.entry = commitWorker;
+    createInfo.stackSize = STACK_SIZE;
+    createInfo.stackCommit = STACK_COMMIT;
+    createInfo.guardSize = GUARD_SIZE;
+
+    PalThread* thread = nullptr;
+    PalResult result = palCreateThread(&createInfo, &thread);
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to create thread: %s", error);
+        return false;
+    }
+
+    // joining publishes the results
+    palJoinThread(thread, nullptr);
+    palDetachThread(thread);
+    palLog(
+        nullptr,
+        "Thread with %d KiB reserved, %d KiB committed and %d KiB guard",
+        STACK_SIZE / 1024,
+        STACK_COMMIT / 1024,
+        GUARD_SIZE / 1024);
+
+    if (!s_Committed) {
+        palLog(nullptr, "Committed stack pages are not resident");
+        return false;
+    }
+
+    if (s_GuardSize < GUARD_SIZE) {
+        palLog(nullptr, "Guard size is %llu bytes", s_GuardSize);
+        return false;
+    }
+
+    createInfo.entry = stackWorker;
+
+    PalThreadFeatures features = palGetThreadFeatures();
+    if (!(features & PAL_THREAD_FEATURE_CUSTOM_STACK)) {
+        palLog(nullptr, "Custom stacks not supported");
+        return true;
+    }
+
+    // a small pool of stacks reused by short lived threads
+    void* stacks[POOL_SIZE];
+    for (Int32 i = 0; i < POOL_SIZE; i++) {
+        stacks[i] = palAllocate(nullptr, STACK_SIZE, 16);
+        if (!stacks[i]) {
+            palLog(nullptr, "Failed to allocate memory");
+            return false;
+        }
+    }
+
+    bool success = true;
+    bool onStack = true;
+    double mapped = createThreads(nullptr, &onStack);
+    double pooled = createThreads(stacks, &onStack);
+    if (mapped < 0.0 || pooled < 0.0) {
+        success = false;
+
+    } else if (!onStack) {
+        palLog(nullptr, "Thread did not run on the provided stack");
+        success = false;
+
+    } else {
+        palLog(nullptr, "Create and join, %d threads:", THREAD_COUNT);
+        palLog(nullptr, "  PAL mapped stacks: %.1f us", mapped);
+        palLog(nullptr, "  pooled stacks: %.1f us", pooled);
+    }
+
+    // stacks must be aligned
+    createInfo.stack = (Uint8*)stacks[0] + 8;
+    createInfo.stackCommit = 0;
+    createInfo.guardSize = 0;
+    result = palCreateThread(&createInfo, &thread);
+    if (result != PAL_RESULT_INVALID_ARGUMENT) {
+        palLog(nullptr, "Unaligned stack was accepted");
+        if (result == PAL_RESULT_SUCCESS) {
+            palJoinThread(thread, nullptr);
+            palDetachThread(thread);
+        }
+        success = false;
+    }
+
+    for (Int32 i = 0; i < POOL_SIZE; i++) {
+        palFree(nullptr, stacks[i]);
+    }
+    return success;
+}
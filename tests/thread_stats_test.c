@@ -0,0 +1,132 @@
+
+#include "pal/pal_atomic.h"
+#include "pal/pal_thread.h"
+#include "tests.h"
+
+#define SPIN_TIME 200
+#define SLEEP_COUNT 20
+
+static volatile Int32 s_Done = 0;
+static volatile Int32 s_Release = 0;
+
+static void* PAL_CALL spinWorker(void* arg)
+{
+    // burn CPU time
+    Uint64 frequency = palGetPerformanceFrequency();
+    Uint64 end = palGetPerformanceCounter() + frequency * SPIN_TIME / 1000;
+    while (palGetPerformanceCounter() < end) {
+        palCpuPause();
+    }
+
+    palAtomicFetchAdd32(&s_Done, 1, PAL_MEMORY_ORDER_RELEASE);
+    while (!palAtomicLoad32(&s_Release, PAL_MEMORY_ORDER_ACQUIRE)) {
+        palSleep(1);
+    }
+    return nullptr;
+}
+
+static void* PAL_CALL sleepWorker(void* arg)
+{
+    // every sleep gives up the processor
+    for (Int32 i = 0; i < SLEEP_COUNT; i++) {
+        palSleep(1);
+    }
+
+    palAtomicFetchAdd32(&s_Done, 1, PAL_MEMORY_ORDER_RELEASE);
+    while (!palAtomicLoad32(&s_Release, PAL_MEMORY_ORDER_ACQUIRE)) {
+        palSleep(1);
+    }
+    return nullptr;
+}
+
+static void logStats(
+    const char* name,
+    const PalThreadStats* stats)
+{
+    palLog(
+        nullptr,
+        "%s: user %.2f ms, kernel %.2f ms, cpu %d",
+        name,
+        (double)stats->userTime / 1000000.0,
+        (double)stats->kernelTime / 1000000.0,
+        stats->cpu);
+
+    palLog(
+        nullptr,
+        "  switches %llu (voluntary %llu, involuntary %llu)",
+        stats->contextSwitches,
+        stats->voluntarySwitches,
+        stats->involuntarySwitches);
+}
+
+bool threadStatsTest()
+{
+    palLog(nullptr, "");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "Thread Stats Test");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "");
+
+    PalThread* threads[2] = {nullptr, nullptr};
+    PalThreadFn entries[2] = {spinWorker, sleepWorker};
+    for (Int32 i = 0; i < 2; i++) {
+        PalThreadCreateInfo createInfo = {0};
+        createInfo.entry = entries[i];
+
+        PalResult result = palCreateThread(&createInfo, &threads[i]);
+        if (result != PAL_RESULT_SUCCESS) {
+            const char* error = palFormatResult(result);
+            palLog(nullptr, "Failed to create thread: %s", error);
+            return false;
+        }
+    }
+
+    // the threads must still be alive when they are queried
+    while (palAtomicLoad32(&s_Done, PAL_MEMORY_ORDER_ACQUIRE) < 2) {
+        palSleep(1);
+    }
+
+    bool success = true;
+    PalThreadStats spin, sleep, self;
+    PalResult result = palGetThreadStats(threads[0], &spin);
+    if (result == PAL_RESULT_SUCCESS) {
+        result = palGetThreadStats(threads[1], &sleep);
+    }
+
+    if (result == PAL_RESULT_SUCCESS) {
+        result = palGetThreadStats(palGetCurrentThread(), &self);
+    }
+
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to get thread stats: %s", error);
+        success = false;
+
+    } else {
+        logStats("Spinning thread", &spin);
+        logStats("Sleeping thread", &sleep);
+        logStats("Calling thread", &self);
+
+        if (spin.userTime + spin.kernelTime == 0) {
+            palLog(nullptr, "Spinning thread used no CPU time");
+            success = false;
+        }
+
+        if (sleep.contextSwitches == 0) {
+            palLog(nullptr, "Sleeping thread was never switched out");
+            success = false;
+        }
+
+        if (self.cpu < 0) {
+            palLog(nullptr, "Calling thread has no processor");
+            success = false;
+        }
+    }
+
+    palAtomicStore32(&s_Release, 1, PAL_MEMORY_ORDER_RELEASE);
+    for (Int32 i = 0; i < 2; i++) {
+        palJoinThread(threads[i], nullptr);
+        palDetachThread(threads[i]);
+    }
+    return success;
+}
@@ -1,6 +1,8 @@
 
 #include "tests.h"
 
+#define TICK_ITERATIONS 1000000
+
 // a simple timer object to hold frequency and start time
 typedef struct {
     Uint64 frequency;
@@ -50,5 +52,38 @@ bool timeTest()
         totalTime,
         frameCount);
 
+    // calibrate the tick source. This uses the TSC if it is invariant
+    PalTickSource source = palCalibrateTicks(100);
+    if (source == PAL_TICK_SOURCE_TSC) {
+        palLog(nullptr, "Tick source: TSC");
+    } else {
+        palLog(nullptr, "Tick source: OS");
+    }
+    palLog(nullptr, "Tick frequency: %llu", palGetTicksFrequency());
+
+    // compare the cost of reading both clocks
+    volatile Uint64 sink = 0;
+    Uint64 start = palGetTicks();
+    for (Int32 i = 0; i < TICK_ITERATIONS; i++) {
+        sink += palGetPerformanceCounter();
+    }
+    Uint64 counterTime = palTicksToNanoseconds(palGetTicks() - start);
+
+    start = palGetTicks();
+    for (Int32 i = 0; i < TICK_ITERATIONS; i++) {
+        sink += palGetTicks();
+    }
+    Uint64 ticksTime = palTicksToNanoseconds(palGetTicks() - start);
+
+    palLog(
+        nullptr,
+        "palGetPerformanceCounter: %.2f ns per call",
+        (double)counterTime / TICK_ITERATIONS);
+
+    palLog(
+        nullptr,
+        "palGetTicks: %.2f ns per call",
+        (double)ticksTime / TICK_ITERATIONS);
+
     return true;
 }
\ No newline at end of file
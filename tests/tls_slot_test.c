@@ -0,0 +1,164 @@
+
+#include "pal/pal_atomic.h"
+#include "pal/pal_thread.h"
+#include "tests.h"
+
+#define SLOT_COUNT 3
+#define BENCH_ITERATIONS 10000000
+
+typedef struct {
+    PalTLSSlot slots[SLOT_COUNT];
+} ThreadData;
+
+static Int32 s_Ids[SLOT_COUNT] = {0, 1, 2};
+static Int32 s_Order[SLOT_COUNT];
+static volatile Int32 s_Destroyed = 0;
+
+static void PAL_CALL slotDestructor(void* userData)
+{
+    // record which slot was destroyed and when
+    Int32 index = palAtomicFetchAdd32(
+        &s_Destroyed,
+        1,
+        PAL_MEMORY_ORDER_RELAXED);
+
+    if (index < SLOT_COUNT) {
+        s_Order[index] = *(Int32*)userData;
+    }
+}
+
+static void* PAL_CALL worker(void* arg)
+{
+    ThreadData* data = arg;
+    for (Int32 i = 0; i < SLOT_COUNT; i++) {
+        palSetTLSSlot(data->slots[i], &s_Ids[i]);
+    }
+
+    // every thread has its own block
+    for (Int32 i = 0; i < SLOT_COUNT; i++) {
+        if (palGetTLSSlot(data->slots[i]) != &s_Ids[i]) {
+            return nullptr;
+        }
+    }
+    return data;
+}
+
+static double benchmark(
+    PalTLSId id,
+    PalTLSSlot slot)
+{
+    // nanoseconds per get and set pair
+    UintPtr sum = 0;
+    Uint64 start = palGetPerformanceCounter();
+    for (Int32 i = 0; i < BENCH_ITERATIONS; i++) {
+        if (id) {
+            sum += (UintPtr)palGetTLS(id);
+            palSetTLS(id, (void*)(UintPtr)i);
+
+        } else {
+            sum += (UintPtr)palGetTLSSlot(slot);
+            palSetTLSSlot(slot, (void*)(UintPtr)i);
+        }
+    }
+
+    Uint64 ticks = palGetPerformanceCounter() - start;
+    double ns = (double)ticks * 1000000000.0 / palGetPerformanceFrequency();
+
+    // keep the loop from being thrown away
+    if (sum == 1) {
+        palLog(nullptr, "");
+    }
+    return ns / BENCH_ITERATIONS;
+}
+
+bool tlsSlotTest()
+{
+    palLog(nullptr, "");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "TLS Slot Test");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "");
+
+    ThreadData data;
+    for (Int32 i = 0; i < SLOT_COUNT; i++) {
+        data.slots[i] = palCreateTLSSlot(slotDestructor);
+        if (data.slots[i] == 0) {
+            palLog(nullptr, "Failed to create TLS slot");
+            return false;
+        }
+    }
+
+    // the worker sets every slot, its destructors run when it exits
+    PalThreadCreateInfo createInfo = {0};
+    createInfo.entry = worker;
+    createInfo.arg = &data;
+
+    PalThread* thread = nullptr;
+    PalResult result = palCreateThread(&createInfo, &thread);
+    if (result != PAL_RESULT_SUCCESS) {
+        const char* error = palFormatResult(result);
+        palLog(nullptr, "Failed to create thread: %s", error);
+        return false;
+    }
+
+    void* retval = nullptr;
+    palJoinThread(thread, &retval);
+    palDetachThread(thread);
+    if (retval != &data) {
+        palLog(nullptr, "Worker read back wrong slot values");
+        return false;
+    }
+
+    // the main thread never set the slots
+    if (palGetTLSSlot(data.slots[0]) != nullptr) {
+        palLog(nullptr, "Slot value leaked into another thread");
+        return false;
+    }
+
+    // newest slot first
+    if (s_Destroyed != SLOT_COUNT) {
+        palLog(
+            nullptr,
+            "Expected %d destructors, got %d",
+            SLOT_COUNT,
+            s_Destroyed);
+
+        return false;
+    }
+
+    for (Int32 i = 0; i < SLOT_COUNT; i++) {
+        if (s_Order[i] != SLOT_COUNT - 1 - i) {
+            palLog(nullptr, "Destructors did not run in reverse order");
+            return false;
+        }
+    }
+    palLog(nullptr, "Destructors ran in reverse creation order");
+
+    // a reused slot must not return the value of the destroyed one
+    palSetTLSSlot(data.slots[0], &s_Ids[0]);
+    palDestroyTLSSlot(data.slots[0]);
+    PalTLSSlot reused = palCreateTLSSlot(nullptr);
+    if (palGetTLSSlot(reused) != nullptr) {
+        palLog(nullptr, "Reused slot returned a stale value");
+        return false;
+    }
+
+    PalTLSId id = palCreateTLS(nullptr);
+    if (id == 0) {
+        palLog(nullptr, "Failed to create TLS");
+        return false;
+    }
+
+    double tlsTime = benchmark(id, 0);
+    double slotTime = benchmark(0, reused);
+    palLog(nullptr, "palGetTLS/palSetTLS: %.2f ns", tlsTime);
+    palLog(nullptr, "palGetTLSSlot/palSetTLSSlot: %.2f ns", slotTime);
+
+    palSetTLSSlot(reused, nullptr);
+    palDestroyTLS(id);
+    palDestroyTLSSlot(reused);
+    for (Int32 i = 1; i < SLOT_COUNT; i++) {
+        palDestroyTLSSlot(data.slots[i]);
+    }
+    return true;
+}
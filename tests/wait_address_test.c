@@ -0,0 +1,89 @@
+#include "pal/pal_atomic.h"
+#include "pal/pal_thread.h"
+#include "tests.h"
+
+#define THREAD_COUNT 4
+#define TIMEOUT 20
+
+typedef struct {
+    volatile Int32 flag;
+    volatile Int32 woken;
+} SharedData;
+
+static void* PAL_CALL waiter(void* arg)
+{
+    SharedData* data = arg;
+
+    // recheck in a loop, wakes can be spurious
+    Int32 zero = 0;
+    while (palAtomicLoad32(&data->flag, PAL_MEMORY_ORDER_ACQUIRE) == 0) {
+        palWaitOnAddress(&data->flag, &zero, sizeof(Int32), PAL_WAIT_INFINITE);
+    }
+
+    palAtomicFetchAdd32(&data->woken, 1, PAL_MEMORY_ORDER_RELAXED);
+    return nullptr;
+}
+
+bool waitAddressTest()
+{
+    palLog(nullptr, "");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "Wait On Address Test");
+    palLog(nullptr, "===========================================");
+    palLog(nullptr, "");
+
+    PalResult result;
+    PalThread* threads[THREAD_COUNT];
+    SharedData data = {0};
+    Int32 zero = 0;
+
+    // nothing wakes this, so it must time out
+    result = palWaitOnAddress(&data.flag, &zero, sizeof(Int32), TIMEOUT);
+    palLog(nullptr, "Unchanged Wait: %s", palFormatResult(result));
+    if (result != PAL_RESULT_TIMEOUT) {
+        return false;
+    }
+
+    // a different value returns without sleeping
+    Int32 one = 1;
+    result = palWaitOnAddress(&data.flag, &one, sizeof(Int32), TIMEOUT);
+    palLog(nullptr, "Changed Wait: %s", palFormatResult(result));
+    if (result != PAL_RESULT_SUCCESS) {
+        return false;
+    }
+
+    // only 32 bit words are supported
+    Int64 wide = 0;
+    result = palWaitOnAddress(&wide, &wide, sizeof(Int64), TIMEOUT);
+    palLog(nullptr, "64 Bit Wait: %s", palFormatResult(result));
+    if (result != PAL_RESULT_INVALID_ARGUMENT) {
+        return false;
+    }
+
+    PalThreadCreateInfo createInfo = {0};
+    createInfo.entry = waiter;
+    createInfo.arg = &data;
+    createInfo.stackSize = 0;       // default
+    createInfo.allocator = nullptr; // default
+    for (Int32 i = 0; i < THREAD_COUNT; i++) {
+        result = palCreateThread(&createInfo, &threads[i]);
+        if (result != PAL_RESULT_SUCCESS) {
+            const char* error = palFormatResult(result);
+            palLog(nullptr, "Failed to create thread: %s", error);
+            return false;
+        }
+    }
+
+    // change the value before waking so woken threads do not sleep again
+    palSleep(TIMEOUT);
+    palAtomicStore32(&data.flag, 1, PAL_MEMORY_ORDER_RELEASE);
+    palWakeByAddressAll(&data.flag);
+
+    for (Int32 i = 0; i < THREAD_COUNT; i++) {
+        palJoinThread(threads[i], nullptr);
+        palDetachThread(threads[i]);
+    }
+
+    palLog(nullptr, "Woken: %d of %d", data.woken, THREAD_COUNT);
+    return data.woken == THREAD_COUNT;
+}